@@ -24,9 +24,118 @@
 
 #include "HandleStatementBridge.h"
 #include "AbstractHandle.hpp"
+#include "Assertion.hpp"
 #include "HandleStatement.hpp"
 #include "ObjectBridge.hpp"
 #include "UnsafeData.hpp"
+#include <cstring>
+
+namespace WCDB {
+
+static WCDBColumnValueType getBridgedColumnType(ColumnType type)
+{
+    switch (type) {
+    case ColumnType::Integer:
+        return WCDBColumnValueTypeInterger;
+    case ColumnType::Float:
+        return WCDBColumnValueTypeFloat;
+    case ColumnType::BLOB:
+        return WCDBColumnValueTypeBLOB;
+    case ColumnType::Text:
+        return WCDBColumnValueTypeString;
+    case ColumnType::Null:
+        return WCDBColumnValueTypeNull;
+    }
+}
+
+static bool fetchRowToColumnarBuffer(HandleStatement* handleStatement,
+                                     CPPColumnarBuffer* buffer)
+{
+    // Measure before writing so that a row is never partially fetched.
+    unsigned long long required = 0;
+    for (int column = 0; column < buffer->columnCount; ++column) {
+        ColumnType type = handleStatement->getType(column);
+        if (type == ColumnType::Text || type == ColumnType::BLOB) {
+            required += handleStatement->getColumnSize(column);
+        }
+    }
+    if (required > buffer->arenaCapacity - buffer->arenaUsed) {
+        buffer->arenaRequired = required;
+        return false;
+    }
+    for (int column = 0; column < buffer->columnCount; ++column) {
+        int cell = column * buffer->rowCapacity + buffer->rowCount;
+        ColumnType type = handleStatement->getType(column);
+        buffer->types[cell] = getBridgedColumnType(type);
+        const void* value = nullptr;
+        unsigned long long length = 0;
+        switch (type) {
+        case ColumnType::Integer:
+            buffer->integers[cell] = handleStatement->getInteger(column);
+            break;
+        case ColumnType::Float:
+            buffer->doubles[cell] = handleStatement->getDouble(column);
+            break;
+        case ColumnType::Text: {
+            auto text = handleStatement->getText(column);
+            value = text.data();
+            length = text.length();
+        } break;
+        case ColumnType::BLOB: {
+            auto blob = handleStatement->getBLOB(column);
+            value = blob.buffer();
+            length = blob.size();
+        } break;
+        case ColumnType::Null:
+            break;
+        }
+        if (type == ColumnType::Text || type == ColumnType::BLOB) {
+            WCTAssert(buffer->arenaUsed + length <= buffer->arenaCapacity);
+            if (length > 0) {
+                memcpy(buffer->arena + buffer->arenaUsed, value, (size_t) length);
+            }
+            buffer->offsets[cell] = buffer->arenaUsed;
+            buffer->lengths[cell] = length;
+            buffer->arenaUsed += length;
+        }
+    }
+    return true;
+}
+
+static void bindRowFromColumnarBuffer(HandleStatement* handleStatement,
+                                      const CPPColumnarBuffer* buffer,
+                                      int row)
+{
+    for (int column = 0; column < buffer->columnCount; ++column) {
+        int cell = column * buffer->rowCapacity + row;
+        int index = column + 1;
+        switch (buffer->types[cell]) {
+        case WCDBColumnValueTypeInterger:
+            handleStatement->bindInteger(buffer->integers[cell], index);
+            break;
+        case WCDBColumnValueTypeFloat:
+            handleStatement->bindDouble(buffer->doubles[cell], index);
+            break;
+        case WCDBColumnValueTypeString:
+            handleStatement->bindText(
+            UnsafeStringView((const char*) buffer->arena + buffer->offsets[cell],
+                             (size_t) buffer->lengths[cell]),
+            index);
+            break;
+        case WCDBColumnValueTypeBLOB:
+            handleStatement->bindBLOB(
+            UnsafeData::immutable(buffer->arena + buffer->offsets[cell],
+                                  (size_t) buffer->lengths[cell]),
+            index);
+            break;
+        case WCDBColumnValueTypeNull:
+            handleStatement->bindNull(index);
+            break;
+        }
+    }
+}
+
+} // namespace WCDB
 
 CPPError WCDBHandleStatementGetError(CPPHandleStatement handleStatement)
 {
@@ -95,6 +204,72 @@ bool WCDBHandleStatementIsDone(CPPHandleStatement handleStatement)
     return cppHandleStatement->done();
 }
 
+bool WCDBHandleStatementStepBatch(CPPHandleStatement handleStatement,
+                                  CPPColumnarBuffer* _Nonnull buffer)
+{
+    WCDBGetObjectOrReturnValue(
+    handleStatement, WCDB::HandleStatement, cppHandleStatement, false);
+    WCTAssert(buffer->arena != nullptr || buffer->arenaCapacity == 0);
+    buffer->rowCount = 0;
+    buffer->arenaUsed = 0;
+    buffer->arenaRequired = 0;
+    buffer->done = false;
+    int numberOfColumns = cppHandleStatement->getNumberOfColumns();
+    if (buffer->columnCount > numberOfColumns) {
+        cppHandleStatement->getHandle()->notifyError(
+        WCDB::Error::Code::Misuse,
+        WCDB::UnsafeStringView(),
+        WCDB::StringView::formatted(
+        "Fetch %d columns from a statement with %d columns.", buffer->columnCount, numberOfColumns));
+        return false;
+    }
+    while (buffer->rowCount < buffer->rowCapacity) {
+        if (!buffer->hasPendingRow) {
+            if (!cppHandleStatement->step()) {
+                return false;
+            }
+            if (cppHandleStatement->done()) {
+                buffer->done = true;
+                break;
+            }
+        }
+        if (!WCDB::fetchRowToColumnarBuffer(cppHandleStatement, buffer)) {
+            buffer->hasPendingRow = true;
+            break;
+        }
+        buffer->hasPendingRow = false;
+        ++buffer->rowCount;
+    }
+    return true;
+}
+
+int WCDBHandleStatementBindAndStepBatch(CPPHandleStatement handleStatement,
+                                        const CPPColumnarBuffer* _Nonnull buffer)
+{
+    WCDBGetObjectOrReturnValue(
+    handleStatement, WCDB::HandleStatement, cppHandleStatement, 0);
+    // The parameters that are not bound by the buffer would keep the values of last row.
+    int numberOfParameters = cppHandleStatement->getBindParameterCount();
+    if (buffer->columnCount != numberOfParameters) {
+        cppHandleStatement->getHandle()->notifyError(
+        WCDB::Error::Code::Misuse,
+        WCDB::UnsafeStringView(),
+        WCDB::StringView::formatted("Bind %d columns to a statement with %d parameters.",
+                                    buffer->columnCount,
+                                    numberOfParameters));
+        return 0;
+    }
+    int row = 0;
+    for (; row < buffer->rowCount; ++row) {
+        cppHandleStatement->reset();
+        WCDB::bindRowFromColumnarBuffer(cppHandleStatement, buffer, row);
+        if (!cppHandleStatement->step()) {
+            break;
+        }
+    }
+    return row;
+}
+
 void WCDBHandleStatementBindInteger(CPPHandleStatement handleStatement,
                                     int index,
                                     signed long long intValue)
@@ -153,18 +328,7 @@ WCDBHandleStatementGetColumnType(CPPHandleStatement handleStatement, int index)
 {
     WCDBGetObjectOrReturnValue(
     handleStatement, WCDB::HandleStatement, cppHandleStatement, WCDBColumnValueTypeNull);
-    switch (cppHandleStatement->getType(index)) {
-    case WCDB::Syntax::ColumnType::Integer:
-        return WCDBColumnValueTypeInterger;
-    case WCDB::Syntax::ColumnType::Float:
-        return WCDBColumnValueTypeFloat;
-    case WCDB::Syntax::ColumnType::BLOB:
-        return WCDBColumnValueTypeBLOB;
-    case WCDB::Syntax::ColumnType::Text:
-        return WCDBColumnValueTypeString;
-    case WCDB::Syntax::ColumnType::Null:
-        return WCDBColumnValueTypeNull;
-    }
+    return WCDB::getBridgedColumnType(cppHandleStatement->getType(index));
 }
 
 signed long long WCDBHandleStatementGetInteger(CPPHandleStatement handleStatement, int index)
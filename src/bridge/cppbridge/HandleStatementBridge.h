@@ -39,6 +39,31 @@ enum WCDBColumnValueType {
     WCDBColumnValueTypeNull,
 };
 
+/*
+ Columnar buffer for batched fetching and binding.
+ The cell at (row, column) is stored at `column * rowCapacity + row` of `types`, `integers`, `doubles`, `offsets` and `lengths`.
+ Text and BLOB values are stored in `arena` as `lengths` bytes starting at `offsets`. Text is not null-terminated.
+ */
+typedef struct CPPColumnarBuffer {
+    int columnCount;
+    int rowCapacity;
+    int rowCount;
+    enum WCDBColumnValueType* _Nonnull types;
+    signed long long* _Nonnull integers;
+    double* _Nonnull doubles;
+    unsigned long long* _Nonnull offsets;
+    unsigned long long* _Nonnull lengths;
+    unsigned char* _Nullable arena;
+    unsigned long long arenaCapacity;
+    unsigned long long arenaUsed;
+    // Arena bytes needed by the pending row.
+    unsigned long long arenaRequired;
+    // The current row of statement is stepped but not fetched yet, which will be fetched first by next batch.
+    // It should be cleared after the statement is reset.
+    bool hasPendingRow;
+    bool done;
+} CPPColumnarBuffer;
+
 CPPError WCDBHandleStatementGetError(CPPHandleStatement handleStatement);
 
 bool WCDBHandleStatementPrepare(CPPHandleStatement handleStatement,
@@ -52,6 +77,22 @@ void WCDBHandleStatementClearBindings(CPPHandleStatement handleStatement);
 void WCDBHandleStatementFinalize(CPPHandleStatement handleStatement);
 bool WCDBHandleStatementIsDone(CPPHandleStatement handleStatement);
 
+/*
+ Step up to `rowCapacity` rows into buffer, starting from the pending row if any.
+ The batch stops early when the text and BLOB values of next row don't fit into the rest of arena.
+ Return false on error, and the rows fetched before the error are kept in buffer, so that `rowCount` is the index of the failed row.
+ It's a misuse error if `columnCount` is more than the number of columns of the statement.
+ */
+bool WCDBHandleStatementStepBatch(CPPHandleStatement handleStatement,
+                                  CPPColumnarBuffer* _Nonnull buffer);
+/*
+ Bind each of the `rowCount` rows to parameters 1 to `columnCount` and step it.
+ Return the number of rows stepped successfully, which is the index of the failed row on error. The failed row and the following ones are not stepped.
+ It's a misuse error, with no row stepped, if `columnCount` is not equal to the number of parameters of the statement.
+ */
+int WCDBHandleStatementBindAndStepBatch(CPPHandleStatement handleStatement,
+                                        const CPPColumnarBuffer* _Nonnull buffer);
+
 void WCDBHandleStatementBindInteger(CPPHandleStatement handleStatement,
                                     int index,
                                     signed long long intValue);
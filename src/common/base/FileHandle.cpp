@@ -246,6 +246,22 @@ bool FileHandle::write(const UnsafeData &unsafeData)
     return false;
 }
 
+bool FileHandle::sync()
+{
+    WCTAssert(isOpened());
+#ifdef __APPLE__
+    // fsync doesn't flush the disk cache on Apple platforms.
+    if (fcntl(m_fd, F_FULLFSYNC) == 0) {
+        return true;
+    }
+#endif
+    if (wcdb_fsync(m_fd) == 0) {
+        return true;
+    }
+    setThreadedError();
+    return false;
+}
+
 #pragma mark - Memory map
 MappedData FileHandle::map(offset_t offset, size_t length, SharedHighWater highWater)
 {
@@ -65,6 +65,8 @@ public:
     ssize_t size();
     Data read(size_t size);
     bool write(const UnsafeData &unsafeData);
+    // Flush the written data to the storage device.
+    bool sync();
 
 protected:
     int m_mode;
@@ -480,6 +480,23 @@ bool FileManager::moveItems(const std::list<std::pair<StringView, StringView>> &
     return result;
 }
 
+bool FileManager::replaceFile(const UnsafeStringView &from, const UnsafeStringView &to)
+{
+#ifndef _WIN32
+    if (::rename(GetPathString(from), GetPathString(to)) == 0) {
+        return true;
+    }
+    setThreadedError(to);
+    return false;
+#else
+    if (MoveFileExW(GetPathString(from), GetPathString(to), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        return true;
+    }
+    setThreadedWinError(to);
+    return false;
+#endif
+}
+
 bool FileManager::createDirectoryWithIntermediateDirectories(const UnsafeStringView &directory)
 {
     if (directory.length() == 0) {
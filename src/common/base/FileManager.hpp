@@ -88,6 +88,8 @@ public:
     static bool
     moveItems(const std::list<StringView> &paths, const UnsafeStringView &directory);
     static bool moveItems(const std::list<std::pair<StringView, StringView>> &pairedPaths);
+    // The destination is replaced atomically, so that it's either the old file or the new one after a crash.
+    static bool replaceFile(const UnsafeStringView &from, const UnsafeStringView &to);
     static bool
     createDirectoryWithIntermediateDirectories(const UnsafeStringView &directory);
     static bool
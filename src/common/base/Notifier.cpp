@@ -24,6 +24,8 @@
 
 #include "Notifier.hpp"
 #include "Assertion.hpp"
+#include <algorithm>
+#include <limits>
 
 namespace WCDB {
 
@@ -33,20 +35,41 @@ Notifier &Notifier::shared()
     return *s_notifier;
 }
 
-Notifier::Notifier() = default;
+Notifier::Notifier() : m_lowestObservedLevel(std::numeric_limits<int>::max())
+{
+}
 
-void Notifier::setNotification(int order, const UnsafeStringView &key, const Callback &callback)
+void Notifier::setNotification(int order,
+                               const UnsafeStringView &key,
+                               const Callback &callback,
+                               Error::Level minimumLevel)
 {
     WCTAssert(callback != nullptr);
     LockGuard lockGuard(m_lock);
     WCTAssert(m_notifications.find(StringView(key)) == m_notifications.end());
-    m_notifications.insert(StringView(key), callback, order);
+    m_notifications.insert(StringView(key), { callback, minimumLevel }, order);
+    updateLowestObservedLevel();
 }
 
 void Notifier::unsetNotification(const UnsafeStringView &key)
 {
     LockGuard lockGuard(m_lock);
     m_notifications.erase(StringView(key));
+    updateLowestObservedLevel();
+}
+
+void Notifier::updateLowestObservedLevel()
+{
+    int lowestLevel = std::numeric_limits<int>::max();
+    for (const auto &element : m_notifications) {
+        lowestLevel = std::min(lowestLevel, (int) element.value().minimumLevel);
+    }
+    m_lowestObservedLevel.store(lowestLevel, std::memory_order_relaxed);
+}
+
+bool Notifier::isObserving(Error::Level level) const
+{
+    return (int) level >= m_lowestObservedLevel.load(std::memory_order_relaxed);
 }
 
 void Notifier::setNotificationForPreprocessing(const UnsafeStringView &key,
@@ -62,12 +85,18 @@ void Notifier::setNotificationForPreprocessing(const UnsafeStringView &key,
 
 void Notifier::notify(Error &error) const
 {
+    if (!isObserving(error.level)) {
+        return;
+    }
     SharedLockGuard lockGuard(m_lock);
     for (const auto &element : m_preprocessNotifications) {
         element.second(error);
     }
     for (const auto &element : m_notifications) {
-        element.value()(error);
+        const Notification &notification = element.value();
+        if (error.level >= notification.minimumLevel) {
+            notification.callback(error);
+        }
     }
 }
 
@@ -27,6 +27,7 @@
 #include "Lock.hpp"
 #include "UniqueList.hpp"
 #include "WCDBError.hpp"
+#include <atomic>
 
 namespace WCDB {
 
@@ -37,9 +38,16 @@ public:
     void notify(Error &error) const;
 
     typedef std::function<void(const Error &)> Callback;
-    void setNotification(int order, const UnsafeStringView &key, const Callback &callback);
+    // Callback will only be called with errors whose level is not lower than minimumLevel.
+    void setNotification(int order,
+                         const UnsafeStringView &key,
+                         const Callback &callback,
+                         Error::Level minimumLevel = Error::Level::Ignore);
     void unsetNotification(const UnsafeStringView &key);
 
+    // Lock-free. Errors with a level that nobody observes can skip building and notifying.
+    bool isObserving(Error::Level level) const;
+
     typedef std::function<void(Error &error)> PreprocessCallback;
     void setNotificationForPreprocessing(const UnsafeStringView &key,
                                          const PreprocessCallback &callback);
@@ -51,7 +59,13 @@ protected:
 
     mutable SharedLock m_lock;
 
-    UniqueList<StringView, Callback> m_notifications;
+    struct Notification {
+        Callback callback;
+        Error::Level minimumLevel;
+    };
+    UniqueList<StringView, Notification> m_notifications;
+    void updateLowestObservedLevel();
+    std::atomic<int> m_lowestObservedLevel;
     StringViewMap<PreprocessCallback> m_preprocessNotifications;
 };
 
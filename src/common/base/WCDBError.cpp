@@ -289,6 +289,18 @@ void Error::setSQLiteCode(int rc, const UnsafeStringView& message)
     }
 }
 
+void Error::setIgnorableSQLiteCode(int rc)
+{
+    level = Level::Ignore;
+    m_code = rc2c(rc);
+    m_message = StringView::makeConstant(sqlite3_errstr(rc));
+    if (c2rc(m_code) == rc) {
+        infos.erase(ErrorIntKeyExtCode);
+    } else {
+        infos.insert_or_assign(ErrorIntKeyExtCode, rc);
+    }
+}
+
 Error::Code Error::code() const
 {
     return m_code;
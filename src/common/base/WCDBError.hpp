@@ -198,6 +198,8 @@ public:
                           const UnsafeStringView &message = UnsafeStringView());
 #endif
     void setSQLiteCode(int code, const UnsafeStringView &message = UnsafeStringView());
+    // Cheap path for expected failures. The message is the constant description of code, so nothing is formatted or copied.
+    void setIgnorableSQLiteCode(int code);
     void setCode(Code code, const UnsafeStringView &message = UnsafeStringView());
 
 protected:
@@ -0,0 +1,212 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BufferedPerformanceTracer.hpp"
+#include "Assertion.hpp"
+#include "CoreConst.h"
+
+namespace WCDB {
+
+BufferedPerformanceTracer::BufferedPerformanceTracer()
+: m_threadedRing(nullptr), m_generation(0), m_notification(nullptr), m_enabled(false)
+{
+}
+
+BufferedPerformanceTracer::~BufferedPerformanceTracer() = default;
+
+BufferedPerformanceTracer &BufferedPerformanceTracer::shared()
+{
+    static BufferedPerformanceTracer *s_tracer = new BufferedPerformanceTracer;
+    return *s_tracer;
+}
+
+void BufferedPerformanceTracer::setNotification(const Notification &notification)
+{
+    LockGuard lockGuard(m_lock);
+    m_notification = notification;
+    m_enabled = notification != nullptr;
+}
+
+bool BufferedPerformanceTracer::isEnabled() const
+{
+    return m_enabled;
+}
+
+#pragma mark - Producer
+void BufferedPerformanceTracer::record(const Tag &tag,
+                                       const UnsafeStringView &path,
+                                       const void *handle,
+                                       const UnsafeStringView &sql,
+                                       const PerformanceInfo &info)
+{
+    if (!m_enabled) {
+        return;
+    }
+    Record record;
+    record.path = intern(path);
+    record.sql = intern(sql);
+    record.tag = tag;
+    record.handle = handle;
+    record.info = info;
+    Ring &ring = *getOrCreateThreadedRing();
+    if (!ring.push(record)) {
+        ring.numberOfDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::shared_ptr<BufferedPerformanceTracer::Ring> &
+BufferedPerformanceTracer::getOrCreateThreadedRing()
+{
+    std::shared_ptr<Ring> &ring = m_threadedRing.getOrCreate();
+    if (ring == nullptr) {
+        ring = std::make_shared<Ring>();
+        LockGuard lockGuard(m_ringsLock);
+        m_rings.push_back(ring);
+    }
+    return ring;
+}
+
+#pragma mark - Consumer
+bool BufferedPerformanceTracer::drain()
+{
+    Notification notification;
+    {
+        SharedLockGuard lockGuard(m_lock);
+        notification = m_notification;
+    }
+    if (notification == nullptr) {
+        return false;
+    }
+
+    std::vector<Record> records;
+    uint64_t numberOfDropped = 0;
+    {
+        LockGuard lockGuard(m_ringsLock);
+        for (auto iter = m_rings.begin(); iter != m_rings.end();) {
+            Ring &ring = **iter;
+            Record record;
+            while (ring.pop(record)) {
+                records.push_back(record);
+            }
+            numberOfDropped += ring.numberOfDropped.exchange(0, std::memory_order_relaxed);
+            if (iter->use_count() == 1) {
+                // The owner thread exited and all its records are drained.
+                iter = m_rings.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+    if (records.empty() && numberOfDropped == 0) {
+        return true;
+    }
+
+    std::vector<Trace> traces;
+    traces.reserve(records.size());
+    for (auto &record : records) {
+        traces.push_back({ record.tag,
+                           std::move(record.path),
+                           record.handle,
+                           std::move(record.sql),
+                           record.info });
+    }
+    {
+        LockGuard lockGuard(m_stringsLock);
+        if (m_strings.size() > BufferedPerformanceTracerMaxNumberOfInternedStrings) {
+            // Producers will intern their strings again once they find the generation changed.
+            // The records in the rings still hold their strings by reference.
+            m_strings.clear();
+            m_generation.fetch_add(1, std::memory_order_release);
+        }
+    }
+    notification(traces, numberOfDropped);
+    return true;
+}
+
+#pragma mark - Intern
+StringView BufferedPerformanceTracer::intern(const UnsafeStringView &string)
+{
+    InternedStrings &internedStrings = m_threadedInternedStrings.getOrCreate();
+    uint64_t generation = m_generation.load(std::memory_order_acquire);
+    if (internedStrings.generation != generation) {
+        internedStrings.strings.clear();
+        internedStrings.generation = generation;
+    }
+    auto iter = internedStrings.strings.find(string);
+    if (iter != internedStrings.strings.end()) {
+        return *iter;
+    }
+    StringView interned;
+    {
+        LockGuard lockGuard(m_stringsLock);
+        auto sharedIter = m_strings.find(string);
+        if (sharedIter != m_strings.end()) {
+            interned = *sharedIter;
+        } else {
+            interned = StringView(string);
+            m_strings.emplace(interned);
+        }
+    }
+    internedStrings.strings.emplace(interned);
+    return interned;
+}
+
+BufferedPerformanceTracer::InternedStrings::InternedStrings() : generation(0)
+{
+}
+
+#pragma mark - Ring
+BufferedPerformanceTracer::Ring::Ring()
+: numberOfDropped(0)
+, m_records(new Record[BufferedPerformanceTracerRingCapacity])
+, m_head(0)
+, m_tail(0)
+{
+}
+
+BufferedPerformanceTracer::Ring::~Ring() = default;
+
+bool BufferedPerformanceTracer::Ring::push(const Record &record)
+{
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) >= BufferedPerformanceTracerRingCapacity) {
+        return false;
+    }
+    m_records[tail % BufferedPerformanceTracerRingCapacity] = record;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool BufferedPerformanceTracer::Ring::pop(Record &record)
+{
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    record = std::move(m_records[head % BufferedPerformanceTracerRingCapacity]);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+} // namespace WCDB
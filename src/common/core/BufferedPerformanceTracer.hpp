@@ -0,0 +1,132 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "HandleNotification.hpp"
+#include "Lock.hpp"
+#include "StringView.hpp"
+#include "ThreadLocal.hpp"
+#include <atomic>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace WCDB {
+
+/*
+ * Buffered performance tracer records the traces into per-thread single-producer/single-consumer ring buffers
+ * as compact records, which are drained by a background consumer and delivered to the notification in batches.
+ * SQLs and paths are interned, so each distinct string is only copied once and the records share it by reference.
+ * The executing thread takes no lock for the strings it has seen before,
+ * but the first time it sees a string, it takes the lock of the shared table to intern it.
+ * So the SQLs with literal values, which are different every time, take the lock on every trace.
+ * Traces are dropped and counted when the ring buffer of a thread is full.
+ */
+class BufferedPerformanceTracer final {
+public:
+    BufferedPerformanceTracer();
+    ~BufferedPerformanceTracer();
+    BufferedPerformanceTracer(const BufferedPerformanceTracer &) = delete;
+    BufferedPerformanceTracer &operator=(const BufferedPerformanceTracer &) = delete;
+
+    static BufferedPerformanceTracer &shared();
+
+    using PerformanceInfo = HandleNotification::PerformanceInfo;
+    struct Trace {
+        long tag;
+        StringView path;
+        const void *handle;
+        StringView sql;
+        PerformanceInfo info;
+    };
+    typedef struct Trace Trace;
+    typedef std::function<void(const std::vector<Trace> &traces, uint64_t numberOfDroppedTraces)> Notification;
+    void setNotification(const Notification &notification);
+    bool isEnabled() const;
+
+    void record(const Tag &tag,
+                const UnsafeStringView &path,
+                const void *handle,
+                const UnsafeStringView &sql,
+                const PerformanceInfo &info);
+
+    // Return false if the tracer is disabled and no more drain is needed.
+    bool drain();
+
+private:
+    struct Record {
+        StringView path;
+        StringView sql;
+        long tag;
+        const void *handle;
+        PerformanceInfo info;
+    };
+    typedef struct Record Record;
+
+    class Ring final {
+    public:
+        Ring();
+        ~Ring();
+
+        // Only called by the owner thread.
+        bool push(const Record &record);
+        // Only called by the consumer.
+        bool pop(Record &record);
+
+        std::atomic<uint64_t> numberOfDropped;
+
+    private:
+        std::unique_ptr<Record[]> m_records;
+        std::atomic<size_t> m_head;
+        std::atomic<size_t> m_tail;
+    };
+
+    std::shared_ptr<Ring> &getOrCreateThreadedRing();
+    SharedLock m_ringsLock;
+    std::list<std::shared_ptr<Ring>> m_rings;
+    ThreadLocal<std::shared_ptr<Ring>> m_threadedRing;
+
+    struct InternedStrings {
+        InternedStrings();
+
+        uint64_t generation;
+        StringViewSet strings;
+    };
+    typedef struct InternedStrings InternedStrings;
+
+    // The interned strings are compared in full and referenced by the records,
+    // so that the table can be cleared at any time without affecting the records not drained yet.
+    StringView intern(const UnsafeStringView &string);
+    SharedLock m_stringsLock;
+    StringViewSet m_strings;
+    std::atomic<uint64_t> m_generation;
+    ThreadLocal<InternedStrings> m_threadedInternedStrings;
+
+    mutable SharedLock m_lock;
+    Notification m_notification;
+    std::atomic<bool> m_enabled;
+};
+
+} // namespace WCDB
@@ -33,6 +33,7 @@
 #include "Global.hpp"
 #include "Notifier.hpp"
 #include "OneOrBinaryTokenizer.hpp"
+#include "PageCacheGovernor.hpp"
 #include "PinyinTokenizer.hpp"
 #include "SQLite.h"
 #include "ScalarFunctionTemplate.hpp"
@@ -75,6 +76,8 @@ Core::Core()
 , m_enableBusyTrace(false)
 //Merge
 , m_AutoMergeFTSConfig(std::make_shared<AutoMergeFTSIndexConfig>(m_operationQueue))
+// Integrity
+, m_autoIntegrityCheckConfig(std::make_shared<AutoIntegrityCheckConfig>(m_operationQueue))
 // Config
 , m_configs({
   { StringView(GlobalSQLTraceConfigName), m_globalSQLTraceConfig, Configs::Priority::Highest },
@@ -146,6 +149,16 @@ void Core::setSoftHeapLimit(int64_t limit)
     sqlite3_soft_heap_limit64(limit);
 }
 
+void Core::setPageCacheBudget(int64_t bytes)
+{
+    PageCacheGovernor::shared().setBudget(bytes);
+}
+
+int64_t Core::getPageCacheBudget() const
+{
+    return PageCacheGovernor::shared().getBudget();
+}
+
 void Core::stopQueue()
 {
     m_operationQueue->stop();
@@ -233,6 +246,15 @@ bool Core::tokenizerExists(const UnsafeStringView& name) const
     return m_tokenizerModules->get(name) != nullptr;
 }
 
+std::shared_ptr<FTS5TokenizerModule> Core::getFTS5Tokenizer(const UnsafeStringView& name) const
+{
+    const TokenizerModule* module = m_tokenizerModules->get(name);
+    if (module == nullptr) {
+        return nullptr;
+    }
+    return module->getFts5Module();
+}
+
 std::shared_ptr<Config> Core::tokenizerConfig(const UnsafeStringView& tokenizeName)
 {
     return std::make_shared<TokenizerConfig>(tokenizeName, m_tokenizerModules);
@@ -278,6 +300,16 @@ Optional<bool> Core::compressionShouldBeOperated(const UnsafeStringView& path)
     return done;
 }
 
+Optional<bool> Core::vacuumShouldBeOperated(const UnsafeStringView& path)
+{
+    RecyclableDatabase database = m_databasePool.getOrCreate(path);
+    Optional<bool> done = true; // mark as done if database is not referenced.
+    if (database != nullptr) {
+        done = database->stepVacuum(VacuumTimeSlice);
+    }
+    return done;
+}
+
 void Core::backupShouldBeOperated(const UnsafeStringView& path)
 {
     RecyclableDatabase database = m_databasePool.getOrCreate(path);
@@ -310,11 +342,67 @@ void Core::integrityShouldBeChecked(const UnsafeStringView& path)
     }
 }
 
+void Core::incrementalIntegrityShouldBeChecked(const UnsafeStringView& path)
+{
+    if (m_operationQueue->isFileObservedCorrupted(path)) {
+        return;
+    }
+    RecyclableDatabase database = m_databasePool.getOrCreate(path);
+    if (database != nullptr) {
+        database->checkIntegrityIncrementally(true);
+    }
+}
+
 void Core::purgeShouldBeOperated()
 {
     purgeDatabasePool();
 }
 
+void Core::handlesShouldBeWarmedUp(const UnsafeStringView& path)
+{
+    RecyclableDatabase database = m_databasePool.getOrCreate(path);
+    if (database != nullptr) {
+        database->warmUpHandles();
+    }
+}
+
+Optional<double> Core::idleHandlesShouldBeEvicted(const UnsafeStringView& path)
+{
+    RecyclableDatabase database = m_databasePool.getOrCreate(path);
+    if (database != nullptr) {
+        return database->evictIdleHandles();
+    }
+    return NullOpt;
+}
+
+void Core::pagesShouldBePrewarmed(const UnsafeStringView& path)
+{
+    RecyclableDatabase database = m_databasePool.getOrCreate(path);
+    if (database != nullptr) {
+        database->prewarmPages();
+    }
+}
+
+bool Core::performanceTracesShouldBeDrained()
+{
+    return BufferedPerformanceTracer::shared().drain();
+}
+
+void Core::asyncWarmUpHandles(const UnsafeStringView& path)
+{
+    m_operationQueue->asyncWarmUpHandles(path);
+}
+
+void Core::asyncEvictIdleHandles(const UnsafeStringView& path, double delay)
+{
+    m_operationQueue->asyncEvictIdleHandles(path, delay);
+}
+
+void Core::asyncPrewarm(const UnsafeStringView& path)
+{
+    m_operationQueue->asyncPrewarm(path);
+}
+
 void Core::stopAllDatabaseEvent(const UnsafeStringView& path)
 {
     m_operationQueue->stopAllDatabaseEvent(path);
@@ -458,6 +546,19 @@ void Core::enableAutoCompress(InnerDatabase* database, bool enable)
     }
 }
 
+#pragma mark - Vacuum
+void Core::enableAutoVacuum(InnerDatabase* database, bool enable)
+{
+    WCTAssert(database != nullptr);
+    if (enable) {
+        m_operationQueue->registerAsRequiredVacuum(database->getPath());
+        m_operationQueue->asyncVacuum(database->getPath());
+    } else {
+        m_operationQueue->registerAsNoVacuumRequired(database->getPath());
+        database->discardVacuum();
+    }
+}
+
 #pragma mark - Merge FTS Index
 void Core::enableAutoMergeFTSIndex(InnerDatabase* database, bool enable)
 {
@@ -509,6 +610,26 @@ void Core::setNotificationWhenPerformanceGlobalTraced(const ShareablePerformance
     ->setNotification(notification);
 }
 
+void Core::setNotificationWhenPerformanceGlobalTracedInBatch(
+const BufferedPerformanceTracer::Notification& notification)
+{
+    ShareablePerformanceTraceConfig* config
+    = static_cast<ShareablePerformanceTraceConfig*>(m_globalPerformanceTraceConfig.get());
+    BufferedPerformanceTracer::shared().setNotification(notification);
+    if (notification != nullptr) {
+        config->setNotification([](const Tag& tag,
+                                   const UnsafeStringView& path,
+                                   const void* handle,
+                                   const UnsafeStringView& sql,
+                                   const InnerHandle::PerformanceInfo& info) {
+            BufferedPerformanceTracer::shared().record(tag, path, handle, sql, info);
+        });
+        m_operationQueue->asyncDrainPerformanceTraces();
+    } else {
+        config->setNotification(nullptr);
+    }
+}
+
 void Core::setNotificationWhenErrorTraced(const Notifier::Callback& notification)
 {
     if (notification != nullptr) {
@@ -571,6 +692,41 @@ void Core::skipIntegrityCheck(const UnsafeStringView& path)
     m_operationQueue->skipIntegrityCheck(path);
 }
 
+void Core::enableAutoIncrementalIntegrityCheck(InnerDatabase* database, bool enable)
+{
+    WCTAssert(database != nullptr);
+    WCTAssert(dynamic_cast<AutoIntegrityCheckConfig*>(m_autoIntegrityCheckConfig.get()) != nullptr);
+    AutoIntegrityCheckConfig* integrityConfig
+    = static_cast<AutoIntegrityCheckConfig*>(m_autoIntegrityCheckConfig.get());
+    if (enable) {
+        database->setConfig(AutoIntegrityCheckConfigName,
+                            m_autoIntegrityCheckConfig,
+                            WCDB::Configs::Priority::Highest);
+        m_operationQueue->registerAsRequiredIncrementalIntegrity(database->getPath());
+    } else {
+        database->removeConfig(AutoIntegrityCheckConfigName);
+        m_operationQueue->registerAsNoIncrementalIntegrityRequired(database->getPath());
+        integrityConfig->clearUncheckedPages(database->getPath());
+    }
+}
+
+bool Core::takeUncheckedIntegrityPages(const UnsafeStringView& path, IntegrityPages& pages)
+{
+    WCTAssert(dynamic_cast<AutoIntegrityCheckConfig*>(m_autoIntegrityCheckConfig.get()) != nullptr);
+    AutoIntegrityCheckConfig* integrityConfig
+    = static_cast<AutoIntegrityCheckConfig*>(m_autoIntegrityCheckConfig.get());
+    return integrityConfig->takeUncheckedPages(path, pages);
+}
+
+void Core::restoreUncheckedIntegrityPages(const UnsafeStringView& path,
+                                          const IntegrityPages& pages)
+{
+    WCTAssert(dynamic_cast<AutoIntegrityCheckConfig*>(m_autoIntegrityCheckConfig.get()) != nullptr);
+    AutoIntegrityCheckConfig* integrityConfig
+    = static_cast<AutoIntegrityCheckConfig*>(m_autoIntegrityCheckConfig.get());
+    integrityConfig->restoreUncheckedPages(path, pages);
+}
+
 #pragma mark - Config
 void Core::setABTestConfig(const UnsafeStringView& configName, const UnsafeStringView& configValue)
 {
@@ -28,6 +28,7 @@
 
 #include "Config.hpp"
 #include "Configs.hpp"
+#include "BufferedPerformanceTracer.hpp"
 #include "PerformanceTraceConfig.hpp"
 #include "SQLTraceConfig.hpp"
 
@@ -60,6 +61,8 @@ public:
     void purgeDatabasePool();
     void releaseSQLiteMemory(int bytes);
     void setSoftHeapLimit(int64_t limit);
+    void setPageCacheBudget(int64_t bytes);
+    int64_t getPageCacheBudget() const;
 
     void stopQueue();
 
@@ -92,6 +95,7 @@ public:
     void registerTokenizer(const UnsafeStringView& name, const TokenizerModule& module);
     std::shared_ptr<Config> tokenizerConfig(const UnsafeStringView& tokenizeName);
     bool tokenizerExists(const UnsafeStringView& name) const;
+    std::shared_ptr<FTS5TokenizerModule> getFTS5Tokenizer(const UnsafeStringView& name) const;
 
 protected:
     std::shared_ptr<TokenizerModules> m_tokenizerModules;
@@ -118,13 +122,25 @@ public:
 protected:
     Optional<bool> migrationShouldBeOperated(const UnsafeStringView& path) override final;
     Optional<bool> compressionShouldBeOperated(const UnsafeStringView& path) override final;
+    Optional<bool> vacuumShouldBeOperated(const UnsafeStringView& path) override final;
     void backupShouldBeOperated(const UnsafeStringView& path) override final;
     void checkpointShouldBeOperated(const UnsafeStringView& path) override final;
     void integrityShouldBeChecked(const UnsafeStringView& path) override final;
+    void incrementalIntegrityShouldBeChecked(const UnsafeStringView& path) override final;
     void purgeShouldBeOperated() override final;
+    void handlesShouldBeWarmedUp(const UnsafeStringView& path) override final;
+    Optional<double> idleHandlesShouldBeEvicted(const UnsafeStringView& path) override final;
+    bool performanceTracesShouldBeDrained() override final;
+    void pagesShouldBePrewarmed(const UnsafeStringView& path) override final;
 
     std::shared_ptr<OperationQueue> m_operationQueue;
 
+#pragma mark - Handles
+public:
+    void asyncWarmUpHandles(const UnsafeStringView& path);
+    void asyncEvictIdleHandles(const UnsafeStringView& path, double delay);
+    void asyncPrewarm(const UnsafeStringView& path);
+
 #pragma mark - Checkpoint
 public:
     void enableAutoCheckpoint(InnerDatabase* database, bool enable);
@@ -158,11 +174,17 @@ public:
 protected:
     std::shared_ptr<Config> m_autoCompressConfig;
 
+#pragma mark - Vacuum
+public:
+    void enableAutoVacuum(InnerDatabase* database, bool enable);
+
 #pragma mark - Trace
 public:
     void setNotificationForSQLGLobalTraced(const ShareableSQLTraceConfig::Notification& notification);
     void setNotificationWhenPerformanceGlobalTraced(
     const ShareablePerformanceTraceConfig::Notification& notification);
+    void setNotificationWhenPerformanceGlobalTracedInBatch(
+    const BufferedPerformanceTracer::Notification& notification);
     void setNotificationWhenErrorTraced(const Notifier::Callback& notification);
     void setNotificationWhenErrorTraced(const UnsafeStringView& path,
                                         const Notifier::Callback& notification);
@@ -201,6 +223,15 @@ protected:
 public:
     void skipIntegrityCheck(const UnsafeStringView& path);
 
+    void enableAutoIncrementalIntegrityCheck(InnerDatabase* database, bool enable);
+    typedef AutoIntegrityCheckConfig::Pages IntegrityPages;
+    bool takeUncheckedIntegrityPages(const UnsafeStringView& path, IntegrityPages& pages);
+    void restoreUncheckedIntegrityPages(const UnsafeStringView& path,
+                                        const IntegrityPages& pages);
+
+protected:
+    std::shared_ptr<Config> m_autoIntegrityCheckConfig;
+
 #pragma mark - Config
 public:
     void setABTestConfig(const UnsafeStringView& configName,
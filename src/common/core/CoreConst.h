@@ -41,6 +41,9 @@ static constexpr const int OperationQueueTolerableFailuresForMigration = 5;
 #pragma mark - Operation Queue - Compression
 static constexpr const double OperationQueueTimeIntervalForCompression = 0.2;
 static constexpr const int OperationQueueTolerableFailuresForCompression = 5;
+#pragma mark - Operation Queue - Vacuum
+static constexpr const double OperationQueueTimeIntervalForVacuum = 2.0;
+static constexpr const int OperationQueueTolerableFailuresForVacuum = 5;
 #pragma mark - Operation Queue - Purge
 static constexpr const double OperationQueueTimeIntervalForPurgingAgain = 30.0;
 static constexpr const double OperationQueueRateForTooManyFileDescriptors = 0.7;
@@ -52,14 +55,22 @@ static double OperationQueueTimeIntervalForBackup = 600.0;
 #else
 static double OperationQueueTimeIntervalForBackup = 10.0;
 #endif
+#pragma mark - Operation Queue - Integrity
+static constexpr const double OperationQueueTimeIntervalForIncrementalIntegrity = 600.0;
 #pragma mark - Operation Queue - Merge FTS Index
 static constexpr const double OperationQueueTimeIntervalForMergeFTSIndex
 = 1.871; //Use prime numbers to reduce the probability of collision with external logic
+#pragma mark - Operation Queue - Idle Handles
+static constexpr const double OperationQueueMinTimeIntervalForEvictingIdleHandles = 1.0;
+#pragma mark - Operation Queue - Performance Trace
+static constexpr const double OperationQueueTimeIntervalForDrainingPerformanceTraces = 0.5;
 
 #pragma mark - Config - Auto Checkpoint
 WCDBLiteralStringDefine(AutoCheckpointConfigName, "com.Tencent.WCDB.Config.AutoCheckpoint");
 #pragma mark - Config - Auto Backup
 WCDBLiteralStringDefine(AutoBackupConfigName, "com.Tencent.WCDB.Config.AutoBackup");
+#pragma mark - Config - Auto Integrity Check
+WCDBLiteralStringDefine(AutoIntegrityCheckConfigName, "com.Tencent.WCDB.Config.AutoIntegrityCheck");
 #pragma mark - Config - Auto Migrate
 WCDBLiteralStringDefine(AutoMigrateConfigName, "com.Tencent.WCDB.Config.AutoMigrate");
 #pragma mark - Config - Auto Compress
@@ -68,11 +79,21 @@ WCDBLiteralStringDefine(AutoCompressConfigName, "com.Tencent.WCDB.Config.AutoCom
 WCDBLiteralStringDefine(AutoMergeFTSIndexConfigName, "com.Tencent.WCDB.Config.AutoMergeFTSIndex");
 WCDBLiteralStringDefine(AutoMergeFTSIndexQueueName, "WCDB.MergeIndex");
 static constexpr const int AutoMergeFTS5IndexMinSegmentCount = 4;
-static constexpr const double AutoMergeFTSIndexMaxExpectingDuration = 0.02;
+static constexpr const double AutoMergeFTSIndexDefaultMaxDurationPerRun = 0.2;
+static constexpr const int AutoMergeFTSIndexDefaultMaxPagesPerRun = 2048;
+static constexpr const double AutoMergeFTSIndexForegroundBackoffDelay = 0.307;
+static constexpr const int AutoMergeFTSIndexMaxForegroundBackoffCount = 8;
+static constexpr const int AutoMergeFTSIndexErrorCountToNotify = 5;
+static constexpr const double AutoMergeFTSIndexMaxSuspendedDuration = 600.0;
 static constexpr const double AutoMergeFTSIndexMaxInitializeDuration = 0.005;
+#pragma mark - Config - Vacuum Track
+WCDBLiteralStringDefine(VacuumTrackConfigName, "com.Tencent.WCDB.Config.VacuumTrack");
 #pragma mark - Config - Basic
 WCDBLiteralStringDefine(BasicConfigName, "com.Tencent.WCDB.Config.Basic");
 static constexpr const int BasicConfigBusyRetryMaxAllowedNumberOfTimes = 3;
+// The adaptive mmap size is twice the file size rounded up to the power of 2 and limited in the range.
+static constexpr const int64_t BasicConfigMinAdaptiveMMapSize = 32 * 1024 * 1024;
+static constexpr const int64_t BasicConfigMaxAdaptiveMMapSize = 1024 * 1024 * 1024;
 #pragma mark - Config - Busy Retry
 WCDBLiteralStringDefine(BusyRetryConfigName, "com.Tencent.WCDB.Config.BusyRetry");
 static constexpr const double BusyRetryTimeOut = 10.0;
@@ -102,6 +123,7 @@ WCDBLiteralStringDefine(NotifierLoggerName, "com.Tencent.WCDB.Notifier.Log");
 #pragma mark - Handle Pool
 static constexpr const int HandlePoolMaxAllowedNumberOfHandles = 32;
 static constexpr const int HandlePoolMaxAllowedNumberOfWriters = 4;
+static constexpr const int HandlePoolMaxAllowedNumberOfWarmHandles = 8;
 
 enum HandleSlot : unsigned char {
     HandleSlotNormal = 0,
@@ -154,11 +176,46 @@ static constexpr bool handleShouldWaitWhenFull(HandleType type)
     return type == HandleType::Normal;
 }
 
+enum class HandlePriority : unsigned char {
+    Background = 0,
+    Normal,
+    Interactive,
+};
+static constexpr const int HandlePriorityCount = 3;
+// A waiting thread is promoted by one priority after each interval.
+static constexpr const double HandleCounterAgingInterval = 0.5;
+// The i-th bucket counts the waits shorter than 2^i milliseconds, and the last one counts the rest.
+static constexpr const int HandleCounterWaitHistogramBucketCount = 12;
+
+#pragma mark - Page Cache Governor
+static constexpr const int64_t PageCacheGovernorMinCacheSizePerHandle = 256 * 1024;
+static constexpr const double PageCacheGovernorHalfLifeOfActivity = 10.0;
+// The cache size of a handle is only changed when the new limit differs from the current one by more than this ratio.
+static constexpr const double PageCacheGovernorToleranceOfCacheSizeChange = 0.25;
+
+#pragma mark - Buffered Performance Tracer
+static constexpr const size_t BufferedPerformanceTracerRingCapacity = 1024;
+static constexpr const size_t BufferedPerformanceTracerMaxNumberOfInternedStrings = 4096;
+
+#pragma mark - Statement Statistics
+// The shapes with the least total cost are evicted once a database has more shapes than this.
+static constexpr const size_t StatementStatisticsMaxNumberOfShapesPerDatabase = 256;
+// The latencies are counted in microseconds with 2^StatementStatisticsHistogramSubBucketBits sub-buckets per power of 2.
+static constexpr const int StatementStatisticsHistogramSubBucketBits = 3;
+static constexpr const int StatementStatisticsHistogramMaxBits = 36;
+
 #pragma mark - Backup
 static constexpr const int BackupMaxIncrementalTimes = 1000;
 static constexpr const int BackupMaxIncrementalPageCount = 1000;
 static constexpr const int BackupMaxAllowIncrementalPageCount = 1000000;
 
+#pragma mark - Repair
+static constexpr const size_t RepairSharedPageCacheSize = 16 * 1024 * 1024;
+
+#pragma mark - Integrity
+static constexpr const int IntegrityMaxIncrementalPageCount = 100000;
+static constexpr const double IntegrityDefaultFullCheckInterval = 7 * 24 * 3600.0;
+
 #pragma mark - Migrate
 static constexpr const double MigrateMaxExpectingDuration = 0.01;
 static constexpr const double MigrateMaxInitializeDuration = 0.005;
@@ -169,6 +226,18 @@ static constexpr const int CompressionUpdateRecordBatchCount = 1000;
 
 #pragma mark - Vacuum
 static constexpr const int VacuumBatchCount = 1000;
+static constexpr const double VacuumTimeSlice = 0.1;
+// The copied rows are committed and the checkpoint is saved at this interval.
+static constexpr const double VacuumCheckpointInterval = 1.0;
+// Vacuum is given up after starting over, or copying a table again, for this number of times.
+static constexpr const int VacuumMaxNumberOfRestarts = 3;
+static constexpr const int VacuumMaxNumberOfWorkers = 4;
+static constexpr const int VacuumMinParallelRowCount = 100000;
+
+#pragma mark - FTS Bulk Index
+static constexpr const int FTSBulkIndexMaxNumberOfWorkers = 8;
+static constexpr const int FTSBulkIndexMinRowCount = 64;
+static constexpr const int FTSBulkIndexMaxPendingRowCount = 4096;
 
 WCDBLiteralStringDefine(ErrorStringKeyType, "Type");
 WCDBLiteralStringDefine(ErrorStringKeySource, "Source")
@@ -200,6 +269,7 @@ WCDBLiteralStringDefine(ErrorSourceZstd, "Zstd");
 #pragma mark - Error - Type
 WCDBLiteralStringDefine(ErrorTypeMigrate, "Migrate");
 WCDBLiteralStringDefine(ErrorTypeCompress, "Compress");
+WCDBLiteralStringDefine(ErrorTypeVacuum, "Vacuum");
 WCDBLiteralStringDefine(ErrorTypeCheckpoint, "Checkpoint");
 WCDBLiteralStringDefine(ErrorTypeIntegrity, "Integrity");
 WCDBLiteralStringDefine(ErrorTypeBackup, "Backup")
@@ -24,70 +24,158 @@
 
 #include "HandleCounter.hpp"
 #include "Assertion.hpp"
+#include "ThreadLocal.hpp"
+#include <algorithm>
+#include <cmath>
 #include <condition_variable>
 
 namespace WCDB {
 
-HandleCounter::HandleCounter() : m_writerCount(0), m_totalCount(0)
+HandleCounter::HandleCounter()
+: m_writerCount(0), m_maxNumberOfWriters(HandlePoolMaxAllowedNumberOfWriters), m_totalCount(0)
 {
 }
 
-HandleCounter::~HandleCounter() = default;
+HandleCounter::~HandleCounter()
+{
+    WCTAssert(m_waiters.empty());
+}
 
 bool HandleCounter::tryIncreaseHandleCount(HandleType type, bool writeHint)
 {
     std::unique_lock<std::mutex> lockGuard(m_lock);
-    while (m_totalCount >= HandlePoolMaxAllowedNumberOfHandles
-           || (writeHint && m_writerCount >= HandlePoolMaxAllowedNumberOfWriters)) {
-        while (m_totalCount >= HandlePoolMaxAllowedNumberOfHandles) {
-            if (!handleShouldWaitWhenFull(type)) {
-                return false;
-            }
-            m_pendingNormals.emplace(Thread::current());
-            m_conditionalNormals.wait(lockGuard);
-            m_pendingNormals.pop();
-        }
-        while (writeHint && m_writerCount >= HandlePoolMaxAllowedNumberOfWriters) {
-            if (!handleShouldWaitWhenFull(type)) {
-                return false;
-            }
-            m_pendingWriters.emplace(Thread::current());
-            m_conditionalWriters.wait(lockGuard);
-            m_pendingWriters.pop();
-        }
+    if (isAdmissible(writeHint) && (m_waiters.empty() || !handleShouldWaitWhenFull(type))) {
+        admit(writeHint);
+        return true;
     }
-    if (writeHint) {
-        m_writerCount++;
+    if (!handleShouldWaitWhenFull(type)) {
+        return false;
     }
-    m_totalCount++;
+    m_waiters.emplace_back(getThreadedPriority(), writeHint);
+    auto waiter = std::prev(m_waiters.end());
+    // The handles may be released between the check above and the enqueue.
+    dispatch();
+    while (!waiter->admitted) {
+        waiter->conditional.wait(lockGuard);
+    }
+    recordWait(waiter->priority, SteadyClock::timeIntervalSinceSteadyClockToNow(waiter->since));
+    m_waiters.erase(waiter);
     return true;
 }
 
 void HandleCounter::decreaseHandleCount(bool writeHint)
 {
-    bool hasNotified = false;
     std::unique_lock<std::mutex> lockGuard(m_lock);
     if (writeHint) {
         m_writerCount--;
         WCTAssert(m_writerCount >= 0);
-        if (m_pendingWriters.size() > 0) {
-#ifdef __APPLE__
-            m_conditionalWriters.notify(m_pendingWriters.front());
-#else
-            m_conditionalWriters.notify_all();
-#endif
-            hasNotified = true;
-        }
     }
     m_totalCount--;
     WCTAssert(m_totalCount >= 0);
-    if (!hasNotified && m_pendingNormals.size() > 0) {
-#ifdef __APPLE__
-        m_conditionalNormals.notify(m_pendingNormals.front());
-#else
-        m_conditionalNormals.notify_all();
-#endif
+    dispatch();
+}
+
+void HandleCounter::setMaxNumberOfWriters(int count)
+{
+    std::unique_lock<std::mutex> lockGuard(m_lock);
+    m_maxNumberOfWriters = std::max(count, 1);
+    // The waiting writers may be admissible now.
+    dispatch();
+}
+
+bool HandleCounter::isAdmissible(bool writeHint) const
+{
+    return m_totalCount < HandlePoolMaxAllowedNumberOfHandles
+           && (!writeHint || m_writerCount < m_maxNumberOfWriters);
+}
+
+void HandleCounter::admit(bool writeHint)
+{
+    WCTAssert(isAdmissible(writeHint));
+    if (writeHint) {
+        m_writerCount++;
+    }
+    m_totalCount++;
+}
+
+void HandleCounter::dispatch()
+{
+    SteadyClock now = SteadyClock::now();
+    while (m_totalCount < HandlePoolMaxAllowedNumberOfHandles) {
+        Waiter *chosen = nullptr;
+        double chosenPriority = 0;
+        // Waiters are in the order they arrive, so the earliest one wins the tie.
+        for (auto &waiter : m_waiters) {
+            if (waiter.admitted || !isAdmissible(waiter.writeHint)) {
+                continue;
+            }
+            double priority
+            = (double) waiter.priority
+              + std::floor(now.timeIntervalSinceSteadyClock(waiter.since) / HandleCounterAgingInterval);
+            if (chosen == nullptr || priority > chosenPriority) {
+                chosen = &waiter;
+                chosenPriority = priority;
+            }
+        }
+        if (chosen == nullptr) {
+            break;
+        }
+        // Count it in advance so that the newcomers can't take the place of the chosen one.
+        admit(chosen->writeHint);
+        chosen->admitted = true;
+        chosen->conditional.notify_one();
+    }
+}
+
+void HandleCounter::recordWait(HandlePriority priority, double waitTime)
+{
+    WaitStatistics &statistics = m_statistics[(int) priority];
+    ++statistics.count;
+    statistics.totalWaitTime += waitTime;
+    statistics.maxWaitTime = std::max(statistics.maxWaitTime, waitTime);
+    int bucket = 0;
+    for (double bound = 0.001;
+         waitTime >= bound && bucket < HandleCounterWaitHistogramBucketCount - 1;
+         bound *= 2) {
+        ++bucket;
+    }
+    ++statistics.histogram[bucket];
+}
+
+HandleCounter::PriorityWaitStatistics HandleCounter::getWaitStatistics() const
+{
+    std::unique_lock<std::mutex> lockGuard(m_lock);
+    return m_statistics;
+}
+
+static ThreadLocal<int> &threadedPriority()
+{
+    static ThreadLocal<int> *s_priority = new ThreadLocal<int>(-1);
+    return *s_priority;
+}
+
+void HandleCounter::setThreadedPriority(HandlePriority priority)
+{
+    threadedPriority().getOrCreate() = (int) priority;
+}
+
+HandlePriority HandleCounter::getThreadedPriority()
+{
+    int priority = threadedPriority().getOrCreate();
+    if (priority >= 0) {
+        return (HandlePriority) priority;
     }
+    return Thread::isMain() ? HandlePriority::Interactive : HandlePriority::Normal;
+}
+
+HandleCounter::WaitStatistics::WaitStatistics()
+: count(0), totalWaitTime(0), maxWaitTime(0), histogram()
+{
+}
+
+HandleCounter::Waiter::Waiter(HandlePriority priority_, bool writeHint_)
+: priority(priority_), writeHint(writeHint_), since(SteadyClock::now()), admitted(false)
+{
 }
 
 } // namespace WCDB
@@ -25,6 +25,9 @@
 #include "CoreConst.h"
 #include "Lock.hpp"
 #include "Thread.hpp"
+#include "Time.hpp"
+#include <array>
+#include <list>
 
 namespace WCDB {
 
@@ -37,11 +40,14 @@ namespace WCDB {
  *    Because it is difficult to accurately distinguish whether the handle is used for writing,
  *    and there is still a little time between getting the handle and writing data,
  *    let the four handles fully compete.
+ *    In single writer mode, only 1 is allowed so that the writers wait here instead of on the sqlite write lock.
  * 2. Only up to 32 handles can exist at the same time.
  *    Too many handles not only take up memory, but generally imply inappropriate usage.
  *
  * When the number limit is exceeded, the handle counter will let the thread
  * that acquires the handle wait in place until other handles are recycled.
+ * The waiting threads are admitted in the order of their priorities and then the order they arrive.
+ * A waiting thread is promoted by one priority after each HandleCounterAgingInterval so that it will not be starved.
  */
 
 class HandleCounter {
@@ -53,15 +59,48 @@ public:
 
     bool tryIncreaseHandleCount(HandleType type, bool writeHint);
     void decreaseHandleCount(bool writeHint);
+    // HandlePoolMaxAllowedNumberOfWriters by default.
+    void setMaxNumberOfWriters(int count);
+
+    // The main thread is interactive by default, while the others are normal.
+    static void setThreadedPriority(HandlePriority priority);
+    static HandlePriority getThreadedPriority();
+
+    struct WaitStatistics {
+        WaitStatistics();
+
+        uint64_t count;
+        double totalWaitTime;
+        double maxWaitTime;
+        std::array<uint64_t, HandleCounterWaitHistogramBucketCount> histogram;
+    };
+    typedef struct WaitStatistics WaitStatistics;
+    typedef std::array<WaitStatistics, HandlePriorityCount> PriorityWaitStatistics;
+    PriorityWaitStatistics getWaitStatistics() const;
 
 private:
+    struct Waiter {
+        Waiter(HandlePriority priority, bool writeHint);
+
+        const HandlePriority priority;
+        const bool writeHint;
+        const SteadyClock since;
+        bool admitted;
+        std::condition_variable conditional;
+    };
+    typedef struct Waiter Waiter;
+
+    bool isAdmissible(bool writeHint) const;
+    void admit(bool writeHint);
+    void dispatch();
+    void recordWait(HandlePriority priority, double waitTime);
+
     mutable std::mutex m_lock;
-    Conditional m_conditionalNormals;
-    Conditional m_conditionalWriters;
-    std::queue<Thread> m_pendingNormals;
-    std::queue<Thread> m_pendingWriters;
-    int m_writerCount = 0;
-    int m_totalCount = 0;
+    std::list<Waiter> m_waiters;
+    int m_writerCount;
+    int m_maxNumberOfWriters;
+    int m_totalCount;
+    PriorityWaitStatistics m_statistics;
 };
 
 } // namespace WCDB
@@ -36,7 +36,8 @@
 namespace WCDB {
 
 #pragma mark - Initialize
-HandlePool::HandlePool(const UnsafeStringView &thePath) : path(thePath)
+HandlePool::HandlePool(const UnsafeStringView &thePath)
+: path(thePath), m_numberOfWarmHandles(0), m_maxIdleDuration(0), m_singleWriter(false)
 {
 }
 
@@ -115,9 +116,9 @@ void HandlePool::purge()
     for (unsigned int i = 0; i < HandleSlotCount; ++i) {
         auto &handles = m_handles[i];
         auto &frees = m_frees[i];
-        for (const auto &handle : frees) {
-            handle->close();
-            handles.erase(handle);
+        for (const auto &free : frees) {
+            free.handle->close();
+            handles.erase(free.handle);
         }
         frees.clear();
     }
@@ -152,6 +153,11 @@ bool HandlePool::isAliving() const
     return aliving;
 }
 
+HandleCounter::PriorityWaitStatistics HandlePool::getHandleWaitStatistics() const
+{
+    return m_counter.getWaitStatistics();
+}
+
 const std::set<std::shared_ptr<InnerHandle>> &HandlePool::getHandlesOfSlot(HandleSlot slot)
 {
     WCTAssert(m_concurrency.readSafety());
@@ -167,6 +173,13 @@ size_t HandlePool::numberOfAliveHandlesInSlot(HandleSlot slot) const
     return m_handles[slot].size();
 }
 
+size_t HandlePool::numberOfActiveHandlesInSlot(HandleSlot slot) const
+{
+    SharedLockGuard memoryGuard(m_memory);
+    WCTAssert(m_handles[slot].size() >= m_frees[slot].size());
+    return m_handles[slot].size() - m_frees[slot].size();
+}
+
 RecyclableHandle HandlePool::flowOut(HandleType type, bool writeHint)
 {
     HandleSlot slot = slotOfHandleType(type);
@@ -205,9 +218,25 @@ RecyclableHandle HandlePool::flowOut(HandleType type, bool writeHint)
         LockGuard memoryGuard(m_memory);
         auto &freeSlot = m_frees[slot];
         if (!freeSlot.empty()) {
-            handle = freeSlot.back();
+            auto iter = std::prev(freeSlot.end());
+            if (m_singleWriter && slot == HandleSlotNormal) {
+                std::shared_ptr<InnerHandle> writer = m_writer.lock();
+                auto writerIter = std::find_if(
+                freeSlot.begin(), freeSlot.end(), [&writer](const FreeHandle &freeHandle) {
+                    return freeHandle.handle == writer;
+                });
+                if (writeHint) {
+                    if (writerIter != freeSlot.end()) {
+                        iter = writerIter;
+                    }
+                } else if (writerIter == iter && freeSlot.size() > 1) {
+                    // Keep the writer for the next write while the other handles are free.
+                    iter = std::prev(iter);
+                }
+            }
+            handle = iter->handle;
             WCTAssert(handle != nullptr);
-            freeSlot.pop_back();
+            freeSlot.erase(iter);
         }
     }
 
@@ -218,15 +247,18 @@ RecyclableHandle HandlePool::flowOut(HandleType type, bool writeHint)
             return nullptr;
         }
 
-        LockGuard memoryGuard(m_memory);
-        WCTAssert(m_handles[slot].find(handle) == m_handles[slot].end());
-        m_handles[slot].emplace(handle);
+        {
+            LockGuard memoryGuard(m_memory);
+            WCTAssert(m_handles[slot].find(handle) == m_handles[slot].end());
+            m_handles[slot].emplace(handle);
 
-        // Clean free handles of the other slots.
-        if (!isNumberOfHandlesAllowed()) {
-            purge();
-            WCTAssert(isNumberOfHandlesAllowed());
+            // Clean free handles of the other slots.
+            if (!isNumberOfHandlesAllowed()) {
+                purge();
+                WCTAssert(isNumberOfHandlesAllowed());
+            }
         }
+        didGenerateSlotedHandle(type);
     } else {
         if (!willReuseSlotedHandle(type, handle.get())) {
             handle->close();
@@ -243,6 +275,12 @@ RecyclableHandle HandlePool::flowOut(HandleType type, bool writeHint)
     WCTAssert(handle != nullptr);
     handle->setWriteHint(writeHint);
     handle->setActiveThreadId(Thread::getCurrentThreadId());
+    if (writeHint && slot == HandleSlotNormal) {
+        LockGuard memoryGuard(m_memory);
+        if (m_singleWriter) {
+            m_writer = handle;
+        }
+    }
 
     m_concurrency.lockShared();
     WCTAssert(referencedHandle.handle == nullptr && referencedHandle.reference == 0);
@@ -273,9 +311,10 @@ void HandlePool::flowBack(HandleType type, const std::shared_ptr<InnerHandle> &h
         !handle->isPrepared(), "Statement is not finalized.", handle->finalize(););
         handle->detachCancellationSignal();
         handle->finalizeStatements();
+        willFlowBackSlotedHandle(type, handle.get());
         {
             LockGuard memoryGuard(m_memory);
-            m_frees[slot].push_back(handle);
+            m_frees[slot].emplace_back(handle);
             handle->setWriteHint(false);
             handle->setActiveThreadId(0);
         }
@@ -284,8 +323,129 @@ void HandlePool::flowBack(HandleType type, const std::shared_ptr<InnerHandle> &h
     }
 }
 
+void HandlePool::didGenerateSlotedHandle(HandleType)
+{
+}
+
+void HandlePool::willFlowBackSlotedHandle(HandleType, InnerHandle *)
+{
+}
+
+HandlePool::FreeHandle::FreeHandle(const std::shared_ptr<InnerHandle> &handle_)
+: handle(handle_), idleSince(SteadyClock::now())
+{
+}
+
 HandlePool::ReferencedHandle::ReferencedHandle() : handle(nullptr), reference(0)
 {
 }
 
+#pragma mark - Single Writer
+void HandlePool::setSingleWriterEnable(bool enable)
+{
+    {
+        LockGuard memoryGuard(m_memory);
+        m_singleWriter = enable;
+        if (!enable) {
+            m_writer.reset();
+        }
+    }
+    m_counter.setMaxNumberOfWriters(enable ? 1 : HandlePoolMaxAllowedNumberOfWriters);
+}
+
+bool HandlePool::isSingleWriterEnabled() const
+{
+    SharedLockGuard memoryGuard(m_memory);
+    return m_singleWriter;
+}
+
+#pragma mark - Warm Handles
+void HandlePool::setNumberOfWarmHandles(int count)
+{
+    LockGuard memoryGuard(m_memory);
+    m_numberOfWarmHandles
+    = std::min(std::max(count, 0), HandlePoolMaxAllowedNumberOfWarmHandles);
+}
+
+size_t HandlePool::getNumberOfWarmHandles() const
+{
+    SharedLockGuard memoryGuard(m_memory);
+    return m_numberOfWarmHandles;
+}
+
+void HandlePool::setMaxIdleDurationOfHandles(double seconds)
+{
+    LockGuard memoryGuard(m_memory);
+    m_maxIdleDuration = std::max(seconds, 0.0);
+}
+
+double HandlePool::getMaxIdleDurationOfHandles() const
+{
+    SharedLockGuard memoryGuard(m_memory);
+    return m_maxIdleDuration;
+}
+
+bool HandlePool::warmUpHandles()
+{
+    WCTAssert(m_concurrency.readSafety());
+    while (true) {
+        {
+            SharedLockGuard memoryGuard(m_memory);
+            if (m_handles[HandleSlotNormal].size() >= m_numberOfWarmHandles
+                || numberOfAliveHandles() >= HandlePoolMaxAllowedNumberOfHandles) {
+                break;
+            }
+        }
+        std::shared_ptr<InnerHandle> handle = generateSlotedHandle(HandleType::Normal);
+        if (handle == nullptr) {
+            return false;
+        }
+        LockGuard memoryGuard(m_memory);
+        WCTAssert(m_handles[HandleSlotNormal].find(handle)
+                  == m_handles[HandleSlotNormal].end());
+        m_handles[HandleSlotNormal].emplace(handle);
+        m_frees[HandleSlotNormal].emplace_back(handle);
+    }
+    return true;
+}
+
+Optional<double> HandlePool::evictIdleHandles()
+{
+    SharedLockGuard concurrencyGuard(m_concurrency);
+    LockGuard memoryGuard(m_memory);
+    if (m_maxIdleDuration <= 0) {
+        return NullOpt;
+    }
+    Optional<double> nextExpiration;
+    SteadyClock now = SteadyClock::now();
+    for (unsigned int i = 0; i < HandleSlotCount; ++i) {
+        auto &handles = m_handles[i];
+        auto &frees = m_frees[i];
+        size_t numberOfKeptHandles = i == HandleSlotNormal ? m_numberOfWarmHandles : 0;
+        double expiration = 0;
+        // The least recently used handles are evicted first.
+        while (handles.size() > numberOfKeptHandles) {
+            if (frees.empty()) {
+                // The handles in use will be free later.
+                expiration = m_maxIdleDuration;
+                break;
+            }
+            double idle = now.timeIntervalSinceSteadyClock(frees.front().idleSince);
+            if (idle < m_maxIdleDuration) {
+                expiration = m_maxIdleDuration - idle;
+                break;
+            }
+            std::shared_ptr<InnerHandle> handle = frees.front().handle;
+            frees.pop_front();
+            handle->close();
+            handles.erase(handle);
+        }
+        if (expiration > 0
+            && (!nextExpiration.hasValue() || expiration < nextExpiration.value())) {
+            nextExpiration = expiration;
+        }
+    }
+    return nextExpiration;
+}
+
 } //namespace WCDB
@@ -30,6 +30,8 @@
 #include "Lock.hpp"
 #include "RecyclableHandle.hpp"
 #include "ThreadedErrors.hpp"
+#include "Time.hpp"
+#include "WCDBOptional.hpp"
 #include <array>
 #include <list>
 
@@ -81,11 +83,15 @@ public:
     void purge();
     size_t numberOfAliveHandles() const;
     size_t numberOfAliveHandlesInSlot(HandleSlot slot) const;
+    size_t numberOfActiveHandlesInSlot(HandleSlot slot) const;
     bool isAliving() const;
+    HandleCounter::PriorityWaitStatistics getHandleWaitStatistics() const;
 
 protected:
     virtual std::shared_ptr<InnerHandle> generateSlotedHandle(HandleType type) = 0;
     virtual bool willReuseSlotedHandle(HandleType type, InnerHandle *handle) = 0;
+    virtual void didGenerateSlotedHandle(HandleType type);
+    virtual void willFlowBackSlotedHandle(HandleType type, InnerHandle *handle);
     const std::set<std::shared_ptr<InnerHandle>> &getHandlesOfSlot(HandleSlot slot);
 
     mutable SharedLock m_memory;
@@ -94,9 +100,52 @@ protected:
 
 private:
     void flowBack(HandleType type, const std::shared_ptr<InnerHandle> &handle);
-    std::array<std::list<std::shared_ptr<InnerHandle>>, HandleSlotCount> m_frees;
+    struct FreeHandle {
+        FreeHandle(const std::shared_ptr<InnerHandle> &handle);
+
+        std::shared_ptr<InnerHandle> handle;
+        SteadyClock idleSince;
+    };
+    typedef struct FreeHandle FreeHandle;
+    // The most recently used handle is at the back.
+    std::array<std::list<FreeHandle>, HandleSlotCount> m_frees;
     HandleCounter m_counter;
 
+#pragma mark - Warm Handles
+public:
+    // The normal handles kept open even if they are not in use. It is at most HandlePoolMaxAllowedNumberOfWarmHandles.
+    void setNumberOfWarmHandles(int count);
+    size_t getNumberOfWarmHandles() const;
+    // Free handles idle longer than it will be closed, except the warm ones. 0 means never.
+    void setMaxIdleDurationOfHandles(double seconds);
+    double getMaxIdleDurationOfHandles() const;
+
+protected:
+    // Open the normal handles until the number of warm handles is reached.
+    bool warmUpHandles();
+    // Return the seconds until the next free handle becomes expired. NullOpt means no more handle can be evicted.
+    Optional<double> evictIdleHandles();
+
+private:
+    size_t m_numberOfWarmHandles;
+    double m_maxIdleDuration;
+
+#pragma mark - Single Writer
+public:
+    /*
+     * In single writer mode, at most one handle is used for writing at the same time,
+     * and it's the same long-lived handle unless it's purged or evicted,
+     * or it's lent to a reader since no other handle is free.
+     * The writers wait for it in the handle counter in the order of their priorities,
+     * instead of busy retrying on the write lock of sqlite.
+     */
+    void setSingleWriterEnable(bool enable);
+    bool isSingleWriterEnabled() const;
+
+private:
+    bool m_singleWriter;
+    std::weak_ptr<InnerHandle> m_writer;
+
 #pragma mark - Threaded
 private:
     struct ReferencedHandle {
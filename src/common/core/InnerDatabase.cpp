@@ -24,10 +24,13 @@
 
 #include "InnerDatabase.hpp"
 #include "Assertion.hpp"
+#include "FileHandle.hpp"
 #include "FileManager.hpp"
 #include "Notifier.hpp"
+#include "PageCache.hpp"
 #include "Path.hpp"
 #include "RepairKit.h"
+#include "Serialization.hpp"
 #include "StringView.hpp"
 #include "WCDBError.hpp"
 
@@ -37,6 +40,7 @@
 #include "IntegerityHandleOperator.hpp"
 #include "MigrateHandleOperator.hpp"
 #include "VacuumHandleOperator.hpp"
+#include "VacuumTrackConfig.hpp"
 
 #include "CompressingHandleDecorator.hpp"
 #include "MigratingHandleDecorator.hpp"
@@ -60,14 +64,18 @@ InnerDatabase::InnerDatabase(const UnsafeStringView &path)
 , m_tag(Tag::invalid())
 , m_fullSQLTrace(false)
 , m_autoCheckpoint(true)
+, m_adaptiveMMap(false)
+, m_fileSizeForMMap(-1)
 , m_factory(path)
 , m_needLoadIncremetalMaterial(false)
+, m_fullIntegrityCheckInterval(IntegrityDefaultFullCheckInterval)
 , m_migration(this)
 , m_migratedCallback(nullptr)
 , m_compression(this)
 , m_compressedCallback(nullptr)
 , m_isInMemory(false)
 , m_sharedInMemoryHandle(nullptr)
+, m_statementStatistics(false)
 , m_mergeLogic(this)
 {
     StringViewMap<Value> info;
@@ -244,6 +252,13 @@ void InnerDatabase::setAutoCheckpointEnable(bool enable)
     m_autoCheckpoint = enable;
 }
 
+void InnerDatabase::setAdaptiveMMapEnable(bool enable)
+{
+    m_adaptiveMMap = enable;
+    // The free handles should be reopened to apply the new mmap size.
+    purge();
+}
+
 #pragma mark - Handle
 RecyclableHandle InnerDatabase::getHandle(bool writeHint)
 {
@@ -364,6 +379,14 @@ bool InnerDatabase::willReuseSlotedHandle(HandleType type, InnerHandle *handle)
     return setupHandle(type, handle);
 }
 
+void InnerDatabase::willFlowBackSlotedHandle(HandleType type, InnerHandle *handle)
+{
+    HandleSlot slot = slotOfHandleType(type);
+    if (slot == HandleSlotNormal || slot == HandleSlotAutoTask) {
+        handle->governPageCache(numberOfAliveHandles());
+    }
+}
+
 bool InnerDatabase::setupHandle(HandleType type, InnerHandle *handle)
 {
     WCTAssert(handle != nullptr);
@@ -375,6 +398,7 @@ bool InnerDatabase::setupHandle(HandleType type, InnerHandle *handle)
     HandleSlot slot = slotOfHandleType(type);
     handle->enableWriteMainDB(slot == HandleSlotAutoTask || slot == HandleSlotAssemble
                               || slot == HandleSlotVacuum);
+    handle->enableAdaptiveMMap(slot == HandleSlotNormal && m_adaptiveMMap.load());
     handle->markAsCanBeSuspended(false);
     handle->markErrorAsUnignorable(99); //Clear all ignorable code
 
@@ -438,6 +462,12 @@ bool InnerDatabase::setupHandle(HandleType type, InnerHandle *handle)
                 this, DBOperationNotifier::Operation::OpenHandle, info);
             }
         }
+        handle->governPageCache(numberOfAliveHandles() + (hasOpened ? 0 : 1));
+        if (hasOpened && !handle->governMMapSize(m_fileSizeForMMap.load())) {
+            setThreadedError(handle->getError());
+            return false;
+        }
+        handle->setStatementStatisticsEnable(slot == HandleSlotNormal && m_statementStatistics);
     } else if (slot == HandleSlotCipher) {
         WCTAssert(dynamic_cast<CipherHandle *>(handle) != nullptr);
         CipherHandle *cipherHandle = static_cast<CipherHandle *>(handle);
@@ -606,6 +636,7 @@ std::list<StringView> InnerDatabase::pathsOfDatabase(const UnsafeStringView &dat
         StringView(database),
         InnerHandle::walPathOfDatabase(database),
         Repair::Factory::incrementalMaterialPathForDatabase(database),
+        Repair::Factory::integrityRecordPathForDatabase(database),
         Repair::Factory::firstMaterialPathForDatabase(database),
         Repair::Factory::lastMaterialPathForDatabase(database),
         Repair::Factory::factoryPathForDatabase(database),
@@ -620,6 +651,164 @@ void InnerDatabase::setInMemory()
     m_isInMemory = true;
 }
 
+#pragma mark - Page Cache
+Optional<PageCacheGovernor::Statistics> InnerDatabase::getPageCacheStatistics() const
+{
+    return PageCacheGovernor::shared().getStatistics(path);
+}
+
+#pragma mark - Statement Statistics
+void InnerDatabase::setStatementStatisticsEnable(bool enable)
+{
+    m_statementStatistics = enable;
+    // The free handles should be reopened to apply the new setting.
+    purge();
+}
+
+std::vector<StatementStatistics::Entry> InnerDatabase::getStatementStatistics() const
+{
+    return StatementStatistics::shared().getStatistics(path);
+}
+
+void InnerDatabase::resetStatementStatistics()
+{
+    StatementStatistics::shared().reset(path);
+}
+
+#pragma mark - Warm Handles
+void InnerDatabase::setNumberOfWarmHandles(int count)
+{
+    HandlePool::setNumberOfWarmHandles(count);
+    if (!m_isInMemory && getNumberOfWarmHandles() > 0) {
+        Core::shared().asyncWarmUpHandles(path);
+    }
+}
+
+void InnerDatabase::setMaxIdleDurationOfHandles(double seconds)
+{
+    HandlePool::setMaxIdleDurationOfHandles(seconds);
+    double maxIdleDuration = getMaxIdleDurationOfHandles();
+    if (maxIdleDuration > 0 && isOpened()) {
+        Core::shared().asyncEvictIdleHandles(path, maxIdleDuration);
+    }
+}
+
+bool InnerDatabase::warmUpHandles()
+{
+    if (m_isInMemory || m_closing > 0 || getNumberOfWarmHandles() == 0) {
+        return true;
+    }
+    InitializedGuard initializedGuard = initialize();
+    if (!initializedGuard.valid()) {
+        return false;
+    }
+    return HandlePool::warmUpHandles();
+}
+
+void InnerDatabase::didGenerateSlotedHandle(HandleType type)
+{
+    // Warm the rest up in background once the database is used again after being purged or closed.
+    if (slotOfHandleType(type) == HandleSlotNormal
+        && numberOfAliveHandlesInSlot(HandleSlotNormal) < getNumberOfWarmHandles()) {
+        Core::shared().asyncWarmUpHandles(path);
+    }
+    double maxIdleDuration = getMaxIdleDurationOfHandles();
+    if (maxIdleDuration > 0) {
+        Core::shared().asyncEvictIdleHandles(path, maxIdleDuration);
+    }
+}
+
+#pragma mark - Prewarm
+void InnerDatabase::addWarmUpStatement(const Statement &statement)
+{
+    WCTRemedialAssert(statement.getType() == Syntax::Identifier::Type::SelectSTMT,
+                      "Only select statement can be used to warm up.",
+                      return;);
+    LockGuard memoryGuard(m_memory);
+    m_warmUpStatements.push_back(statement);
+}
+
+void InnerDatabase::removeAllWarmUpStatements()
+{
+    LockGuard memoryGuard(m_memory);
+    m_warmUpStatements.clear();
+    m_prewarmBindings = NullOpt;
+}
+
+void InnerDatabase::prewarm(const OneRowValue &bindings)
+{
+    if (m_isInMemory) {
+        return;
+    }
+    {
+        LockGuard memoryGuard(m_memory);
+        if (m_warmUpStatements.empty()) {
+            return;
+        }
+        // Only the latest bindings are kept since the former ones are outdated.
+        m_prewarmBindings = bindings;
+    }
+    Core::shared().asyncPrewarm(path);
+}
+
+bool InnerDatabase::prewarmPages()
+{
+    std::list<Statement> statements;
+    OneRowValue bindings;
+    {
+        LockGuard memoryGuard(m_memory);
+        if (!m_prewarmBindings.hasValue()) {
+            return true;
+        }
+        bindings = std::move(m_prewarmBindings.value());
+        m_prewarmBindings = NullOpt;
+        statements = m_warmUpStatements;
+    }
+    if (statements.empty() || m_closing > 0) {
+        return true;
+    }
+    InitializedGuard initializedGuard = initialize();
+    if (!initializedGuard.valid()) {
+        return false;
+    }
+    // Prewarming gives way to the other threads that are waiting for handles.
+    HandlePriority priority = HandleCounter::getThreadedPriority();
+    HandleCounter::setThreadedPriority(HandlePriority::Background);
+    // A normal handle is used so that the pages are also cached by the handle which is likely to run the anticipated queries.
+    RecyclableHandle handle = getHandle(false);
+    if (handle == nullptr) {
+        HandleCounter::setThreadedPriority(priority);
+        return false;
+    }
+    bool succeed = true;
+    HandleStatement *handleStatement = handle->getStatement();
+    for (const auto &statement : statements) {
+        if (!handleStatement->prepare(statement)) {
+            succeed = false;
+            continue;
+        }
+        int numberOfBindings
+        = std::min<int>(handleStatement->getBindParameterCount(), (int) bindings.size());
+        for (int i = 0; i < numberOfBindings; ++i) {
+            handleStatement->bindValue(bindings[i], i + 1);
+        }
+        // The rows are discarded. Stepping over them is enough to load their pages into the caches.
+        while (m_closing == 0 && !handleStatement->done()) {
+            if (!handleStatement->step()) {
+                succeed = false;
+                break;
+            }
+        }
+        handleStatement->finalize();
+        if (m_closing > 0) {
+            break;
+        }
+    }
+    handle->returnStatement(handleStatement);
+    HandleCounter::setThreadedPriority(priority);
+    return succeed;
+}
+
 #pragma mark - Repair
 
 void InnerDatabase::markNeedLoadIncremetalMaterial()
@@ -913,12 +1102,23 @@ double InnerDatabase::retrieve(const ProgressCallback &onProgressUpdated)
 }
 
 bool InnerDatabase::vacuum(const ProgressCallback &onProgressUpdated)
+{
+    return doVacuum(onProgressUpdated, 0).succeed();
+}
+
+Optional<bool> InnerDatabase::stepVacuum(double timeSlice)
+{
+    WCTAssert(timeSlice > 0);
+    return doVacuum(nullptr, timeSlice);
+}
+
+Optional<bool> InnerDatabase::doVacuum(const ProgressCallback &onProgressUpdated, double timeSlice)
 {
     if (m_isInMemory) {
         return true;
     }
-    bool result = false;
-    close([&result, &onProgressUpdated, this]() {
+    Optional<bool> done;
+    close([&done, &onProgressUpdated, timeSlice, this]() {
         InitializedGuard initializedGuard = initialize();
         if (!initializedGuard.valid()) {
             return;
@@ -935,20 +1135,66 @@ bool InnerDatabase::vacuum(const ProgressCallback &onProgressUpdated)
         VacuumHandleOperator vacuumOperator(vacuumHandle.get());
         vacuummer.setVacuumDelegate(&vacuumOperator);
         vacuummer.setProgressCallback(onProgressUpdated);
+        vacuumOperator.setTimeSlice(timeSlice);
+        vacuumOperator.setWorkerHandleGenerator(
+        [this]() { return generateSlotedHandle(HandleType::Vacuum); }, VacuumMaxNumberOfWorkers);
+        if (m_vacuumTrack != nullptr) {
+            auto modifiedTables = m_vacuumTrack->getModifiedTables();
+            if (modifiedTables.succeed()) {
+                vacuummer.setModifiedTables(modifiedTables.value());
+            }
+        }
 
         if (!vacuummer.prepare()) {
             setThreadedError(vacuummer.getError());
             Core::shared().setThreadedErrorPath("");
+            trackVacuum(vacuummer.isResumable());
             return;
         }
 
-        if (!vacuummer.work()) {
-            setThreadedError(vacuummer.getError());
+        if (vacuumOperator.isPaused()) {
             Core::shared().setThreadedErrorPath("");
+            trackVacuum(vacuummer.isResumable());
+            done = false;
             return;
         }
+
+        bool succeed = vacuummer.work();
         Core::shared().setThreadedErrorPath("");
-        result = true;
+        trackVacuum(!succeed && vacuummer.isResumable());
+        if (!succeed) {
+            setThreadedError(vacuummer.getError());
+            return;
+        }
+        done = true;
+    });
+    return done;
+}
+
+void InnerDatabase::trackVacuum(bool resumable)
+{
+    // It's called while all handles are closed, so that no write is missed.
+    if (resumable) {
+        if (m_vacuumTrack == nullptr) {
+            m_vacuumTrack = std::make_shared<VacuumTrackConfig>(path);
+            setConfig(VacuumTrackConfigName, m_vacuumTrack, Configs::Priority::Low);
+        }
+        m_vacuumTrack->reset();
+    } else if (m_vacuumTrack != nullptr) {
+        removeConfig(VacuumTrackConfigName);
+        m_vacuumTrack = nullptr;
+    }
+}
+
+bool InnerDatabase::discardVacuum()
+{
+    bool result = false;
+    close([&result, this]() {
+        trackVacuum(false);
+        result = m_factory.vacuumer().discard();
+        if (!result) {
+            assignWithSharedThreadedError();
+        }
     });
     return result;
 }
@@ -988,6 +1234,132 @@ void InnerDatabase::checkIntegrity(bool interruptible)
     }
 }
 
+void InnerDatabase::setFullIntegrityCheckInterval(double interval)
+{
+    LockGuard memoryGuard(m_memory);
+    m_fullIntegrityCheckInterval = interval;
+}
+
+void InnerDatabase::checkIntegrityIncrementally(bool interruptible)
+{
+    if (m_isInMemory) {
+        return;
+    }
+    InitializedGuard initializedGuard = initialize();
+    if (!initializedGuard.valid()) {
+        return; // mark as succeed if it's not an auto initialize action.
+    }
+
+    double fullCheckInterval = 0;
+    {
+        SharedLockGuard memoryGuard(m_memory);
+        fullCheckInterval = m_fullIntegrityCheckInterval;
+    }
+    uint64_t now = (uint64_t) Time::now().seconds();
+    auto lastFullCheckTime = loadLastFullIntegrityCheckTime();
+    // A database that has never been fully checked is overdue, so does the one whose record is in the future.
+    bool needFullCheck = !lastFullCheckTime.succeed() || lastFullCheckTime.value() == 0
+                         || lastFullCheckTime.value() > now
+                         || now - lastFullCheckTime.value() >= fullCheckInterval;
+    Core::IntegrityPages pages;
+    if (!Core::shared().takeUncheckedIntegrityPages(getPath(), pages)) {
+        needFullCheck = true;
+    }
+    if (!needFullCheck && pages.empty()) {
+        return;
+    }
+
+    RecyclableHandle handle = flowOut(HandleType::IntegrityCheck);
+    if (handle == nullptr) {
+        Core::shared().restoreUncheckedIntegrityPages(getPath(), pages);
+        return;
+    }
+    IntegerityHandleOperator &integerityOperator
+    = handle.getDecorative()->getOrCreateOperator<IntegerityHandleOperator>(OperatorCheckIntegrity);
+    if (interruptible) {
+        if (checkShouldInterruptWhenClosing(ErrorTypeIntegrity)) {
+            Core::shared().restoreUncheckedIntegrityPages(getPath(), pages);
+            return;
+        }
+        handle->markAsCanBeSuspended(true);
+    }
+
+    SteadyClock start = SteadyClock::now();
+    size_t numberOfPages = pages.size();
+    if (!needFullCheck) {
+        RecyclableHandle cipherHandle = flowOut(HandleType::BackupCipher);
+        if (cipherHandle == nullptr) {
+            Core::shared().restoreUncheckedIntegrityPages(getPath(), pages);
+            return;
+        }
+        WCTAssert(dynamic_cast<CipherHandle *>(cipherHandle.get()) != nullptr);
+        auto passed = integerityOperator.checkPagesIntegrity(
+        pages, static_cast<CipherHandle *>(cipherHandle.get()));
+        Core::shared().restoreUncheckedIntegrityPages(getPath(), pages);
+        if (!passed.hasValue()) {
+            return;
+        }
+        // The parser may be misled by the pages being checkpointed concurrently,
+        // so that the suspected corruption should be confirmed by a full check.
+        needFullCheck = !passed.value();
+    }
+    if (needFullCheck) {
+        integerityOperator.checkIntegrity();
+        if (handle->isSuspended()) {
+            return;
+        }
+        saveLastFullIntegrityCheckTime((uint64_t) Time::now().seconds());
+    }
+
+    Error error(Error::Code::Notice, Error::Level::Notice, "Integrity check finished.");
+    error.infos.insert_or_assign(ErrorStringKeyPath, getPath());
+    error.infos.insert_or_assign(ErrorStringKeyType, ErrorTypeIntegrity);
+    error.infos.insert_or_assign("Mode", needFullCheck ? "Full" : "Incremental");
+    error.infos.insert_or_assign("PageCount", numberOfPages);
+    error.infos.insert_or_assign("Cost", SteadyClock::timeIntervalSinceSteadyClockToNow(start));
+    Notifier::shared().notify(error);
+}
+
+Optional<uint64_t> InnerDatabase::loadLastFullIntegrityCheckTime() const
+{
+    StringView recordPath = Repair::Factory::integrityRecordPathForDatabase(path);
+    auto exists = FileManager::fileExists(recordPath);
+    if (!exists.succeed()) {
+        return NullOpt;
+    }
+    if (!exists.value()) {
+        return 0;
+    }
+    FileHandle fileHandle(recordPath);
+    if (!fileHandle.open(FileHandle::Mode::ReadOnly)) {
+        return NullOpt;
+    }
+    Data data = fileHandle.mapOrReadAllData();
+    fileHandle.close();
+    Deserialization deserialization(data);
+    if (!deserialization.canAdvance(sizeof(uint64_t))) {
+        // The record is broken, which is treated as never checked.
+        return 0;
+    }
+    return (uint64_t) deserialization.advance8BytesInt();
+}
+
+void InnerDatabase::saveLastFullIntegrityCheckTime(uint64_t time) const
+{
+    Serialization serialization;
+    if (!serialization.expand(sizeof(uint64_t)) || !serialization.put8BytesUInt(time)) {
+        return;
+    }
+    StringView recordPath = Repair::Factory::integrityRecordPathForDatabase(path);
+    FileHandle fileHandle(recordPath);
+    if (!fileHandle.open(FileHandle::Mode::OverWrite)) {
+        return;
+    }
+    fileHandle.write(serialization.finalize());
+    fileHandle.close();
+    FileManager::setFileProtectionCompleteUntilFirstUserAuthenticationIfNeeded(recordPath);
+}
+
 #pragma mark - Migration
 Optional<bool> InnerDatabase::stepMigration(bool interruptible)
 {
@@ -1173,6 +1545,18 @@ bool InnerDatabase::checkpoint(bool interruptible, CheckPointMode mode)
         tryLoadIncremetalMaterial();
         handle->markErrorAsIgnorable(Error::Code::Busy);
         succeed = handle->checkpoint(mode);
+        // Pages written back to the database file are no longer the same as the cached ones.
+        Repair::PageCache &pageCache = Repair::PageCache::shared();
+        if (pageCache.containsPages(path)) {
+            pageCache.invalidate(path);
+        }
+        // The database file may grow across a step of the adaptive mmap size.
+        if (m_adaptiveMMap.load()) {
+            auto fileSize = FileManager::getFileSize(path);
+            if (fileSize.hasValue()) {
+                m_fileSizeForMMap.store(fileSize.value());
+            }
+        }
         if (!succeed && handle->getError().isIgnorable()) {
             succeed = true;
         }
@@ -1211,4 +1595,19 @@ RecyclableHandle InnerDatabase::getMergeIndexHandle()
     return flowOut(HandleType::MergeIndex);
 }
 
+bool InnerDatabase::hasForegroundActivity() const
+{
+    return numberOfActiveHandlesInSlot(HandleSlotNormal) > 0;
+}
+
+void InnerDatabase::setMergeFTSIndexBudget(double maxDuration, int maxPages)
+{
+    m_mergeLogic.setBudget(maxDuration, maxPages);
+}
+
+InnerDatabase::MergeFTSIndexStatistics InnerDatabase::getMergeFTSIndexStatistics() const
+{
+    return m_mergeLogic.getStatistics();
+}
+
 } //namespace WCDB
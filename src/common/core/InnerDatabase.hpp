@@ -30,6 +30,8 @@
 #include "HandlePool.hpp"
 #include "MergeFTSIndexLogic.hpp"
 #include "Migration.hpp"
+#include "PageCacheGovernor.hpp"
+#include "StatementStatistics.hpp"
 #include "Tag.hpp"
 #include "ThreadLocal.hpp"
 #include "TransactionGuard.hpp"
@@ -38,6 +40,7 @@
 namespace WCDB {
 
 class BaseOperation;
+class VacuumTrackConfig;
 
 // TODO: readonly manually - by removing basic config and adding query_only config?
 // TODO: support authorize
@@ -75,6 +78,7 @@ public:
     using HandlePool::unblockade;
     using HandlePool::isBlockaded;
     using HandlePool::numberOfAliveHandles;
+    using HandlePool::getHandleWaitStatistics;
 
 protected:
     Tag m_tag;
@@ -93,6 +97,7 @@ public:
 protected:
     std::shared_ptr<InnerHandle> generateSlotedHandle(HandleType type) override final;
     bool willReuseSlotedHandle(HandleType type, InnerHandle *handle) override final;
+    void willFlowBackSlotedHandle(HandleType type, InnerHandle *handle) override final;
 
 private:
     bool setupHandle(HandleType type, InnerHandle *handle);
@@ -106,11 +111,16 @@ public:
     void removeConfig(const UnsafeStringView &name);
     void setFullSQLTraceEnable(bool enable);
     void setAutoCheckpointEnable(bool enable);
+    void setAdaptiveMMapEnable(bool enable);
+    using HandlePool::setSingleWriterEnable;
 
 private:
     Configs m_configs;
     bool m_fullSQLTrace = false;
     bool m_autoCheckpoint;
+    std::atomic<bool> m_adaptiveMMap;
+    // The size of database file, which is only changed by checkpoint in WAL mode. -1 for unknown.
+    std::atomic<int64_t> m_fileSizeForMMap;
 
 #pragma mark - Threaded
 private:
@@ -158,12 +168,28 @@ public:
     typedef Progress::ProgressUpdateCallback ProgressCallback;
     double retrieve(const ProgressCallback &onProgressUpdated);
     bool vacuum(const ProgressCallback &onProgressUpdated);
+    // Vacuum for a time slice and resume from the checkpoint next time. The returned value is true if vacuum is finished.
+    Optional<bool> stepVacuum(double timeSlice);
+    // Remove the unfinished vacuum.
+    bool discardVacuum();
 
     void checkIntegrity(bool interruptible);
+    void checkIntegrityIncrementally(bool interruptible);
+    void setFullIntegrityCheckInterval(double interval);
 
 private:
+    Optional<bool> doVacuum(const ProgressCallback &onProgressUpdated, double timeSlice);
+    void trackVacuum(bool resumable);
+
     Repair::Factory m_factory;
+    // Tracks the writes between the time slices of vacuum.
+    std::shared_ptr<VacuumTrackConfig> m_vacuumTrack;
     bool m_needLoadIncremetalMaterial;
+    // The time of the last full integrity check is persisted, so that it's not reset by relaunching.
+    // It's 0 if the database has never been fully checked.
+    Optional<uint64_t> loadLastFullIntegrityCheckTime() const;
+    void saveLastFullIntegrityCheckTime(uint64_t time) const;
+    double m_fullIntegrityCheckInterval;
 
 #pragma mark - Migration
 public:
@@ -221,6 +247,41 @@ private:
     bool m_isInMemory;
     std::shared_ptr<InnerHandle> m_sharedInMemoryHandle;
 
+#pragma mark - Page Cache
+public:
+    Optional<PageCacheGovernor::Statistics> getPageCacheStatistics() const;
+
+#pragma mark - Statement Statistics
+public:
+    void setStatementStatisticsEnable(bool enable);
+    std::vector<StatementStatistics::Entry> getStatementStatistics() const;
+    void resetStatementStatistics();
+
+private:
+    std::atomic<bool> m_statementStatistics;
+
+#pragma mark - Warm Handles
+public:
+    void setNumberOfWarmHandles(int count);
+    void setMaxIdleDurationOfHandles(double seconds);
+    bool warmUpHandles();
+    using HandlePool::evictIdleHandles;
+
+protected:
+    void didGenerateSlotedHandle(HandleType type) override final;
+
+#pragma mark - Prewarm
+public:
+    void addWarmUpStatement(const Statement &statement);
+    void removeAllWarmUpStatements();
+    // The bindings are bound to the parameters of each warm-up statement in order.
+    void prewarm(const OneRowValue &bindings);
+    bool prewarmPages();
+
+private:
+    std::list<Statement> m_warmUpStatements;
+    Optional<OneRowValue> m_prewarmBindings;
+
 #pragma mark - Error
 public:
     using HandlePool::getThreadedError;
@@ -231,6 +292,10 @@ public:
     Optional<bool> mergeFTSIndex(TableArray newTables, TableArray modifiedTables);
     void proccessMerge();
     RecyclableHandle getMergeIndexHandle() override final;
+    bool hasForegroundActivity() const override final;
+    void setMergeFTSIndexBudget(double maxDuration, int maxPages);
+    using MergeFTSIndexStatistics = StringViewMap<MergeFTSIndexLogic::TableStatistics>;
+    MergeFTSIndexStatistics getMergeFTSIndexStatistics() const;
 
 private:
     MergeFTSIndexLogic m_mergeLogic;
@@ -24,9 +24,12 @@
 
 #include "InnerHandle.hpp"
 #include "Assertion.hpp"
+#include "BasicConfig.hpp"
 #include "BusyRetryConfig.hpp"
 #include "CipherConfig.hpp"
 #include "CoreConst.h"
+#include "PageCacheGovernor.hpp"
+#include <cmath>
 
 namespace WCDB {
 
@@ -35,6 +38,10 @@ InnerHandle::InnerHandle()
 , m_writeHint(false)
 , m_mainStatement(nullptr)
 , m_transactionEvent(nullptr)
+, m_reportedCacheUsed(0)
+, m_cacheSizeLimit(0)
+, m_mmapSize(0)
+, m_defaultMMapSize(0)
 {
     m_mainStatement = getStatement();
 }
@@ -111,6 +118,8 @@ void InnerHandle::close()
             last.value()->uninvoke(this); // ignore errors
             m_invokeds.pop_back();
         }
+        resetPageCacheUsage();
+        m_mmapSize = 0;
     }
     AbstractHandle::close();
 }
@@ -451,4 +460,86 @@ void InnerHandle::configTransactionEvent(TransactionEvent *event)
 
 ConfiguredHandle::~ConfiguredHandle() = default;
 
+#pragma mark - Page Cache
+void InnerHandle::governPageCache(size_t numberOfHandlesOfDatabase)
+{
+    PageCacheGovernor &governor = PageCacheGovernor::shared();
+    if (!isOpened()
+        || (!governor.isEnabled() && m_reportedCacheUsed == 0 && m_cacheSizeLimit == 0)) {
+        return;
+    }
+
+    int cacheUsed, hits, misses;
+    if (getCacheStatus(cacheUsed, hits, misses)) {
+        governor.report(getPath(), cacheUsed - m_reportedCacheUsed, hits, misses);
+        m_reportedCacheUsed = cacheUsed;
+    }
+
+    int64_t limit = governor.getLimitPerHandle(getPath(), numberOfHandlesOfDatabase);
+    if (limit != m_cacheSizeLimit
+        && (limit == 0 || m_cacheSizeLimit == 0
+            || std::abs(limit - m_cacheSizeLimit)
+               > m_cacheSizeLimit * PageCacheGovernorToleranceOfCacheSizeChange)) {
+        if (setCacheSizeLimit(limit)) {
+            m_cacheSizeLimit = limit;
+        }
+    }
+
+    if (!isInTransaction() && governor.isOverBudget()) {
+        releaseCacheMemory();
+        if (getCacheStatus(cacheUsed, hits, misses)) {
+            governor.report(getPath(), cacheUsed - m_reportedCacheUsed, hits, misses);
+            m_reportedCacheUsed = cacheUsed;
+        }
+    }
+}
+
+void InnerHandle::resetPageCacheUsage()
+{
+    if (m_reportedCacheUsed != 0) {
+        PageCacheGovernor::shared().report(getPath(), -m_reportedCacheUsed, 0, 0);
+        m_reportedCacheUsed = 0;
+    }
+    m_cacheSizeLimit = 0;
+}
+
+#pragma mark - MMap
+bool InnerHandle::governMMapSize(int64_t fileSize)
+{
+    int64_t mmapSize = 0;
+    // The pages of cipher database must be decrypted into page cache, so mmap doesn't help.
+    if (isAdaptiveMMapEnabled() && !hasCipher()) {
+        if (fileSize < 0) {
+            return true;
+        }
+        mmapSize = BasicConfig::adaptiveMMapSize(fileSize);
+    }
+    if (mmapSize == m_mmapSize) {
+        return true;
+    }
+    // It will be applied next time the handle is flowed out.
+    if (isInTransaction()) {
+        return true;
+    }
+    if (m_mmapSize == 0) {
+        // Remember the configured one, which is restored after adaptive mmap is disabled.
+        if (!prepare(StatementPragma().pragma(Pragma::mmapSize()))) {
+            return false;
+        }
+        bool succeed = step();
+        m_defaultMMapSize = succeed && !done() ? getInteger(0) : 0;
+        finalize();
+        if (!succeed) {
+            return false;
+        }
+    }
+    if (!execute(StatementPragma()
+                 .pragma(Pragma::mmapSize())
+                 .to(mmapSize != 0 ? mmapSize : m_defaultMMapSize))) {
+        return false;
+    }
+    m_mmapSize = mmapSize;
+    return true;
+}
+
 } //namespace WCDB
@@ -137,6 +137,27 @@ public:
 
 private:
     TransactionEvent *m_transactionEvent;
+
+#pragma mark - Page Cache
+public:
+    // Report the page cache usage to the governor and apply the cache size limit from it.
+    void governPageCache(size_t numberOfHandlesOfDatabase);
+
+private:
+    void resetPageCacheUsage();
+    int m_reportedCacheUsed;
+    int64_t m_cacheSizeLimit;
+
+#pragma mark - MMap
+public:
+    // Apply the adaptive mmap size again if the file size crosses a step of it.
+    // The configured mmap size is restored if adaptive mmap is disabled.
+    bool governMMapSize(int64_t fileSize);
+
+private:
+    // 0 if the configured mmap size is in use.
+    int64_t m_mmapSize;
+    int64_t m_defaultMMapSize;
 };
 
 class ConfiguredHandle final : public InnerHandle {
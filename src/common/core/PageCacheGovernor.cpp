@@ -0,0 +1,139 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PageCacheGovernor.hpp"
+#include "CoreConst.h"
+#include <algorithm>
+#include <cmath>
+
+namespace WCDB {
+
+PageCacheGovernor::PageCacheGovernor() : m_budget(0), m_totalCacheUsed(0)
+{
+}
+
+PageCacheGovernor::~PageCacheGovernor() = default;
+
+PageCacheGovernor &PageCacheGovernor::shared()
+{
+    static PageCacheGovernor *s_governor = new PageCacheGovernor;
+    return *s_governor;
+}
+
+void PageCacheGovernor::setBudget(int64_t bytes)
+{
+    m_budget = std::max<int64_t>(bytes, 0);
+}
+
+int64_t PageCacheGovernor::getBudget() const
+{
+    return m_budget;
+}
+
+bool PageCacheGovernor::isEnabled() const
+{
+    return m_budget > 0;
+}
+
+bool PageCacheGovernor::isOverBudget() const
+{
+    int64_t budget = m_budget;
+    return budget > 0 && m_totalCacheUsed > budget;
+}
+
+void PageCacheGovernor::report(const UnsafeStringView &path, int64_t cacheUsedDelta, int hits, int misses)
+{
+    m_totalCacheUsed += cacheUsedDelta;
+
+    LockGuard lockGuard(m_lock);
+    Activity &activity = m_activities[path];
+    activity.decay(SteadyClock::now());
+    activity.recentLookups += hits + misses;
+    activity.recentHits += hits;
+    activity.statistics.cacheUsed += cacheUsedDelta;
+    activity.statistics.hits += hits;
+    activity.statistics.misses += misses;
+}
+
+int64_t PageCacheGovernor::getLimitPerHandle(const UnsafeStringView &path, size_t numberOfHandles)
+{
+    int64_t budget = m_budget;
+    if (budget <= 0) {
+        return 0;
+    }
+
+    LockGuard lockGuard(m_lock);
+    SteadyClock now = SteadyClock::now();
+    double totalWeight = 0;
+    for (auto &iter : m_activities) {
+        iter.second.decay(now);
+        totalWeight += iter.second.weight();
+    }
+    Activity &activity = m_activities[path];
+    double share = totalWeight > 0 ? activity.weight() / totalWeight :
+                                     1.0 / m_activities.size();
+    int64_t limit = (int64_t) (budget * share / std::max<size_t>(numberOfHandles, 1));
+    limit = std::max(limit, PageCacheGovernorMinCacheSizePerHandle);
+    limit = std::min(limit, budget);
+    activity.statistics.limitPerHandle = limit;
+    return limit;
+}
+
+Optional<PageCacheGovernor::Statistics>
+PageCacheGovernor::getStatistics(const UnsafeStringView &path) const
+{
+    SharedLockGuard lockGuard(m_lock);
+    auto iter = m_activities.find(path);
+    if (iter == m_activities.end()) {
+        return NullOpt;
+    }
+    return iter->second.statistics;
+}
+
+PageCacheGovernor::Statistics::Statistics()
+: cacheUsed(0), hits(0), misses(0), limitPerHandle(0)
+{
+}
+
+PageCacheGovernor::Activity::Activity()
+: recentLookups(0), recentHits(0), lastDecay(SteadyClock::now())
+{
+}
+
+void PageCacheGovernor::Activity::decay(const SteadyClock &now)
+{
+    double factor = std::pow(
+    0.5, now.timeIntervalSinceSteadyClock(lastDecay) / PageCacheGovernorHalfLifeOfActivity);
+    recentLookups *= factor;
+    recentHits *= factor;
+    lastDecay = now;
+}
+
+double PageCacheGovernor::Activity::weight() const
+{
+    // The lookups weigh the volume, and the hits favor the databases whose cache is effective.
+    return (recentLookups + recentHits) / 2;
+}
+
+} // namespace WCDB
@@ -0,0 +1,91 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Lock.hpp"
+#include "StringView.hpp"
+#include "Time.hpp"
+#include "WCDBOptional.hpp"
+#include <atomic>
+
+namespace WCDB {
+
+/*
+ * Page cache governor distributes a process-wide page cache budget across all handles.
+ * Each database gets a share of the budget weighted by its recent page cache lookups and hits,
+ * and the share is divided equally by the handles of the database.
+ * The activities decay with a half-life of PageCacheGovernorHalfLifeOfActivity seconds.
+ */
+class PageCacheGovernor final {
+public:
+    PageCacheGovernor();
+    ~PageCacheGovernor();
+    PageCacheGovernor(const PageCacheGovernor &) = delete;
+    PageCacheGovernor &operator=(const PageCacheGovernor &) = delete;
+
+    static PageCacheGovernor &shared();
+
+    // 0 to disable the governor.
+    void setBudget(int64_t bytes);
+    int64_t getBudget() const;
+    bool isEnabled() const;
+    bool isOverBudget() const;
+
+    void report(const UnsafeStringView &path, int64_t cacheUsedDelta, int hits, int misses);
+    // The cache size limit in bytes of each handle of the database. 0 means sqlite default.
+    int64_t getLimitPerHandle(const UnsafeStringView &path, size_t numberOfHandles);
+
+    struct Statistics {
+        Statistics();
+
+        int64_t cacheUsed;
+        int64_t hits;
+        int64_t misses;
+        int64_t limitPerHandle;
+    };
+    typedef struct Statistics Statistics;
+    Optional<Statistics> getStatistics(const UnsafeStringView &path) const;
+
+private:
+    struct Activity {
+        Activity();
+
+        Statistics statistics;
+        double recentLookups;
+        double recentHits;
+        SteadyClock lastDecay;
+
+        void decay(const SteadyClock &now);
+        double weight() const;
+    };
+    typedef struct Activity Activity;
+
+    mutable SharedLock m_lock;
+    std::atomic<int64_t> m_budget;
+    std::atomic<int64_t> m_totalCacheUsed;
+    StringViewMap<Activity> m_activities;
+};
+
+} // namespace WCDB
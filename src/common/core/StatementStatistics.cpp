@@ -0,0 +1,230 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StatementStatistics.hpp"
+#include "Assertion.hpp"
+#include "SyntaxExpression.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace WCDB {
+
+StatementStatistics::StatementStatistics() = default;
+
+StatementStatistics::~StatementStatistics() = default;
+
+StatementStatistics &StatementStatistics::shared()
+{
+    static StatementStatistics *s_statistics = new StatementStatistics;
+    return *s_statistics;
+}
+
+StringView StatementStatistics::fingerprint(const Statement &statement)
+{
+    // The syntax tree is shared by copies until it is modified.
+    Statement shape = statement;
+    shape.iterate([](Syntax::Identifier &identifier, bool isBegin, bool &) {
+        if (!isBegin || identifier.getType() != Syntax::Identifier::Type::Expression) {
+            return;
+        }
+        Syntax::Expression &expression = static_cast<Syntax::Expression &>(identifier);
+        if (expression.switcher != Syntax::Expression::Switch::LiteralValue) {
+            return;
+        }
+        switch (expression.literalValue().switcher) {
+        case Syntax::LiteralValue::Switch::StringView:
+        case Syntax::LiteralValue::Switch::Float:
+        case Syntax::LiteralValue::Switch::Integer:
+        case Syntax::LiteralValue::Switch::UnsignedInteger:
+        case Syntax::LiteralValue::Switch::Bool: {
+            expression.switcher = Syntax::Expression::Switch::BindParameter;
+            Syntax::BindParameter &bindParameter = expression.bindParameter();
+            bindParameter.switcher = Syntax::BindParameter::Switch::QuestionSign;
+            bindParameter.n = 0;
+        } break;
+        default:
+            // NULL and the current time keywords are part of the shape.
+            break;
+        }
+    });
+    return shape.getDescription();
+}
+
+void StatementStatistics::record(const UnsafeStringView &path,
+                                 const UnsafeStringView &fingerprint,
+                                 int64_t costInNanoseconds,
+                                 int64_t pagesRead,
+                                 int64_t pagesWritten,
+                                 int64_t rowsReturned)
+{
+    LockGuard lockGuard(m_lock);
+    Aggregates &aggregates = m_aggregates[path];
+    auto iter = aggregates.find(fingerprint);
+    if (iter == aggregates.end()) {
+        Aggregate newAggregate;
+        if (aggregates.size() >= StatementStatisticsMaxNumberOfShapesPerDatabase) {
+            auto cheapest = std::min_element(
+            aggregates.begin(), aggregates.end(), [](const auto &left, const auto &right) {
+                return left.second.totalCostInNanoseconds
+                       < right.second.totalCostInNanoseconds;
+            });
+            WCTAssert(cheapest != aggregates.end());
+            // Space-saving: the new shape inherits the cost of the evicted one,
+            // so that it's not evicted by the next new shape before building up its own history.
+            newAggregate.totalCostInNanoseconds = cheapest->second.totalCostInNanoseconds;
+            newAggregate.inheritedCostInNanoseconds
+            = cheapest->second.totalCostInNanoseconds;
+            aggregates.erase(cheapest);
+        }
+        iter = aggregates.emplace(fingerprint, std::move(newAggregate)).first;
+    }
+    Aggregate &aggregate = iter->second;
+    ++aggregate.numberOfCalls;
+    aggregate.totalCostInNanoseconds += costInNanoseconds;
+    aggregate.pagesRead += pagesRead;
+    aggregate.pagesWritten += pagesWritten;
+    aggregate.rowsReturned += rowsReturned;
+    aggregate.histogram.record(costInNanoseconds / 1000);
+}
+
+std::vector<StatementStatistics::Entry>
+StatementStatistics::getStatistics(const UnsafeStringView &path) const
+{
+    std::vector<Entry> entries;
+    {
+        SharedLockGuard lockGuard(m_lock);
+        auto iter = m_aggregates.find(path);
+        if (iter == m_aggregates.end()) {
+            return entries;
+        }
+        entries.reserve(iter->second.size());
+        for (const auto &element : iter->second) {
+            const Aggregate &aggregate = element.second;
+            Entry entry;
+            entry.fingerprint = element.first;
+            entry.numberOfCalls = aggregate.numberOfCalls;
+            entry.totalCostInNanoseconds = aggregate.totalCostInNanoseconds;
+            entry.inheritedCostInNanoseconds = aggregate.inheritedCostInNanoseconds;
+            entry.p50CostInNanoseconds
+            = aggregate.histogram.percentile(0.50, aggregate.numberOfCalls) * 1000;
+            entry.p95CostInNanoseconds
+            = aggregate.histogram.percentile(0.95, aggregate.numberOfCalls) * 1000;
+            entry.p99CostInNanoseconds
+            = aggregate.histogram.percentile(0.99, aggregate.numberOfCalls) * 1000;
+            entry.pagesRead = aggregate.pagesRead;
+            entry.pagesWritten = aggregate.pagesWritten;
+            entry.rowsReturned = aggregate.rowsReturned;
+            entries.push_back(std::move(entry));
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry &left, const Entry &right) {
+        return left.totalCostInNanoseconds > right.totalCostInNanoseconds;
+    });
+    return entries;
+}
+
+void StatementStatistics::reset(const UnsafeStringView &path)
+{
+    LockGuard lockGuard(m_lock);
+    m_aggregates.erase(path);
+}
+
+StatementStatistics::Entry::Entry()
+: numberOfCalls(0)
+, totalCostInNanoseconds(0)
+, inheritedCostInNanoseconds(0)
+, p50CostInNanoseconds(0)
+, p95CostInNanoseconds(0)
+, p99CostInNanoseconds(0)
+, pagesRead(0)
+, pagesWritten(0)
+, rowsReturned(0)
+{
+}
+
+StatementStatistics::Aggregate::Aggregate()
+: numberOfCalls(0)
+, totalCostInNanoseconds(0)
+, inheritedCostInNanoseconds(0)
+, pagesRead(0)
+, pagesWritten(0)
+, rowsReturned(0)
+{
+}
+
+#pragma mark - Histogram
+StatementStatistics::Histogram::Histogram()
+{
+    m_counts.fill(0);
+}
+
+int StatementStatistics::Histogram::bucketOfValue(int64_t microseconds)
+{
+    uint64_t value = (uint64_t) std::max<int64_t>(microseconds, 0);
+    value = std::min<uint64_t>(value, (1ULL << StatementStatisticsHistogramMaxBits) - 1);
+    if (value < NumberOfSubBuckets) {
+        return (int) value;
+    }
+    int exponent = SubBucketBits;
+    while ((value >> (exponent + 1)) != 0) {
+        ++exponent;
+    }
+    int subBucket = (int) (value >> (exponent - SubBucketBits)) - NumberOfSubBuckets;
+    return (exponent - SubBucketBits + 1) * NumberOfSubBuckets + subBucket;
+}
+
+int64_t StatementStatistics::Histogram::valueOfBucket(int bucket)
+{
+    if (bucket < NumberOfSubBuckets) {
+        return bucket;
+    }
+    int exponent = bucket / NumberOfSubBuckets + SubBucketBits - 1;
+    int subBucket = bucket % NumberOfSubBuckets;
+    int64_t width = 1LL << (exponent - SubBucketBits);
+    // The middle of the bucket.
+    return (NumberOfSubBuckets + subBucket) * width + width / 2;
+}
+
+void StatementStatistics::Histogram::record(int64_t microseconds)
+{
+    ++m_counts[bucketOfValue(microseconds)];
+}
+
+int64_t StatementStatistics::Histogram::percentile(double percentage, int64_t numberOfValues) const
+{
+    if (numberOfValues <= 0) {
+        return 0;
+    }
+    int64_t rank = std::max<int64_t>((int64_t) std::ceil(percentage * numberOfValues), 1);
+    int64_t count = 0;
+    for (int bucket = 0; bucket < NumberOfBuckets; ++bucket) {
+        count += m_counts[bucket];
+        if (count >= rank) {
+            return valueOfBucket(bucket);
+        }
+    }
+    return valueOfBucket(NumberOfBuckets - 1);
+}
+
+} // namespace WCDB
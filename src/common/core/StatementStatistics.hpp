@@ -0,0 +1,126 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "CoreConst.h"
+#include "Lock.hpp"
+#include "Statement.hpp"
+#include "StringView.hpp"
+#include <array>
+#include <vector>
+
+namespace WCDB {
+
+/*
+ * Statement statistics aggregate the executions of each database by statement shape.
+ * The shape of a statement is its fingerprint, the SQL with all literal values replaced by `?`,
+ * so that `SELECT * FROM t WHERE id = 1` and `SELECT * FROM t WHERE id = 2` are counted together.
+ * At most StatementStatisticsMaxNumberOfShapesPerDatabase shapes are kept for each database.
+ * When it's full, the shape with the least total cost is evicted with the space-saving algorithm,
+ * which means the new shape inherits its total cost as an upper bound of the overestimation.
+ */
+class StatementStatistics final {
+public:
+    StatementStatistics();
+    ~StatementStatistics();
+    StatementStatistics(const StatementStatistics &) = delete;
+    StatementStatistics &operator=(const StatementStatistics &) = delete;
+
+    static StatementStatistics &shared();
+
+    static StringView fingerprint(const Statement &statement);
+
+    void record(const UnsafeStringView &path,
+                const UnsafeStringView &fingerprint,
+                int64_t costInNanoseconds,
+                int64_t pagesRead,
+                int64_t pagesWritten,
+                int64_t rowsReturned);
+
+    struct Entry {
+        Entry();
+
+        StringView fingerprint;
+        int64_t numberOfCalls;
+        int64_t totalCostInNanoseconds;
+        // The part of total cost inherited from the evicted shape, which is 0 if nothing is evicted.
+        int64_t inheritedCostInNanoseconds;
+        int64_t p50CostInNanoseconds;
+        int64_t p95CostInNanoseconds;
+        int64_t p99CostInNanoseconds;
+        int64_t pagesRead;
+        int64_t pagesWritten;
+        int64_t rowsReturned;
+    };
+    typedef struct Entry Entry;
+    // Sorted by total cost in descending order.
+    std::vector<Entry> getStatistics(const UnsafeStringView &path) const;
+    void reset(const UnsafeStringView &path);
+
+private:
+    /*
+     * HDR-style log-linear histogram of latencies in microseconds.
+     * Values less than 2^SubBucketBits are counted exactly,
+     * and each larger power of 2 is split into 2^SubBucketBits linear sub-buckets,
+     * so that the relative error of percentiles is bounded by 2^-SubBucketBits.
+     */
+    class Histogram {
+    public:
+        Histogram();
+
+        void record(int64_t microseconds);
+        int64_t percentile(double percentage, int64_t numberOfValues) const;
+
+        static constexpr const int SubBucketBits = StatementStatisticsHistogramSubBucketBits;
+        static constexpr const int NumberOfSubBuckets = 1 << SubBucketBits;
+        static constexpr const int NumberOfBuckets
+        = (StatementStatisticsHistogramMaxBits - SubBucketBits + 1) * NumberOfSubBuckets;
+
+        static int bucketOfValue(int64_t microseconds);
+        static int64_t valueOfBucket(int bucket);
+
+    private:
+        std::array<uint32_t, NumberOfBuckets> m_counts;
+    };
+
+    struct Aggregate {
+        Aggregate();
+
+        int64_t numberOfCalls;
+        int64_t totalCostInNanoseconds;
+        int64_t inheritedCostInNanoseconds;
+        int64_t pagesRead;
+        int64_t pagesWritten;
+        int64_t rowsReturned;
+        Histogram histogram;
+    };
+    typedef struct Aggregate Aggregate;
+    typedef StringViewMap<Aggregate> Aggregates;
+
+    mutable SharedLock m_lock;
+    StringViewMap<Aggregates> m_aggregates;
+};
+
+} // namespace WCDB
@@ -476,6 +476,95 @@ HandleStatement *select, HandleStatement *update, int64_t rowid, ColumnInfoPtrLi
     return true;
 }
 
+#pragma mark - Migrate
+bool CompressionTableInfo::compressMigratingRow(const Columns &columns,
+                                                OneRowValue &row,
+                                                bool canCompress,
+                                                InnerHandle *handle) const
+{
+    WCTAssert(columns.size() == row.size());
+    if (!canCompress) {
+        for (size_t i = 0; i < m_compressingColumns.size(); i++) {
+            row.emplace_back(nullptr);
+        }
+        return true;
+    }
+    auto indexOfColumn = [&columns](const Column &column) {
+        size_t index = 0;
+        for (const auto &migratingColumn : columns) {
+            if (migratingColumn.syntax().name.equal(column.syntax().name)) {
+                break;
+            }
+            index++;
+        }
+        return index;
+    };
+
+    OneRowValue types;
+    for (const auto &column : m_compressingColumns) {
+        size_t index = indexOfColumn(column.getColumn());
+        if (index >= row.size()) {
+            types.emplace_back(nullptr);
+            continue;
+        }
+        Value &value = row[index];
+        ColumnType valueType = value.getType();
+        if (valueType < ColumnType::Text) {
+            types.emplace_back((CompressionColumnInfo::Integer) CompressedType::None);
+            continue;
+        }
+
+        CompressedType compressedType = CompressedType::ZSTDDict;
+        CompressionColumnInfo::DictId dictId = 0;
+        switch (column.getCompressionType()) {
+        case CompressionType::Normal: {
+            compressedType = CompressedType::ZSTDNormal;
+        } break;
+        case CompressionType::Dict: {
+            dictId = column.getDictId();
+        } break;
+        case CompressionType::VariousDict: {
+            size_t matchIndex = indexOfColumn(column.getMatchColumn());
+            if (matchIndex >= row.size()) {
+                types.emplace_back(nullptr);
+                continue;
+            }
+            dictId = column.getMatchDictId(row[matchIndex].intValue());
+        } break;
+        }
+
+        UnsafeData data;
+        if (valueType == ColumnType::Text) {
+            const StringView &text = value.textValue();
+            data = UnsafeData((unsigned char *) text.data(), text.length());
+        } else {
+            data = value.blobValue();
+        }
+        Optional<UnsafeData> compressedValue
+        = CompressionCenter::shared().compressContent(data, dictId, handle);
+        if (compressedValue.failed()) {
+            return false;
+        }
+        WCTAssert(compressedValue.value().size() <= data.size());
+
+        if (compressedValue.value().size() < data.size()) {
+            value = compressedValue.value();
+            // The source row is deleted after migration, so the compressed content must be verified before inserting.
+            if (!CompressionCenter::shared().testContentCanBeDecompressed(
+                value.blobValue(), compressedType == CompressedType::ZSTDDict, handle)) {
+                return false;
+            }
+            types.emplace_back(
+            (CompressionColumnInfo::Integer) WCDBMergeCompressionType(compressedType, valueType));
+        } else {
+            types.emplace_back((CompressionColumnInfo::Integer) WCDBMergeCompressionType(
+            CompressedType::None, valueType));
+        }
+    }
+    row.insert(row.end(), types.begin(), types.end());
+    return true;
+}
+
 CompressionTableInfo::ColumnInfoIter::ColumnInfoIter(const ColumnInfoList *infoList,
                                                      ColumnInfoPtrList *infoPtrList)
 : m_infoList(infoList), m_infoPtrList(infoPtrList)
@@ -27,6 +27,7 @@
 #include "Column.hpp"
 #include "ColumnType.hpp"
 #include "StringView.hpp"
+#include "Value.hpp"
 #include "ZSTDDict.hpp"
 #include <atomic>
 #include <list>
@@ -36,6 +37,7 @@
 namespace WCDB {
 
 class HandleStatement;
+class InnerHandle;
 
 enum class CompressionType {
     Normal,
@@ -197,6 +199,22 @@ public:
                                                    ColumnInfoPtrList *columnList
                                                    = nullptr) const;
 
+#pragma mark - Migrate
+public:
+    /*
+     Compress the compressing columns of a row selected from the source table of migration,
+     whose values are in the order of columns,
+     and append the values of WCDB_CT_compressingColumnA, WCDB_CT_compressingColumnB ... to it.
+     The type value is left null when the column can't be compressed here or compressing new data is disabled,
+     so it will be compressed by the stepper.
+     Note that the compression record is not advanced by migration.
+     The stepper still reads the migrated rows once, but skips them since their type columns are set.
+     */
+    bool compressMigratingRow(const Columns &columns,
+                              OneRowValue &row,
+                              bool canCompress,
+                              InnerHandle *handle) const;
+
 private:
     class ColumnInfoIter {
     public:
@@ -0,0 +1,190 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AutoIntegrityCheckConfig.hpp"
+#include "Assertion.hpp"
+#include "CoreConst.h"
+#include "InnerHandle.hpp"
+#include "StringView.hpp"
+
+namespace WCDB {
+
+AutoIntegrityCheckOperator::~AutoIntegrityCheckOperator() = default;
+
+AutoIntegrityCheckConfig::AutoIntegrityCheckConfig(const std::shared_ptr<AutoIntegrityCheckOperator>& operator_)
+: Config(), m_identifier(StringView::formatted("Integrity-%p", this)), m_operator(operator_)
+{
+    WCTAssert(m_operator != nullptr);
+}
+
+AutoIntegrityCheckConfig::~AutoIntegrityCheckConfig() = default;
+
+bool AutoIntegrityCheckConfig::invoke(InnerHandle* handle)
+{
+    AbstractHandle::CheckPointNotification notifination
+    = { std::bind(&AutoIntegrityCheckConfig::onCheckpointBegin,
+                  this,
+                  std::placeholders::_1,
+                  std::placeholders::_2,
+                  std::placeholders::_3,
+                  std::placeholders::_4,
+                  std::placeholders::_5),
+        std::bind(&AutoIntegrityCheckConfig::onCheckpointPage,
+                  this,
+                  std::placeholders::_1,
+                  std::placeholders::_2,
+                  std::placeholders::_3),
+        std::bind(&AutoIntegrityCheckConfig::onCheckpointFinish,
+                  this,
+                  std::placeholders::_1,
+                  std::placeholders::_2,
+                  std::placeholders::_3,
+                  std::placeholders::_4,
+                  std::placeholders::_5) };
+    handle->setNotificationWhenCheckpointed(m_identifier, notifination);
+    return true;
+}
+
+bool AutoIntegrityCheckConfig::uninvoke(InnerHandle* handle)
+{
+    handle->setNotificationWhenCheckpointed(m_identifier, NullOpt);
+    return true;
+}
+
+bool AutoIntegrityCheckConfig::takeUncheckedPages(const UnsafeStringView& path, Pages& pages)
+{
+    LockGuard lock(m_lock);
+    if (m_overflowedPaths.find(path) != m_overflowedPaths.end()) {
+        m_overflowedPaths.erase(path);
+        m_uncheckedPages.erase(path);
+        return false;
+    }
+    auto iter = m_uncheckedPages.find(path);
+    if (iter != m_uncheckedPages.end()) {
+        pages = std::move(iter->second);
+        m_uncheckedPages.erase(iter);
+    }
+    return true;
+}
+
+void AutoIntegrityCheckConfig::restoreUncheckedPages(const UnsafeStringView& path,
+                                                     const Pages& pages)
+{
+    if (pages.empty()) {
+        return;
+    }
+    LockGuard lock(m_lock);
+    if (m_overflowedPaths.find(path) != m_overflowedPaths.end()) {
+        return;
+    }
+    auto& uncheckedPages = m_uncheckedPages[path];
+    for (const auto& page : pages) {
+        uncheckedPages.emplace(page.first, page.second);
+    }
+}
+
+void AutoIntegrityCheckConfig::clearUncheckedPages(const UnsafeStringView& path)
+{
+    LockGuard lock(m_lock);
+    m_checkpointPages.erase(path);
+    m_uncheckedPages.erase(path);
+    m_overflowedPaths.erase(path);
+}
+
+void AutoIntegrityCheckConfig::onCheckpointBegin(AbstractHandle* handle,
+                                                 uint32_t nBackFill,
+                                                 uint32_t mxFrame,
+                                                 uint32_t salt1,
+                                                 uint32_t salt2)
+{
+    WCDB_UNUSED(nBackFill);
+    WCDB_UNUSED(mxFrame);
+    WCDB_UNUSED(salt1);
+    WCDB_UNUSED(salt2);
+    LockGuard lock(m_lock);
+    m_checkpointPages[handle->getPath()] = Pages();
+}
+
+void AutoIntegrityCheckConfig::onCheckpointPage(AbstractHandle* handle,
+                                                uint32_t pageNo,
+                                                const UnsafeData& data)
+{
+    if (data.size() == 0) {
+        return;
+    }
+    Repair::Page::Type type = Repair::Page::convertToPageType(data.buffer()[0]);
+    if (type == Repair::Page::Type::Unknown) {
+        // Overflow pages and free pages are verified along with their b-tree pages.
+        return;
+    }
+    LockGuard lock(m_lock);
+    auto iter = m_checkpointPages.find(handle->getPath());
+    if (iter == m_checkpointPages.end()) {
+        return;
+    }
+    Repair::IncrementalMaterial::Page newPage;
+    newPage.number = pageNo;
+    newPage.type = type;
+    newPage.hash = data.hash();
+    iter->second[pageNo] = newPage;
+}
+
+void AutoIntegrityCheckConfig::onCheckpointFinish(AbstractHandle* handle,
+                                                  uint32_t nBackFill,
+                                                  uint32_t mxFrame,
+                                                  uint32_t salt1,
+                                                  uint32_t salt2)
+{
+    WCDB_UNUSED(nBackFill);
+    WCDB_UNUSED(mxFrame);
+    WCDB_UNUSED(salt1);
+    WCDB_UNUSED(salt2);
+    const StringView& path = handle->getPath();
+    {
+        LockGuard lock(m_lock);
+        auto pagesIter = m_checkpointPages.find(path);
+        if (pagesIter == m_checkpointPages.end()) {
+            return;
+        }
+        if (pagesIter->second.empty()) {
+            m_checkpointPages.erase(pagesIter);
+            return;
+        }
+        if (m_overflowedPaths.find(path) == m_overflowedPaths.end()) {
+            auto& uncheckedPages = m_uncheckedPages[path];
+            for (auto& iter : pagesIter->second) {
+                uncheckedPages[iter.first] = iter.second;
+            }
+            if (uncheckedPages.size() > IntegrityMaxIncrementalPageCount) {
+                // Too many pages are modified. It's cheaper to run a full check.
+                m_uncheckedPages.erase(path);
+                m_overflowedPaths.emplace(path);
+            }
+        }
+        m_checkpointPages.erase(pagesIter);
+    }
+    m_operator->asyncCheckIntegrityIncrementally(path);
+}
+
+} //namespace WCDB
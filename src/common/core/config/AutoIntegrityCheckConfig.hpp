@@ -0,0 +1,83 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Config.hpp"
+#include "IncrementalMaterial.hpp"
+#include "Lock.hpp"
+#include "StringView.hpp"
+
+namespace WCDB {
+
+class AbstractHandle;
+
+class AutoIntegrityCheckOperator {
+public:
+    virtual ~AutoIntegrityCheckOperator() = 0;
+    virtual void asyncCheckIntegrityIncrementally(const UnsafeStringView& path) = 0;
+};
+
+/*
+ It collects the b-tree pages written by checkpoint, in the same format as `IncrementalMaterial`,
+ so that the integrity check only needs to verify the pages modified since the last check.
+ */
+class AutoIntegrityCheckConfig final : public Config {
+public:
+    AutoIntegrityCheckConfig(const std::shared_ptr<AutoIntegrityCheckOperator>& operator_);
+    ~AutoIntegrityCheckConfig() override;
+
+    bool invoke(InnerHandle* handle) override final;
+    bool uninvoke(InnerHandle* handle) override final;
+
+    typedef Repair::IncrementalMaterial::Pages Pages;
+    // The returned value is false if the unchecked pages are overflowed and a full check is needed.
+    bool takeUncheckedPages(const UnsafeStringView& path, Pages& pages);
+    // Return the pages that are modified during checking. Newer records will not be overwritten.
+    void restoreUncheckedPages(const UnsafeStringView& path, const Pages& pages);
+    void clearUncheckedPages(const UnsafeStringView& path);
+
+private:
+    void onCheckpointBegin(AbstractHandle* handle,
+                           uint32_t nBackFill,
+                           uint32_t mxFrame,
+                           uint32_t salt1,
+                           uint32_t salt2);
+    void onCheckpointPage(AbstractHandle* handle, uint32_t pageNo, const UnsafeData& data);
+    void onCheckpointFinish(AbstractHandle* handle,
+                            uint32_t nBackFill,
+                            uint32_t mxFrame,
+                            uint32_t salt1,
+                            uint32_t salt2);
+
+    mutable SharedLock m_lock;
+
+    const StringView m_identifier;
+    std::shared_ptr<AutoIntegrityCheckOperator> m_operator;
+    StringViewMap<Pages> m_checkpointPages;
+    StringViewMap<Pages> m_uncheckedPages;
+    StringViewSet m_overflowedPaths;
+};
+
+} //namespace WCDB
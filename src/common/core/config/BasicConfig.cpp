@@ -26,8 +26,13 @@
 #include "Assertion.hpp"
 #include "Core.hpp"
 #include "CoreConst.h"
+#include "FileManager.hpp"
 #include "InnerHandle.hpp"
 #include "Macro.h"
+#include <algorithm>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 
 namespace WCDB {
 
@@ -60,6 +65,10 @@ bool BasicConfig::invoke(InnerHandle* handle)
         succeed &= handle->execute(m_setTempStore);
 #endif
     }
+    if (succeed && handle->isAdaptiveMMapEnabled()) {
+        succeed = handle->governMMapSize(
+        FileManager::getFileSize(handle->getPath()).valueOrDefault());
+    }
     return succeed;
 }
 
@@ -112,4 +121,38 @@ bool BasicConfig::lazySetJournalModeWAL(InnerHandle* handle)
     return succeed;
 }
 
+#pragma mark - Pragma - MMap
+int64_t BasicConfig::maxAdaptiveMMapSize()
+{
+    static int64_t s_maxSize = []() -> int64_t {
+        if (sizeof(void*) < 8) {
+            // The address space is too small to be shared by the handles.
+            return 0;
+        }
+        int64_t maxSize = BasicConfigMaxAdaptiveMMapSize;
+#ifndef _WIN32
+        struct rlimit limit;
+        if (getrlimit(RLIMIT_AS, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+            maxSize = std::min<int64_t>(
+            maxSize, (int64_t) limit.rlim_cur / HandlePoolMaxAllowedNumberOfHandles);
+        }
+#endif
+        return maxSize >= BasicConfigMinAdaptiveMMapSize ? maxSize : 0;
+    }();
+    return s_maxSize;
+}
+
+int64_t BasicConfig::adaptiveMMapSize(int64_t fileSize)
+{
+    int64_t maxSize = maxAdaptiveMMapSize();
+    if (maxSize == 0) {
+        return 0;
+    }
+    int64_t mmapSize = BasicConfigMinAdaptiveMMapSize;
+    while (mmapSize < fileSize * 2 && mmapSize < maxSize) {
+        mmapSize *= 2;
+    }
+    return std::min(mmapSize, maxSize);
+}
+
 } //namespace WCDB
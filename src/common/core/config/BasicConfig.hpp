@@ -56,6 +56,14 @@ protected:
 #pragma mark - Pragma - FullFsync
 protected:
     const StatementPragma m_setTempStore;
+
+#pragma mark - Pragma - MMap
+public:
+    // 0 means mmap should not be enabled.
+    static int64_t adaptiveMMapSize(int64_t fileSize);
+
+protected:
+    static int64_t maxAdaptiveMMapSize();
 };
 
 } //namespace WCDB
@@ -0,0 +1,323 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FTS5BulkIndexer.hpp"
+#include "Assertion.hpp"
+#include "Core.hpp"
+#include "CoreConst.h"
+#include "InnerHandle.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace WCDB {
+
+FTS5BulkIndexer::FTS5BulkIndexer(InnerHandle *handle)
+: m_handle(handle)
+, m_module(nullptr)
+, m_rows(nullptr)
+, m_nextRow(0)
+, m_insertedRow(0)
+, m_stop(false)
+{
+    WCTAssert(m_handle != nullptr);
+}
+
+FTS5BulkIndexer::~FTS5BulkIndexer()
+{
+    stopWorkers();
+}
+
+#pragma mark - Insert
+bool FTS5BulkIndexer::insertRows(const Statement &insert,
+                                 const UnsafeStringView &table,
+                                 const MultiRowsValue &rows)
+{
+    bool pretokenize = false;
+    if (rows.size() >= FTSBulkIndexMinRowCount) {
+        auto prepared = prepareTokenizer(table);
+        if (prepared.failed()) {
+            return false;
+        }
+        pretokenize = prepared.value() && startWorkers(rows);
+    }
+    bool succeed = insertRows(insert, rows, pretokenize);
+    stopWorkers();
+    return succeed;
+}
+
+bool FTS5BulkIndexer::insertRows(const Statement &insert, const MultiRowsValue &rows, bool pretokenize)
+{
+    if (!m_handle->prepare(insert)) {
+        return false;
+    }
+    bool succeed = true;
+    for (size_t i = 0; i < rows.size() && succeed; ++i) {
+        if (pretokenize) {
+            waitForRow(i);
+            PretokenizedDocument::setReplayingDocuments(&m_documents[i]);
+        }
+        m_handle->reset();
+        m_handle->bindRow(rows[i]);
+        succeed = m_handle->step();
+        if (pretokenize) {
+            PretokenizedDocument::setReplayingDocuments(nullptr);
+            finishRow(i);
+        }
+    }
+    m_handle->finalize();
+    return succeed;
+}
+
+#pragma mark - Tokenizer
+Optional<bool> FTS5BulkIndexer::prepareTokenizer(const UnsafeStringView &table)
+{
+    StatementSelect select
+    = StatementSelect()
+      .select(Column("sql"))
+      .from("sqlite_master")
+      .where(Column("name") == table
+             && Column("sql").like("CREATE VIRTUAL TABLE % USING fts5(%"));
+    if (!m_handle->prepare(select)) {
+        return NullOpt;
+    }
+    if (!m_handle->step()) {
+        m_handle->finalize();
+        return NullOpt;
+    }
+    StringView sql;
+    if (!m_handle->done()) {
+        sql = m_handle->getText(0);
+    }
+    m_handle->finalize();
+
+    StringView tokenizer;
+    m_arguments.clear();
+    if (sql.empty() || !parseTokenizer(sql, tokenizer, m_arguments)) {
+        return false;
+    }
+    m_module = Core::shared().getFTS5Tokenizer(tokenizer);
+    return m_module != nullptr;
+}
+
+static bool parseTokenizerArgument(const char *&cursor, const char *end, std::string &argument)
+{
+    while (cursor < end && isspace((unsigned char) *cursor)) {
+        ++cursor;
+    }
+    if (cursor >= end) {
+        return false;
+    }
+    argument.clear();
+    if (*cursor == '\'' || *cursor == '"') {
+        char quote = *cursor++;
+        while (cursor < end) {
+            if (*cursor == quote) {
+                if (cursor + 1 < end && cursor[1] == quote) {
+                    argument.push_back(quote);
+                    cursor += 2;
+                    continue;
+                }
+                ++cursor;
+                break;
+            }
+            argument.push_back(*cursor++);
+        }
+    } else {
+        while (cursor < end && !isspace((unsigned char) *cursor)) {
+            argument.push_back(*cursor++);
+        }
+    }
+    return true;
+}
+
+bool FTS5BulkIndexer::parseTokenizer(const UnsafeStringView &sql,
+                                     StringView &tokenizer,
+                                     std::vector<StringView> &arguments)
+{
+    const char *begin = sql.data();
+    const char *end = begin + sql.length();
+    const UnsafeStringView option = "tokenize";
+    for (const char *iter = begin; iter + option.length() <= end; ++iter) {
+        if (!UnsafeStringView(iter, option.length()).caseInsensitiveEqual(option)) {
+            continue;
+        }
+        if (iter > begin && iter[-1] != '(' && iter[-1] != ','
+            && !isspace((unsigned char) iter[-1])) {
+            continue;
+        }
+        const char *cursor = iter + option.length();
+        while (cursor < end && isspace((unsigned char) *cursor)) {
+            ++cursor;
+        }
+        if (cursor >= end || *cursor != '=') {
+            continue;
+        }
+        ++cursor;
+        while (cursor < end && isspace((unsigned char) *cursor)) {
+            ++cursor;
+        }
+        // The option value is a string or a bareword, which contains the tokenizer and its arguments.
+        std::string value;
+        if (cursor < end && (*cursor == '\'' || *cursor == '"')) {
+            parseTokenizerArgument(cursor, end, value);
+        } else {
+            while (cursor < end && *cursor != ',' && *cursor != ')') {
+                value.push_back(*cursor++);
+            }
+        }
+        const char *valueCursor = value.data();
+        const char *valueEnd = valueCursor + value.length();
+        std::string argument;
+        if (!parseTokenizerArgument(valueCursor, valueEnd, argument)) {
+            return false;
+        }
+        tokenizer = StringView(argument.data(), argument.length());
+        while (parseTokenizerArgument(valueCursor, valueEnd, argument)) {
+            arguments.push_back(StringView(argument.data(), argument.length()));
+        }
+        return true;
+    }
+    return false;
+}
+
+#pragma mark - Worker
+std::atomic<int> &FTS5BulkIndexer::maxNumberOfWorkers()
+{
+    static std::atomic<int> *s_maxNumberOfWorkers
+    = new std::atomic<int>(FTSBulkIndexMaxNumberOfWorkers);
+    return *s_maxNumberOfWorkers;
+}
+
+void FTS5BulkIndexer::setMaxNumberOfWorkers(int maxNumberOfWorkers_)
+{
+    WCTRemedialAssert(maxNumberOfWorkers_ >= 0,
+                      "Number of workers can't be negative.",
+                      return;);
+    maxNumberOfWorkers().store(maxNumberOfWorkers_);
+}
+
+bool FTS5BulkIndexer::startWorkers(const MultiRowsValue &rows)
+{
+    WCTAssert(m_module != nullptr && m_workers.empty());
+    // The current thread is busy with index maintenance.
+    int numberOfWorkers = std::min(maxNumberOfWorkers().load(),
+                                   (int) std::thread::hardware_concurrency() - 1);
+    if (numberOfWorkers <= 0) {
+        return false;
+    }
+    m_rows = &rows;
+    m_documents.clear();
+    m_documents.resize(rows.size());
+    m_tokenizedRows.assign(rows.size(), false);
+    m_nextRow = 0;
+    m_insertedRow = 0;
+    m_stop = false;
+    // Workers live for one insertion only, like the ones of vacuum. The cost of spawning them is negligible
+    // compared with tokenizing at least `FTSBulkIndexMinRowCount` rows.
+    for (int i = 0; i < numberOfWorkers; ++i) {
+        m_workers.emplace_back(&FTS5BulkIndexer::runWorker, this);
+    }
+    return true;
+}
+
+void FTS5BulkIndexer::runWorker()
+{
+    std::vector<const char *> arguments;
+    for (const StringView &argument : m_arguments) {
+        arguments.push_back(argument.data());
+    }
+    AbstractFTSTokenizer *tokenizer
+    = m_module->createTokenizer(arguments.data(), (int) arguments.size());
+    while (true) {
+        size_t row;
+        {
+            std::unique_lock<std::mutex> lockGuard(m_lock);
+            // Limit the memory of the tokens waiting to be inserted.
+            while (!m_stop && m_nextRow < m_rows->size()
+                   && m_nextRow >= m_insertedRow + FTSBulkIndexMaxPendingRowCount) {
+                m_cond.wait(lockGuard);
+            }
+            if (m_stop || m_nextRow >= m_rows->size()) {
+                break;
+            }
+            row = m_nextRow++;
+        }
+        if (tokenizer != nullptr) {
+            // Values except texts, and the ones failed to be tokenized, are left to fts5.
+            PretokenizedDocument::Documents &documents = m_documents[row];
+            for (const Value &value : (*m_rows)[row]) {
+                if (value.getType() != ColumnType::Text) {
+                    continue;
+                }
+                documents.emplace_back();
+                if (!documents.back().tokenize(
+                         *m_module, tokenizer, m_arguments, value.textValue())) {
+                    documents.pop_back();
+                }
+            }
+        }
+        std::lock_guard<std::mutex> lockGuard(m_lock);
+        m_tokenizedRows[row] = true;
+        m_cond.notify_all();
+    }
+    m_module->destroyTokenizer(tokenizer);
+}
+
+bool FTS5BulkIndexer::waitForRow(size_t row)
+{
+    std::unique_lock<std::mutex> lockGuard(m_lock);
+    while (!m_tokenizedRows[row] && !m_stop) {
+        m_cond.wait(lockGuard);
+    }
+    return m_tokenizedRows[row];
+}
+
+void FTS5BulkIndexer::finishRow(size_t row)
+{
+    // Release the tokens as soon as they are indexed.
+    PretokenizedDocument::Documents().swap(m_documents[row]);
+    std::lock_guard<std::mutex> lockGuard(m_lock);
+    m_insertedRow = row + 1;
+    m_cond.notify_all();
+}
+
+void FTS5BulkIndexer::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lockGuard(m_lock);
+        m_stop = true;
+        m_cond.notify_all();
+    }
+    for (auto &worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+    m_documents.clear();
+    m_tokenizedRows.clear();
+    m_rows = nullptr;
+}
+
+} // namespace WCDB
@@ -0,0 +1,94 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Lock.hpp"
+#include "PretokenizedDocument.hpp"
+#include "StringView.hpp"
+#include "Value.hpp"
+#include "WCDBOptional.hpp"
+#include "WINQ.h"
+#include <atomic>
+#include <list>
+#include <thread>
+
+namespace WCDB {
+
+class InnerHandle;
+
+/*
+ It inserts rows into a fts5 table with the text values tokenized by worker threads in advance.
+ The tokens are replayed to fts5 when the rows are inserted by the writer, so that the writer only maintains the index.
+ It falls back to a plain insertion if the tokenizer of the table is not a fts5 tokenizer registered into WCDB.
+ */
+class FTS5BulkIndexer final {
+public:
+    FTS5BulkIndexer(InnerHandle *handle);
+    ~FTS5BulkIndexer();
+
+    FTS5BulkIndexer() = delete;
+    FTS5BulkIndexer(const FTS5BulkIndexer &) = delete;
+    FTS5BulkIndexer &operator=(const FTS5BulkIndexer &) = delete;
+
+    // The values of each row are bound to the statement in order.
+    bool insertRows(const Statement &insert,
+                    const UnsafeStringView &table,
+                    const MultiRowsValue &rows);
+
+    // It's `FTSBulkIndexMaxNumberOfWorkers` by default. The rows are inserted without pretokenizing if it's 0.
+    static void setMaxNumberOfWorkers(int maxNumberOfWorkers);
+
+    // Parse the `tokenize` option from the sql of a fts5 table.
+    static bool parseTokenizer(const UnsafeStringView &sql,
+                               StringView &tokenizer,
+                               std::vector<StringView> &arguments);
+
+private:
+    Optional<bool> prepareTokenizer(const UnsafeStringView &table);
+    bool insertRows(const Statement &insert, const MultiRowsValue &rows, bool pretokenize);
+
+    static std::atomic<int> &maxNumberOfWorkers();
+    bool startWorkers(const MultiRowsValue &rows);
+    void runWorker();
+    void stopWorkers();
+    bool waitForRow(size_t row);
+    void finishRow(size_t row);
+
+    InnerHandle *m_handle;
+    std::shared_ptr<FTS5TokenizerModule> m_module;
+    std::vector<StringView> m_arguments;
+
+    const MultiRowsValue *m_rows;
+    std::vector<PretokenizedDocument::Documents> m_documents;
+    std::vector<bool> m_tokenizedRows;
+    size_t m_nextRow;
+    size_t m_insertedRow;
+    bool m_stop;
+    std::mutex m_lock;
+    Conditional m_cond;
+    std::list<std::thread> m_workers;
+};
+
+} // namespace WCDB
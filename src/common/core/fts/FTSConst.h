@@ -68,14 +68,16 @@ static constexpr const char* Pinyin = "wcdb_pinyin";
 
 namespace Parameter {
 /**
- The following three are optional parameters for WCDB implemented tokenizers. You can use `WCDB_CPP_VIRTUAL_TABLE_TOKENIZE_WITH_PARAMETERS` to config fts tokenizer with parameters for a cpp ORM class.
+ The following four are optional parameters for WCDB implemented tokenizers. You can use `WCDB_CPP_VIRTUAL_TABLE_TOKENIZE_WITH_PARAMETERS` to config fts tokenizer with parameters for a cpp ORM class.
  Configuring `BuiltinTokenizer::Parameter::NeedSymbol` allows the tokenizer to recognize each symbol character as a token.
  Configuring `BuiltinTokenizer::Parameter::SimplifyChinese` enables the tokenizer to convert each traditional Chinese character into a simplified Chinese character, so that you can use Simplified Chinese characters to search Traditional Chinese characters. Note that you need to use `static Database::configTraditionalChineseConverter()` to configure the converter from traditional Chinese characters to their simplified Chinese characters before using the tokenizer.
  Configuring `BuiltinTokenizer::Parameter::SkipStemming` will disable the stemming during tokenization.
+ Configuring `BuiltinTokenizer::Parameter::PinyinPrefix` makes `BuiltinTokenizer::Pinyin` index every prefix of the full pinyins, besides the full and short pinyins. So that the pinyin being typed can be searched as a term instead of a prefix query, which is much faster on large tables. You can use `FTSTokenizerUtil::pinyinMatchPattern()` to generate the match pattern of the user input.
  */
 static constexpr const char* NeedSymbol = "need_symbol";
 static constexpr const char* SimplifyChinese = "chinese_traditional_to_simplified";
 static constexpr const char* SkipStemming = "skip_stemming";
+static constexpr const char* PinyinPrefix = "pinyin_prefix";
 
 } //namespace Parameter
 
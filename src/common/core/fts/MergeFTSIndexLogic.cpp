@@ -28,7 +28,9 @@
 #include "CoreConst.h"
 #include "Notifier.hpp"
 #include "WCDBError.hpp"
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 namespace WCDB {
 
@@ -39,6 +41,9 @@ MergeFTSIndexLogic::MergeFTSIndexLogic(MergeFTSIndexHandleProvider *handleProvid
 , m_hasInit(false)
 , m_processing(false)
 , m_errorCount(0)
+, m_foregroundBackoffCount(0)
+, m_maxDuration(AutoMergeFTSIndexDefaultMaxDurationPerRun)
+, m_maxPages(AutoMergeFTSIndexDefaultMaxPagesPerRun)
 , m_getTableStatement(StatementSelect()
                       .select(Column("name"))
                       .from("sqlite_master")
@@ -138,7 +143,7 @@ Optional<bool>
 MergeFTSIndexLogic::triggerMerge(InnerHandle &handle, TableArray newTables, TableArray modifiedTables)
 {
     LockGuard lockGuard(m_lock);
-    if (m_errorCount.load() > 5) {
+    if (isSuspended()) {
         return NullOpt;
     }
     if (!tryInit(handle)) {
@@ -153,30 +158,33 @@ MergeFTSIndexLogic::triggerMerge(InnerHandle &handle, TableArray newTables, Tabl
         return true;
     }
     if (m_processing) {
+        // The tables are merged after the current run.
         return false;
     }
-    OperationQueue::shared().async(handle.getPath(), [](const UnsafeStringView &path) {
-        RecyclableDatabase database = Core::shared().getOrCreateDatabase(path);
-        if (database != nullptr) {
-            database->proccessMerge();
-        }
-    });
+    // The writes are still going on, so keep away from them for a while.
+    asyncProcessMerge(AutoMergeFTSIndexForegroundBackoffDelay);
     return false;
 }
 
 void MergeFTSIndexLogic::proccessMerge()
 {
-    StringView table;
     {
         SharedLockGuard lockGuard(m_lock);
-        if (m_errorCount > 5) {
+        if (isSuspended()) {
             return;
         }
         if (m_mergingTables.size() == 0) {
             return;
         }
-        table = *m_mergingTables.begin();
     }
+    if (m_handleProvider->hasForegroundActivity()
+        && ++m_foregroundBackoffCount <= AutoMergeFTSIndexMaxForegroundBackoffCount) {
+        // Keep away from the foreground operations, but not forever.
+        asyncProcessMerge(AutoMergeFTSIndexForegroundBackoffDelay);
+        return;
+    }
+    m_foregroundBackoffCount = 0;
+
     RecyclableHandle recyclableHandle = m_handleProvider->getMergeIndexHandle();
     if (recyclableHandle == nullptr) {
         return;
@@ -190,27 +198,160 @@ void MergeFTSIndexLogic::proccessMerge()
     handle->markErrorAsIgnorable(Error::Code::Busy);
     handle->setTableMonitorEnable(false);
 
-    while (!table.empty()) {
-        if (!mergeTable(*handle, table)) {
-            if (!handle->getError().isIgnorable()) {
-                increaseErrorCount();
-            }
-            break;
+    std::vector<StringView> tables;
+    {
+        LockGuard lockGuard(m_lock);
+        if (m_mergingTables.size() == 0) {
+            handle->setTableMonitorEnable(true);
+            return;
         }
-        SharedLockGuard lockGuard(m_lock);
-        m_mergingTables.erase(table);
-        m_mergedTables.emplace(table);
-        if (m_mergingTables.size() > 0) {
-            table = *m_mergingTables.begin();
-        } else {
+        tables.assign(m_mergingTables.begin(), m_mergingTables.end());
+        m_processing = true;
+    }
+    MergeContext context(handle, m_maxDuration.load(), m_maxPages.load());
+    MergeResult result = MergeResult::Finished;
+    if (!sortMergingTables(*handle, tables)) {
+        result = MergeResult::Failed;
+    }
+    for (const StringView &table : tables) {
+        if (result != MergeResult::Finished) {
             break;
         }
+        int pagesWritten = context.pagesWritten;
+        SteadyClock start = SteadyClock::now();
+        result = mergeTable(context, table);
+        double timeSpent = SteadyClock::timeIntervalSinceSteadyClockToNow(start);
+        Optional<int> segmentCount;
+        if (result != MergeResult::Failed) {
+            segmentCount = getSegmentCount(*handle, table);
+        }
+
+        LockGuard lockGuard(m_lock);
+        TableStatistics &statistics = m_statistics[table];
+        statistics.pagesWritten += context.pagesWritten - pagesWritten;
+        statistics.timeSpent += timeSpent;
+        if (segmentCount.succeed()) {
+            statistics.segmentCount = segmentCount.value();
+        }
+        if (result == MergeResult::Finished) {
+            m_mergingTables.erase(table);
+            m_mergedTables.emplace(table);
+        }
+    }
+    bool hasMergingTables = false;
+    {
+        LockGuard lockGuard(m_lock);
+        // The tables modified during this run are not fully merged.
+        for (const StringView &table : m_pendingTables) {
+            m_mergedTables.erase(table);
+            m_mergingTables.emplace(table);
+        }
+        m_pendingTables.clear();
+        hasMergingTables = m_mergingTables.size() > 0;
+        m_processing = false;
     }
     handle->setTableMonitorEnable(true);
+
+    switch (result) {
+    case MergeResult::Failed:
+        if (!handle->getError().isIgnorable()) {
+            LockGuard lockGuard(m_lock);
+            increaseErrorCount();
+        } else {
+            asyncProcessMerge(AutoMergeFTSIndexForegroundBackoffDelay);
+        }
+        break;
+    case MergeResult::Interrupted:
+        // The budget is used up or the foreground operations are waiting.
+        asyncProcessMerge(context.yielded ? AutoMergeFTSIndexForegroundBackoffDelay :
+                                            OperationQueueTimeIntervalForMergeFTSIndex);
+        break;
+    case MergeResult::Finished:
+        m_errorCount = 0;
+        if (hasMergingTables) {
+            asyncProcessMerge(AutoMergeFTSIndexForegroundBackoffDelay);
+        }
+        break;
+    }
+}
+
+void MergeFTSIndexLogic::asyncProcessMerge(double delay)
+{
+    OperationQueue::shared().async(
+    m_handleProvider->getPath(), delay, [](const UnsafeStringView &path) {
+        RecyclableDatabase database = Core::shared().getOrCreateDatabase(path);
+        if (database != nullptr) {
+            database->proccessMerge();
+        }
+    });
 }
 
-bool MergeFTSIndexLogic::mergeTable(InnerHandle &handle, const StringView &table)
+Optional<int>
+MergeFTSIndexLogic::getSegmentCount(InnerHandle &handle, const UnsafeStringView &table)
 {
+    // The structure record of fts5 index is stored with id 10 in the data table.
+    // It starts with a 4-byte cookie, an optional 4-byte version mark, then the varints of level count and segment count.
+    Statement selectStructure = StatementSelect()
+                                .select(Column("block"))
+                                .from(StringView::formatted("%s_data", table.data()))
+                                .where(Column("id") == 10);
+    if (!handle.prepare(selectStructure)) {
+        return NullOpt;
+    }
+    if (!handle.step()) {
+        handle.finalize();
+        return NullOpt;
+    }
+    int segmentCount = 0;
+    if (!handle.done()) {
+        const UnsafeData structure = handle.getBLOB(0);
+        const unsigned char *buffer = structure.buffer();
+        size_t size = structure.size();
+        size_t offset = 4;
+        static constexpr const unsigned char structureV2[] = { 0xff, 0x00, 0x00, 0x01 };
+        if (size >= offset + 4 && memcmp(buffer + offset, structureV2, 4) == 0) {
+            offset += 4;
+        }
+        for (int i = 0; i < 2 && offset < size; ++i) {
+            uint32_t value = 0;
+            unsigned char byte;
+            do {
+                byte = buffer[offset++];
+                value = (value << 7) | (byte & 0x7f);
+            } while ((byte & 0x80) != 0 && offset < size);
+            segmentCount = (int) value;
+        }
+    }
+    handle.finalize();
+    return segmentCount;
+}
+
+bool MergeFTSIndexLogic::sortMergingTables(InnerHandle &handle, std::vector<StringView> &tables)
+{
+    std::map<StringView, int> segmentCounts;
+    for (const StringView &table : tables) {
+        Optional<int> segmentCount = getSegmentCount(handle, table);
+        if (!segmentCount.succeed()) {
+            return false;
+        }
+        segmentCounts[table] = segmentCount.value();
+    }
+    std::stable_sort(tables.begin(),
+                     tables.end(),
+                     [&segmentCounts](const StringView &left, const StringView &right) {
+                         return segmentCounts[left] > segmentCounts[right];
+                     });
+    LockGuard lockGuard(m_lock);
+    for (const auto &iter : segmentCounts) {
+        m_statistics[iter.first].segmentCount = iter.second;
+    }
+    return true;
+}
+
+MergeFTSIndexLogic::MergeResult
+MergeFTSIndexLogic::mergeTable(MergeContext &context, const StringView &table)
+{
+    InnerHandle &handle = *context.handle;
     int preChangeCount;
     Statement mergeSTM
     = StatementInsert()
@@ -218,39 +359,52 @@ bool MergeFTSIndexLogic::mergeTable(InnerHandle &handle, const StringView &table
       .columns({ Column(table), Column("rank"), Column().rowid() })
       .values({ UnsafeStringView("merge"), 256, WCDB::BindParameter(1) });
     if (!handle.prepare(mergeSTM)) {
-        return false;
+        return MergeResult::Failed;
     }
     void **callbackPointer = new void *[2];
     callbackPointer[0] = (void *) MergeFTSIndexLogic::userMergeCallback;
-    callbackPointer[1] = &handle;
+    callbackPointer[1] = &context;
+    MergeResult result = MergeResult::Interrupted;
     do {
         preChangeCount = handle.getTotalChange();
+        context.stepPagesWritten = 0;
         handle.bindPointer(callbackPointer, 1, "fts5_user_merge_callback", nullptr);
-        if (!handle.step()) {
-            handle.finalize();
-            delete[] callbackPointer;
-            return false;
-        } else {
-            handle.reset();
+        bool succeed = handle.step();
+        context.pagesWritten += context.stepPagesWritten;
+        if (!succeed) {
+            result = MergeResult::Failed;
+            break;
+        }
+        handle.reset();
+        if (handle.getTotalChange() - preChangeCount <= 1) {
+            result = MergeResult::Finished;
+            break;
         }
         //Use prime numbers to reduce the probability of collision with external logic
         std::this_thread::sleep_for(std::chrono::microseconds(1229));
-    } while (handle.getTotalChange() - preChangeCount > 1);
+        if (!context.yielded && m_handleProvider->hasForegroundActivity()) {
+            context.yielded = true;
+        }
+    } while (!context.yielded && !context.isOverBudget());
     handle.finalize();
     delete[] callbackPointer;
-    return true;
+    return result;
 }
 
-void MergeFTSIndexLogic::userMergeCallback(InnerHandle *handle,
+void MergeFTSIndexLogic::userMergeCallback(MergeContext *context,
                                            int *remainPages,
                                            int totalPagesWriten,
                                            int *lastCheckPages)
 {
+    context->stepPagesWritten = totalPagesWriten;
     if (totalPagesWriten - *lastCheckPages < 16) {
         return;
     }
     *lastCheckPages = totalPagesWriten;
-    if (!handle->checkHasBusyRetry()) {
+    if (context->handle->checkHasBusyRetry()) {
+        context->yielded = true;
+    } else if (context->pagesWritten + totalPagesWriten < context->maxPages
+               && SteadyClock::now() < context->deadline) {
         return;
     }
     *remainPages = totalPagesWriten - 1;
@@ -286,6 +440,9 @@ bool MergeFTSIndexLogic::checkModifiedTables(InnerHandle &handle,
             if (!handle.done()) {
                 m_mergingTables.emplace(element);
                 fts5Tables->push_back(element);
+                if (m_processing) {
+                    m_pendingTables.emplace(element);
+                }
             }
             handle.reset();
         }
@@ -305,6 +462,10 @@ bool MergeFTSIndexLogic::checkModifiedTables(InnerHandle &handle,
                 m_mergedTables.erase(element);
                 m_mergingTables.emplace(element);
             }
+            if (m_processing && m_mergingTables.find(element) != m_mergingTables.end()) {
+                // It may be merged by the current run before being modified.
+                m_pendingTables.emplace(element);
+            }
         }
     }
     return true;
@@ -312,17 +473,67 @@ bool MergeFTSIndexLogic::checkModifiedTables(InnerHandle &handle,
 
 void MergeFTSIndexLogic::increaseErrorCount()
 {
-    m_errorCount++;
-    if (m_errorCount.load() > 5) {
+    WCTAssert(m_lock.writeSafety());
+    int errorCount = ++m_errorCount;
+    // Rescan all the fts5 tables after recovering from errors.
+    m_hasInit = false;
+    double duration = std::min(OperationQueueTimeIntervalForMergeFTSIndex
+                               * std::pow(2, errorCount - 1),
+                               AutoMergeFTSIndexMaxSuspendedDuration);
+    m_suspendedUntil = SteadyClock::now().steadyClockByAddingTimeInterval(duration);
+    asyncProcessMerge(duration);
+    if (errorCount == AutoMergeFTSIndexErrorCountToNotify) {
         Error error(Error::Code::Notice,
                     Error::Level::Notice,
-                    "Auto merge fts index is stopped due to too many errors.");
+                    "Auto merge fts index is suspended due to too many errors.");
         error.infos.insert_or_assign(ErrorStringKeyPath, m_handleProvider->getPath());
         error.infos.insert_or_assign(ErrorStringKeyType, ErrorTypeMergeIndex);
         Notifier::shared().notify(error);
     }
 }
 
+bool MergeFTSIndexLogic::isSuspended() const
+{
+    return m_errorCount.load() > 0 && SteadyClock::now() < m_suspendedUntil;
+}
+
+#pragma mark - Budget
+void MergeFTSIndexLogic::setBudget(double maxDuration, int maxPages)
+{
+    WCTRemedialAssert(maxDuration >= 0 && maxPages >= 0,
+                      "Budget of auto merge fts index can't be negative.",
+                      return;);
+    m_maxDuration = maxDuration;
+    m_maxPages = maxPages;
+}
+
+MergeFTSIndexLogic::MergeContext::MergeContext(InnerHandle *handle_, double maxDuration, int maxPages_)
+: handle(handle_)
+, deadline(SteadyClock::now().steadyClockByAddingTimeInterval(maxDuration))
+, maxPages(maxPages_)
+, pagesWritten(0)
+, stepPagesWritten(0)
+, yielded(false)
+{
+}
+
+bool MergeFTSIndexLogic::MergeContext::isOverBudget() const
+{
+    return pagesWritten >= maxPages || SteadyClock::now() >= deadline;
+}
+
+#pragma mark - Statistics
+MergeFTSIndexLogic::TableStatistics::TableStatistics()
+: segmentCount(0), pagesWritten(0), timeSpent(0)
+{
+}
+
+StringViewMap<MergeFTSIndexLogic::TableStatistics> MergeFTSIndexLogic::getStatistics() const
+{
+    SharedLockGuard lockGuard(m_lock);
+    return m_statistics;
+}
+
 #pragma mark - OperationQueue
 
 MergeFTSIndexLogic::OperationQueue &MergeFTSIndexLogic::OperationQueue::shared()
@@ -341,9 +552,10 @@ MergeFTSIndexLogic::OperationQueue::OperationQueue(const UnsafeStringView &name)
 }
 
 void MergeFTSIndexLogic::OperationQueue::async(const UnsafeStringView &path,
+                                               double delay,
                                                const OperationCallBack &callback)
 {
-    m_timedQueue.queue(StringView(path), 0, callback, AsyncMode::ForwardOnly);
+    m_timedQueue.queue(StringView(path), delay, callback, AsyncMode::ForwardOnly);
 }
 
 void MergeFTSIndexLogic::OperationQueue::cancelOperation(const UnsafeStringView &path)
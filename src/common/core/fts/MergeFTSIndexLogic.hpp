@@ -29,6 +29,7 @@
 #include "Lock.hpp"
 #include "RecyclableHandle.hpp"
 #include "StringView.hpp"
+#include "Time.hpp"
 #include "TimedQueue.hpp"
 #include <array>
 
@@ -42,6 +43,8 @@ protected:
     friend class MergeFTSIndexLogic;
     virtual RecyclableHandle getMergeIndexHandle() = 0;
     virtual const StringView& getPath() const = 0;
+    // Whether there are handles serving the foreground operations now.
+    virtual bool hasForegroundActivity() const = 0;
 };
 
 class MergeFTSIndexLogic {
@@ -52,29 +55,75 @@ public:
     Optional<bool> triggerMerge(TableArray newTables, TableArray modifiedTables);
     void proccessMerge();
 
+    /*
+     Each merge run spends at most `maxDuration` seconds and writes at most `maxPages` pages.
+     The remaining work is continued in the following runs. Negative budgets are rejected.
+     */
+    void setBudget(double maxDuration, int maxPages);
+
+    struct TableStatistics {
+        TableStatistics();
+        // The number of segments in the fts5 index last observed by the merge logic.
+        int segmentCount;
+        int64_t pagesWritten;
+        double timeSpent;
+    };
+    StringViewMap<TableStatistics> getStatistics() const;
+
 private:
     bool tryInit(InnerHandle& handle);
     Optional<bool>
     triggerMerge(InnerHandle& handle, TableArray newTables, TableArray modifiedTables);
     bool tryConfigUserMerge(InnerHandle& handle, const UnsafeStringView& table, bool isNew);
     bool checkModifiedTables(InnerHandle& handle, TableArray newTables, TableArray modifiedTables);
-    bool mergeTable(InnerHandle& handle, const StringView& table);
+    Optional<int> getSegmentCount(InnerHandle& handle, const UnsafeStringView& table);
+    // Tables with more segments cost more to query, so they are merged first.
+    bool sortMergingTables(InnerHandle& handle, std::vector<StringView>& tables);
+
+    struct MergeContext {
+        MergeContext(InnerHandle* handle, double maxDuration, int maxPages);
+        bool isOverBudget() const;
+
+        InnerHandle* handle;
+        SteadyClock deadline;
+        int maxPages;
+        int pagesWritten;
+        int stepPagesWritten;
+        bool yielded;
+    };
+    enum class MergeResult {
+        Failed,
+        Finished,
+        Interrupted,
+    };
+    MergeResult mergeTable(MergeContext& context, const StringView& table);
     void increaseErrorCount();
+    bool isSuspended() const;
+    void asyncProcessMerge(double delay);
 
-    static void
-    userMergeCallback(InnerHandle* handle, int* remainPages, int totalPagesWriten, int* lastCheckPages);
+    static void userMergeCallback(MergeContext* context,
+                                  int* remainPages,
+                                  int totalPagesWriten,
+                                  int* lastCheckPages);
 
     MergeFTSIndexHandleProvider* m_handleProvider;
 
     bool m_hasInit;
     std::atomic<bool> m_processing;
     std::atomic<int> m_errorCount;
+    std::atomic<int> m_foregroundBackoffCount;
+    std::atomic<double> m_maxDuration;
+    std::atomic<int> m_maxPages;
 
-    SharedLock m_lock;
+    mutable SharedLock m_lock;
 
     Statement m_getTableStatement;
     StringViewSet m_mergingTables;
     StringViewSet m_mergedTables;
+    // Tables created or modified while processing, which are merged again in the next run.
+    StringViewSet m_pendingTables;
+    StringViewMap<TableStatistics> m_statistics;
+    SteadyClock m_suspendedUntil;
 
 private:
     class OperationQueue : public AsyncQueue {
@@ -84,7 +133,7 @@ private:
         static OperationQueue& shared();
 
         using OperationCallBack = std::function<void(const UnsafeStringView&)>;
-        void async(const UnsafeStringView& path, const OperationCallBack& callback);
+        void async(const UnsafeStringView& path, double delay, const OperationCallBack& callback);
         void cancelOperation(const UnsafeStringView& path);
 
     private:
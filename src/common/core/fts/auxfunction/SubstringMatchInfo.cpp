@@ -155,7 +155,7 @@ void SubstringMatchInfo::process(FTS5AuxiliaryFunctionAPI &apiObj)
         if (!m_phaseMatchResult) {
             m_phaseMatchResult = new bool[m_phaseCount];
         }
-        m_pIter = PhaseInstIter();
+        m_pIter.reset();
         rc = m_pIter.init(&apiObj);
         if (FTSError::isOK(rc)) {
             m_currentPhaseMatchCount = 0;
@@ -177,7 +177,9 @@ void SubstringMatchInfo::process(FTS5AuxiliaryFunctionAPI &apiObj)
             rc = m_pIter.next(m_columnNum);
         }
         resetStatusFromLevel(0);
-        if (FTSError::isOK(rc)) {
+        // There is nothing to highlight if no phrase is matched in this column.
+        // The unmatched text is sliced below without tokenizing it.
+        if (FTSError::isOK(rc) && m_currentPhaseMatchCount > 0) {
             rc = apiObj.tokenize(m_input, this, tokenCallback);
         }
         if (m_bytePos < m_input.length()) {
@@ -198,10 +200,7 @@ void SubstringMatchInfo::process(FTS5AuxiliaryFunctionAPI &apiObj)
         if ((FTSError::isOK(rc) || FTSError::isDone(rc))
             && m_substringPhaseMatchCount >= m_currentPhaseMatchCount) {
             WCTAssert(m_substringPhaseMatchCount == m_currentPhaseMatchCount);
-            std::ostringstream stream;
-            generateOutput(stream);
-            StringView output = stream.str();
-            apiObj.setTextResult(output);
+            rc = generateOutput(apiObj);
         }
     }
     if (!FTSError::isOK(rc) && !FTSError::isDone(rc)) {
@@ -210,26 +209,70 @@ void SubstringMatchInfo::process(FTS5AuxiliaryFunctionAPI &apiObj)
     }
 }
 
-void SubstringMatchInfo::generateOutput(std::ostringstream &stream)
+static size_t numberOfDigits(int value)
 {
-    for (int i = 0; i < m_seperators.length(); i++) {
+    WCTAssert(value >= 0);
+    size_t count = 1;
+    while (value >= 10) {
+        value /= 10;
+        count++;
+    }
+    return count;
+}
+
+static char *writeDigits(char *buffer, int value)
+{
+    size_t count = numberOfDigits(value);
+    for (size_t i = count; i > 0; i--) {
+        buffer[i - 1] = (char) ('0' + value % 10);
+        value /= 10;
+    }
+    return buffer + count;
+}
+
+int SubstringMatchInfo::generateOutput(FTS5AuxiliaryFunctionAPI &apiObj)
+{
+    const int separatorCount = (int) m_seperators.length();
+    size_t length = separatorCount;
+    for (int i = 0; i < separatorCount; i++) {
+        length += numberOfDigits(m_matchIndex[i]);
+    }
+    for (const auto &output : m_output) {
+        length += output.first.length();
+        if (output.second >= 0) {
+            length += 3 + numberOfDigits(output.second);
+        }
+    }
+
+    char *buffer = apiObj.allocateTextResult(length);
+    if (buffer == nullptr) {
+        return FTSError::NoMem();
+    }
+    const char separator = m_seperators[0];
+    char *cursor = buffer;
+    for (int i = 0; i < separatorCount; i++) {
         if (i != 0) {
-            stream << ',';
+            *cursor++ = ',';
         }
-        stream << m_matchIndex[i];
+        cursor = writeDigits(cursor, m_matchIndex[i]);
     }
-    stream << m_seperators[0];
-    for (auto &output : m_output) {
+    *cursor++ = separator;
+    for (const auto &output : m_output) {
         if (output.second >= 0) {
-            stream << m_seperators[0];
-            stream << output.first;
-            stream << m_seperators[0];
-            stream << output.second;
-            stream << m_seperators[0];
-        } else {
-            stream << output.first;
+            *cursor++ = separator;
+        }
+        memcpy(cursor, output.first.data(), output.first.length());
+        cursor += output.first.length();
+        if (output.second >= 0) {
+            *cursor++ = separator;
+            cursor = writeDigits(cursor, output.second);
+            *cursor++ = separator;
         }
     }
+    WCTAssert(cursor == buffer + length);
+    *cursor = '\0';
+    apiObj.setAllocatedTextResult(buffer, length);
+    return FTSError::OK();
 }
 
 #pragma mark - PhaseInstIter
@@ -241,6 +284,15 @@ SubstringMatchInfo::PhaseInstIter::PhaseInstIter()
 
 SubstringMatchInfo::PhaseInstIter::~PhaseInstIter() = default;
 
+void SubstringMatchInfo::PhaseInstIter::reset()
+{
+    m_curPhaseStart = -1;
+    m_curPhaseEnd = -1;
+    m_iInst = 0;
+    m_nInst = 0;
+    m_phaseIndexes.clear();
+}
+
 int SubstringMatchInfo::PhaseInstIter::init(FTS5AuxiliaryFunctionAPI *apiObj)
 {
     m_apiObj = apiObj;
@@ -46,6 +46,7 @@ private:
         PhaseInstIter();
         ~PhaseInstIter();
         int init(FTS5AuxiliaryFunctionAPI *apiObj);
+        void reset();
         int next(int iCol);
 
     private:
@@ -59,7 +60,8 @@ private:
 
     void resetStatusFromLevel(int level);
     int checkSeperator(char sep);
-    void generateOutput(std::ostringstream &stream);
+    // Build the result in a buffer owned by sqlite to avoid copying.
+    int generateOutput(FTS5AuxiliaryFunctionAPI &apiObj);
 
     UnsafeStringView m_input;
     int m_columnNum;
@@ -76,6 +78,7 @@ private:
     int m_curLevelStartPos;
 
     StringView m_seperators;
+    // Reused across rows of the same statement.
     std::vector<std::pair<UnsafeStringView, int>> m_output;
     PhaseInstIter m_pIter;
 };
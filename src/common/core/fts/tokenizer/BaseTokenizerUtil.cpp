@@ -25,6 +25,11 @@
 #include "BaseTokenizerUtil.hpp"
 #include "Assertion.hpp"
 #include "FTSError.hpp"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 namespace WCDB {
 
@@ -92,25 +97,92 @@ void BaseTokenizerUtil::stepOneUnicode(const UnsafeStringView input,
     }
 }
 
+int BaseTokenizerUtil::stepAsciiRun(const UnsafeStringView input, UnicodeType unicodeType)
+{
+    WCTAssert(unicodeType == UnicodeType::BasicMultilingualPlaneLetter
+              || unicodeType == UnicodeType::BasicMultilingualPlaneDigit);
+    const unsigned char* buffer = reinterpret_cast<const unsigned char*>(input.data());
+    size_t length = input.length();
+    bool isLetter = unicodeType == UnicodeType::BasicMultilingualPlaneLetter;
+    size_t i = 0;
+    // Classify 16 bytes at a time, then find the exact end of the run one by one.
+#if defined(__SSE2__)
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + i));
+        __m128i matched;
+        if (isLetter) {
+            // Clearing 0x20 turns lowercase letters into uppercase ones. Non-ASCII bytes are negative.
+            __m128i upper = _mm_and_si128(chunk, _mm_set1_epi8((char) 0xDF));
+            matched = _mm_and_si128(_mm_cmpgt_epi8(upper, _mm_set1_epi8('A' - 1)),
+                                    _mm_cmplt_epi8(upper, _mm_set1_epi8('Z' + 1)));
+        } else {
+            matched = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)),
+                                    _mm_cmplt_epi8(chunk, _mm_set1_epi8('9' + 1)));
+        }
+        if (_mm_movemask_epi8(matched) != 0xFFFF) {
+            break;
+        }
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t chunk = vld1q_u8(buffer + i);
+        uint8x16_t matched;
+        if (isLetter) {
+            uint8x16_t upper = vandq_u8(chunk, vdupq_n_u8(0xDF));
+            matched = vcleq_u8(vsubq_u8(upper, vdupq_n_u8('A')), vdupq_n_u8('Z' - 'A'));
+        } else {
+            matched = vcleq_u8(vsubq_u8(chunk, vdupq_n_u8('0')), vdupq_n_u8(9));
+        }
+        if (vminvq_u8(matched) != 0xFF) {
+            break;
+        }
+    }
+#endif
+    for (; i < length; ++i) {
+        unsigned char theChar = buffer[i];
+        bool matched;
+        if (isLetter) {
+            matched = (theChar >= 0x41 && theChar <= 0x5a) || (theChar >= 0x61 && theChar <= 0x7a);
+        } else {
+            matched = theChar >= 0x30 && theChar <= 0x39;
+        }
+        if (!matched) {
+            break;
+        }
+    }
+    return (int) i;
+}
+
 #pragma mark - Symbol Detect
 
 bool BaseTokenizerUtil::isSymbol(UnicodeChar theChar)
 {
-    if (getSymbolDetector() == nullptr) {
+    const std::unique_ptr<SymbolTable>& table = getSymbolTable();
+    if (table == nullptr) {
         return false;
     }
-    return getSymbolDetector()(theChar);
+    return table->test(theChar);
 }
 
 void BaseTokenizerUtil::configSymbolDetector(SymbolDetector detector)
 {
-    getSymbolDetector() = detector;
+    if (detector == nullptr) {
+        getSymbolTable() = nullptr;
+        return;
+    }
+    std::unique_ptr<SymbolTable> table(new SymbolTable());
+    for (size_t theChar = 0; theChar < table->size(); ++theChar) {
+        if (detector((UnicodeChar) theChar)) {
+            table->set(theChar);
+        }
+    }
+    getSymbolTable() = std::move(table);
 }
 
-BaseTokenizerUtil::SymbolDetector& BaseTokenizerUtil::getSymbolDetector()
+std::unique_ptr<BaseTokenizerUtil::SymbolTable>& BaseTokenizerUtil::getSymbolTable()
 {
-    static SymbolDetector& g_detector = *new SymbolDetector();
-    return g_detector;
+    static std::unique_ptr<SymbolTable>& g_table = *new std::unique_ptr<SymbolTable>();
+    return g_table;
 }
 
 #pragma mark - Unicode Normalize
@@ -123,6 +195,11 @@ StringView BaseTokenizerUtil::normalizeToken(UnsafeStringView& token)
     return getUnicodeNormalizer()(token);
 }
 
+bool BaseTokenizerUtil::needNormalize()
+{
+    return getUnicodeNormalizer() != nullptr;
+}
+
 void BaseTokenizerUtil::configUnicodeNormalizer(UnicodeNormalizer normalizer)
 {
     getUnicodeNormalizer() = normalizer;
@@ -136,29 +213,42 @@ BaseTokenizerUtil::UnicodeNormalizer& BaseTokenizerUtil::getUnicodeNormalizer()
 
 #pragma mark - Pinyin
 
-const std::vector<StringView>
+CharacterDictionary::Values
 BaseTokenizerUtil::getPinYin(const UnsafeStringView& chineseCharacter)
 {
     WCTAssert(g_pinyinDict != nullptr || getPinyinConverter() != nullptr);
     if (g_pinyinDict != nullptr) {
-        auto iter = g_pinyinDict->find(chineseCharacter);
-        if (iter != g_pinyinDict->end()) {
-            return iter->second;
-        }
+        return g_pinyinDict->get(chineseCharacter);
     } else if (getPinyinConverter() != nullptr) {
-        return getPinyinConverter()(chineseCharacter);
+        return CharacterDictionary::Values(getPinyinConverter()(chineseCharacter));
     }
-    return std::vector<StringView>();
+    return CharacterDictionary::Values();
 }
 
-WCDB::StringViewMap<std::vector<WCDB::StringView>>* BaseTokenizerUtil::g_pinyinDict = nullptr;
+CharacterDictionary* BaseTokenizerUtil::g_pinyinDict = nullptr;
 void BaseTokenizerUtil::configPinyinDict(WCDB::StringViewMap<std::vector<WCDB::StringView>>* dict)
 {
     if (g_pinyinDict != nullptr) {
         delete g_pinyinDict;
         g_pinyinDict = nullptr;
     }
-    g_pinyinDict = dict;
+    if (dict != nullptr) {
+        g_pinyinDict = CharacterDictionary::build(*dict).release();
+        delete dict;
+    }
+}
+
+bool BaseTokenizerUtil::configPinyinDict(const UnsafeStringView& path)
+{
+    std::unique_ptr<CharacterDictionary> dictionary = CharacterDictionary::load(path);
+    if (dictionary == nullptr) {
+        return false;
+    }
+    if (g_pinyinDict != nullptr) {
+        delete g_pinyinDict;
+    }
+    g_pinyinDict = dictionary.release();
+    return true;
 }
 
 void BaseTokenizerUtil::configPinyinConverter(PinYinConverter converter)
@@ -178,14 +268,15 @@ BaseTokenizerUtil::PinYinConverter& BaseTokenizerUtil::getPinyinConverter()
 
 #pragma mark - Traditional Chinese
 
-const StringView BaseTokenizerUtil::getSimplifiedChinese(const UnsafeStringView& chineseCharacter)
+const UnsafeStringView
+BaseTokenizerUtil::getSimplifiedChinese(const UnsafeStringView& chineseCharacter)
 {
     WCTAssert(g_traditionalChineseDict != nullptr
               || getTraditionalChineseConverter() != nullptr);
     if (g_traditionalChineseDict != nullptr) {
-        auto iter = g_traditionalChineseDict->find(chineseCharacter);
-        if (iter != g_traditionalChineseDict->end() && iter->second.length() > 0) {
-            return iter->second;
+        CharacterDictionary::Values values = g_traditionalChineseDict->get(chineseCharacter);
+        if (!values.empty() && values.at(0).length() > 0) {
+            return values.at(0);
         }
     } else if (getTraditionalChineseConverter() != nullptr) {
         const StringView traditionalChinese
@@ -194,17 +285,33 @@ const StringView BaseTokenizerUtil::getSimplifiedChinese(const UnsafeStringView&
             return traditionalChinese;
         }
     }
-    return StringView(chineseCharacter);
+    return chineseCharacter;
 }
 
-WCDB::StringViewMap<WCDB::StringView>* BaseTokenizerUtil::g_traditionalChineseDict = nullptr;
+CharacterDictionary* BaseTokenizerUtil::g_traditionalChineseDict = nullptr;
 void BaseTokenizerUtil::configTraditionalChineseDict(WCDB::StringViewMap<WCDB::StringView>* dict)
 {
     if (g_traditionalChineseDict != nullptr) {
         delete g_traditionalChineseDict;
         g_traditionalChineseDict = nullptr;
     }
-    g_traditionalChineseDict = dict;
+    if (dict != nullptr) {
+        g_traditionalChineseDict = CharacterDictionary::build(*dict).release();
+        delete dict;
+    }
+}
+
+bool BaseTokenizerUtil::configTraditionalChineseDict(const UnsafeStringView& path)
+{
+    std::unique_ptr<CharacterDictionary> dictionary = CharacterDictionary::load(path);
+    if (dictionary == nullptr) {
+        return false;
+    }
+    if (g_traditionalChineseDict != nullptr) {
+        delete g_traditionalChineseDict;
+    }
+    g_traditionalChineseDict = dictionary.release();
+    return true;
 }
 
 void BaseTokenizerUtil::configTraditionalChineseConverter(TraditionalChineseConverter converter)
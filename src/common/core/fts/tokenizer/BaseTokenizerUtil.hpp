@@ -24,8 +24,11 @@
 
 #pragma once
 
+#include "CharacterDictionary.hpp"
 #include "StringView.hpp"
+#include <bitset>
 #include <functional>
+#include <memory>
 #include <vector>
 
 namespace WCDB {
@@ -42,35 +45,50 @@ public:
     };
     static void
     stepOneUnicode(const UnsafeStringView input, UnicodeType& unicodeType, int& unicodeLength);
+    // Return the length of the leading ASCII letters or digits, whose type is `unicodeType`.
+    static int stepAsciiRun(const UnsafeStringView input, UnicodeType unicodeType);
 
     typedef unsigned short UnicodeChar;
     typedef std::function<bool(UnicodeChar)> SymbolDetector;
+    // The detector is called for every unicode char once when configured, and the results are cached in a table.
     static void configSymbolDetector(SymbolDetector detector);
     static bool isSymbol(UnicodeChar theChar);
 
     typedef std::function<StringView(const UnsafeStringView&)> UnicodeNormalizer;
     static void configUnicodeNormalizer(UnicodeNormalizer normalizer);
     static StringView normalizeToken(UnsafeStringView& token);
+    // Tokens can be used as they are if there is no normalizer.
+    static bool needNormalize();
 
-    static const std::vector<StringView> getPinYin(const UnsafeStringView& chineseCharacter);
+    static CharacterDictionary::Values getPinYin(const UnsafeStringView& chineseCharacter);
     typedef std::function<std::vector<StringView>(const UnsafeStringView&)> PinYinConverter;
     static void configPinyinConverter(PinYinConverter converter);
+    // The dict is compiled into a `CharacterDictionary` and then released.
     static void
     configPinyinDict(WCDB::StringViewMap<std::vector<WCDB::StringView>>* dict);
+    // Load a dictionary file saved by `CharacterDictionary::save`.
+    // Only available in C++. Objc, Swift and Java configure the dict with a map.
+    static bool configPinyinDict(const UnsafeStringView& path);
 
-    static const StringView getSimplifiedChinese(const UnsafeStringView& chineseCharacter);
+    // The input character is returned if there is no simplified one.
+    static const UnsafeStringView getSimplifiedChinese(const UnsafeStringView& chineseCharacter);
     typedef std::function<const StringView(const UnsafeStringView&)> TraditionalChineseConverter;
     static void configTraditionalChineseConverter(TraditionalChineseConverter converter);
+    // The dict is compiled into a `CharacterDictionary` and then released.
     static void configTraditionalChineseDict(WCDB::StringViewMap<WCDB::StringView>* dict);
+    // Load a dictionary file saved by `CharacterDictionary::save`.
+    // Only available in C++. Objc, Swift and Java configure the dict with a map.
+    static bool configTraditionalChineseDict(const UnsafeStringView& path);
 
 private:
     static PinYinConverter& getPinyinConverter();
-    static WCDB::StringViewMap<std::vector<WCDB::StringView>>* g_pinyinDict;
+    static CharacterDictionary* g_pinyinDict;
 
-    static SymbolDetector& getSymbolDetector();
+    typedef std::bitset<1 << (sizeof(UnicodeChar) * 8)> SymbolTable;
+    static std::unique_ptr<SymbolTable>& getSymbolTable();
     static UnicodeNormalizer& getUnicodeNormalizer();
     static TraditionalChineseConverter& getTraditionalChineseConverter();
-    static WCDB::StringViewMap<WCDB::StringView>* g_traditionalChineseDict;
+    static CharacterDictionary* g_traditionalChineseDict;
 };
 
 } //namespace WCDB
@@ -0,0 +1,376 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CharacterDictionary.hpp"
+#include "Assertion.hpp"
+#include "CoreConst.h"
+#include "Data.hpp"
+#include "FileHandle.hpp"
+#include "FileManager.hpp"
+#include "Notifier.hpp"
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+namespace WCDB {
+
+namespace {
+
+int compareKey(const char *left, size_t leftLength, const char *right, size_t rightLength)
+{
+    int result = memcmp(left, right, std::min(leftLength, rightLength));
+    if (result != 0) {
+        return result;
+    }
+    if (leftLength == rightLength) {
+        return 0;
+    }
+    return leftLength < rightLength ? -1 : 1;
+}
+
+} // namespace
+
+#pragma mark - Initialize
+CharacterDictionary::CharacterDictionary()
+: m_header(nullptr)
+, m_indexes(nullptr)
+, m_otherKeys(nullptr)
+, m_values(nullptr)
+, m_pool(nullptr)
+{
+}
+
+CharacterDictionary::~CharacterDictionary() = default;
+
+bool CharacterDictionary::getIndexedCodePoint(const UnsafeStringView &character, uint32_t &codePoint)
+{
+    // Overlong encodings are not indexed, so that each indexed code point has only one key.
+    const unsigned char *buffer = reinterpret_cast<const unsigned char *>(character.data());
+    switch (character.length()) {
+    case 1:
+        if (buffer[0] >= 0x80) {
+            return false;
+        }
+        codePoint = buffer[0];
+        return true;
+    case 2:
+        if (buffer[0] < 0xC2 || buffer[0] > 0xDF || (buffer[1] & 0xC0) != 0x80) {
+            return false;
+        }
+        codePoint = ((buffer[0] & 0x1F) << 6) | (buffer[1] & 0x3F);
+        return true;
+    case 3:
+        if ((buffer[0] & 0xF0) != 0xE0 || (buffer[1] & 0xC0) != 0x80
+            || (buffer[2] & 0xC0) != 0x80) {
+            return false;
+        }
+        codePoint = ((buffer[0] & 0x0F) << 12) | ((buffer[1] & 0x3F) << 6) | (buffer[2] & 0x3F);
+        return codePoint >= 0x800;
+    default:
+        return false;
+    }
+}
+
+#pragma mark - Build
+std::unique_ptr<CharacterDictionary> CharacterDictionary::build(const StringViewMap<StringView> &map)
+{
+    Map converted;
+    for (const auto &iter : map) {
+        converted[iter.first].push_back(iter.second);
+    }
+    return build(converted);
+}
+
+std::unique_ptr<CharacterDictionary> CharacterDictionary::build(const Map &map)
+{
+    std::map<uint32_t, const std::vector<StringView> *> indexed;
+    std::vector<std::pair<UnsafeStringView, const std::vector<StringView> *>> others;
+    for (const auto &iter : map) {
+        uint32_t codePoint = 0;
+        if (getIndexedCodePoint(iter.first, codePoint)) {
+            indexed[codePoint] = &iter.second;
+        } else {
+            others.emplace_back(iter.first, &iter.second);
+        }
+    }
+    std::sort(others.begin(), others.end(), [](const auto &left, const auto &right) {
+        return compareKey(left.first.data(), left.first.length(), right.first.data(), right.first.length())
+               < 0;
+    });
+
+    std::vector<uint32_t> indexes;
+    std::vector<OtherKey> otherKeys;
+    std::vector<Value> values;
+    std::vector<char> pool;
+    StringViewMap<uint32_t> offsets;
+    // Pinyins are highly repeated, so the same strings share the same space in pool.
+    auto appendString = [&](const UnsafeStringView &string) -> uint32_t {
+        auto iter = offsets.find(string);
+        if (iter != offsets.end()) {
+            return iter->second;
+        }
+        uint32_t offset = (uint32_t) pool.size();
+        pool.insert(pool.end(), string.data(), string.data() + string.length());
+        pool.push_back('\0');
+        offsets.emplace(string, offset);
+        return offset;
+    };
+    auto appendValues = [&](const std::vector<StringView> &strings) {
+        for (const auto &string : strings) {
+            Value value;
+            value.offset = appendString(string);
+            value.length = (uint32_t) string.length();
+            values.push_back(value);
+        }
+    };
+
+    uint32_t firstCodePoint = 0;
+    uint32_t numberOfCodePoints = 0;
+    if (!indexed.empty()) {
+        firstCodePoint = indexed.begin()->first;
+        numberOfCodePoints = indexed.rbegin()->first - firstCodePoint + 1;
+    }
+    indexes.reserve(numberOfCodePoints + 1);
+    auto indexedIter = indexed.begin();
+    for (uint32_t i = 0; i < numberOfCodePoints; ++i) {
+        indexes.push_back((uint32_t) values.size());
+        if (indexedIter != indexed.end() && indexedIter->first == firstCodePoint + i) {
+            appendValues(*indexedIter->second);
+            ++indexedIter;
+        }
+    }
+    indexes.push_back((uint32_t) values.size());
+    for (const auto &other : others) {
+        OtherKey otherKey;
+        otherKey.offset = appendString(other.first);
+        otherKey.length = (uint32_t) other.first.length();
+        otherKey.begin = (uint32_t) values.size();
+        appendValues(*other.second);
+        otherKey.end = (uint32_t) values.size();
+        otherKeys.push_back(otherKey);
+    }
+
+    Header header;
+    header.magic = magic;
+    header.version = version;
+    header.firstCodePoint = firstCodePoint;
+    header.numberOfCodePoints = numberOfCodePoints;
+    header.numberOfOtherKeys = (uint32_t) otherKeys.size();
+    header.numberOfValues = (uint32_t) values.size();
+    header.poolSize = (uint32_t) pool.size();
+
+    size_t indexesSize = indexes.size() * sizeof(uint32_t);
+    size_t otherKeysSize = otherKeys.size() * sizeof(OtherKey);
+    size_t valuesSize = values.size() * sizeof(Value);
+    Data data(sizeof(Header) + indexesSize + otherKeysSize + valuesSize + pool.size());
+    if (data.empty()) {
+        return nullptr;
+    }
+    unsigned char *cursor = data.buffer();
+    memcpy(cursor, &header, sizeof(Header));
+    cursor += sizeof(Header);
+    memcpy(cursor, indexes.data(), indexesSize);
+    cursor += indexesSize;
+    if (otherKeysSize > 0) {
+        memcpy(cursor, otherKeys.data(), otherKeysSize);
+        cursor += otherKeysSize;
+    }
+    if (valuesSize > 0) {
+        memcpy(cursor, values.data(), valuesSize);
+        cursor += valuesSize;
+    }
+    if (!pool.empty()) {
+        memcpy(cursor, pool.data(), pool.size());
+    }
+
+    std::unique_ptr<CharacterDictionary> dictionary(new CharacterDictionary());
+    bool attached = dictionary->attach(data);
+    WCTAssert(attached);
+    if (!attached) {
+        return nullptr;
+    }
+    return dictionary;
+}
+
+#pragma mark - File
+std::unique_ptr<CharacterDictionary> CharacterDictionary::load(const UnsafeStringView &path)
+{
+    FileHandle fileHandle(path);
+    if (!fileHandle.open(FileHandle::Mode::ReadOnly)) {
+        return nullptr;
+    }
+    UnsafeData data = fileHandle.mapOrReadAllData();
+    fileHandle.close();
+    if (data.empty()) {
+        return nullptr;
+    }
+    std::unique_ptr<CharacterDictionary> dictionary(new CharacterDictionary());
+    if (!dictionary->attach(data)) {
+        Error error(Error::Code::Corrupt, Error::Level::Warning, "Corrupted character dictionary");
+        error.infos.insert_or_assign(ErrorStringKeyPath, path);
+        Notifier::shared().notify(error);
+        return nullptr;
+    }
+    return dictionary;
+}
+
+bool CharacterDictionary::save(const UnsafeStringView &path) const
+{
+    FileHandle fileHandle(path);
+    if (!fileHandle.open(FileHandle::Mode::OverWrite)) {
+        return false;
+    }
+    bool succeed = fileHandle.write(m_data);
+    fileHandle.close();
+    FileManager::setFileProtectionCompleteUntilFirstUserAuthenticationIfNeeded(path);
+    return succeed;
+}
+
+bool CharacterDictionary::attach(const UnsafeData &data)
+{
+    if (data.size() < sizeof(Header)) {
+        return false;
+    }
+    const Header *header = reinterpret_cast<const Header *>(data.buffer());
+    if (header->magic != magic || header->version != version
+        || header->numberOfCodePoints > 0x10000) {
+        return false;
+    }
+    size_t expectedSize = sizeof(Header)
+                          + ((size_t) header->numberOfCodePoints + 1) * sizeof(uint32_t)
+                          + (size_t) header->numberOfOtherKeys * sizeof(OtherKey)
+                          + (size_t) header->numberOfValues * sizeof(Value)
+                          + (size_t) header->poolSize;
+    if (data.size() != expectedSize) {
+        return false;
+    }
+    const unsigned char *cursor = data.buffer() + sizeof(Header);
+    const uint32_t *indexes = reinterpret_cast<const uint32_t *>(cursor);
+    cursor += ((size_t) header->numberOfCodePoints + 1) * sizeof(uint32_t);
+    const OtherKey *otherKeys = reinterpret_cast<const OtherKey *>(cursor);
+    cursor += (size_t) header->numberOfOtherKeys * sizeof(OtherKey);
+    const Value *values = reinterpret_cast<const Value *>(cursor);
+    cursor += (size_t) header->numberOfValues * sizeof(Value);
+    const char *pool = reinterpret_cast<const char *>(cursor);
+
+    // Verify all the offsets once, so that looking up needs no check.
+    auto isLegalString = [&](uint32_t offset, uint32_t length) {
+        return (uint64_t) offset + length < header->poolSize && pool[offset + length] == '\0';
+    };
+    for (uint32_t i = 0; i < header->numberOfCodePoints; ++i) {
+        if (indexes[i] > indexes[i + 1]) {
+            return false;
+        }
+    }
+    if (indexes[0] != 0 || indexes[header->numberOfCodePoints] > header->numberOfValues) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->numberOfOtherKeys; ++i) {
+        const OtherKey &otherKey = otherKeys[i];
+        if (!isLegalString(otherKey.offset, otherKey.length)
+            || otherKey.begin > otherKey.end || otherKey.end > header->numberOfValues) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header->numberOfValues; ++i) {
+        if (!isLegalString(values[i].offset, values[i].length)) {
+            return false;
+        }
+    }
+
+    m_data = data;
+    m_header = header;
+    m_indexes = indexes;
+    m_otherKeys = otherKeys;
+    m_values = values;
+    m_pool = pool;
+    return true;
+}
+
+#pragma mark - Lookup
+CharacterDictionary::Values CharacterDictionary::get(const UnsafeStringView &character) const
+{
+    uint32_t codePoint = 0;
+    if (getIndexedCodePoint(character, codePoint)) {
+        if (codePoint < m_header->firstCodePoint
+            || codePoint - m_header->firstCodePoint >= m_header->numberOfCodePoints) {
+            return Values();
+        }
+        uint32_t index = codePoint - m_header->firstCodePoint;
+        return Values(this, m_indexes[index], m_indexes[index + 1]);
+    }
+    const OtherKey *end = m_otherKeys + m_header->numberOfOtherKeys;
+    const OtherKey *iter = std::lower_bound(
+    m_otherKeys, end, character, [this](const OtherKey &otherKey, const UnsafeStringView &key) {
+        return compareKey(m_pool + otherKey.offset, otherKey.length, key.data(), key.length()) < 0;
+    });
+    if (iter == end
+        || compareKey(m_pool + iter->offset, iter->length, character.data(), character.length())
+           != 0) {
+        return Values();
+    }
+    return Values(this, iter->begin, iter->end);
+}
+
+#pragma mark - Values
+CharacterDictionary::Values::Values() : m_dictionary(nullptr), m_begin(0), m_end(0)
+{
+}
+
+CharacterDictionary::Values::Values(const CharacterDictionary *dictionary, uint32_t begin, uint32_t end)
+: m_dictionary(dictionary), m_begin(begin), m_end(end)
+{
+}
+
+CharacterDictionary::Values::Values(std::vector<StringView> &&values)
+: m_dictionary(nullptr), m_begin(0), m_end(0), m_converted(std::move(values))
+{
+}
+
+CharacterDictionary::Values::~Values() = default;
+
+size_t CharacterDictionary::Values::size() const
+{
+    if (m_dictionary != nullptr) {
+        return m_end - m_begin;
+    }
+    return m_converted.size();
+}
+
+bool CharacterDictionary::Values::empty() const
+{
+    return size() == 0;
+}
+
+UnsafeStringView CharacterDictionary::Values::at(size_t index) const
+{
+    WCTAssert(index < size());
+    if (m_dictionary != nullptr) {
+        const Value &value = m_dictionary->m_values[m_begin + index];
+        return UnsafeStringView(m_dictionary->m_pool + value.offset, value.length);
+    }
+    return m_converted[index];
+}
+
+} //namespace WCDB
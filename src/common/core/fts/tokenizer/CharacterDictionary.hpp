@@ -0,0 +1,111 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "StringView.hpp"
+#include "UnsafeData.hpp"
+#include <memory>
+#include <vector>
+
+namespace WCDB {
+
+/*
+ A read-only dictionary from a character to a list of strings, such as the pinyins of a Chinese character.
+ Characters in BMP are indexed by code point, and all the strings are stored in one contiguous pool,
+ so that looking up neither compares strings nor allocates memory.
+ It can be saved as a binary file in native byte order, and be loaded back via mmap.
+ */
+class WCDB_API CharacterDictionary final {
+public:
+    ~CharacterDictionary();
+    CharacterDictionary(const CharacterDictionary &) = delete;
+    CharacterDictionary &operator=(const CharacterDictionary &) = delete;
+
+    typedef StringViewMap<std::vector<StringView>> Map;
+    static std::unique_ptr<CharacterDictionary> build(const Map &map);
+    static std::unique_ptr<CharacterDictionary> build(const StringViewMap<StringView> &map);
+    static std::unique_ptr<CharacterDictionary> load(const UnsafeStringView &path);
+    bool save(const UnsafeStringView &path) const;
+
+    class WCDB_API Values final {
+    public:
+        Values();
+        Values(const CharacterDictionary *dictionary, uint32_t begin, uint32_t end);
+        // For the values generated by converter.
+        Values(std::vector<StringView> &&values);
+        ~Values();
+
+        size_t size() const;
+        bool empty() const;
+        // The returned string is null-terminated.
+        UnsafeStringView at(size_t index) const;
+
+    private:
+        const CharacterDictionary *m_dictionary;
+        uint32_t m_begin;
+        uint32_t m_end;
+        std::vector<StringView> m_converted;
+    };
+    // The values are valid as long as the dictionary is alive.
+    Values get(const UnsafeStringView &character) const;
+
+private:
+    CharacterDictionary();
+    bool attach(const UnsafeData &data);
+    // Keys of single character in BMP are indexed by code point. Others are binary searched.
+    static bool getIndexedCodePoint(const UnsafeStringView &character, uint32_t &codePoint);
+
+    static constexpr const uint32_t magic = 0x57434344;
+    static constexpr const uint32_t version = 0x01000000; //1.0.0.0
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t firstCodePoint;
+        uint32_t numberOfCodePoints;
+        uint32_t numberOfOtherKeys;
+        uint32_t numberOfValues;
+        uint32_t poolSize;
+    };
+    struct OtherKey {
+        uint32_t offset;
+        uint32_t length;
+        uint32_t begin;
+        uint32_t end;
+    };
+    struct Value {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    UnsafeData m_data;
+    const Header *m_header;
+    // Values of the n-th code point are in range [m_indexes[n], m_indexes[n + 1]).
+    const uint32_t *m_indexes;
+    const OtherKey *m_otherKeys;
+    const Value *m_values;
+    const char *m_pool;
+};
+
+} //namespace WCDB
@@ -47,6 +47,8 @@ OneOrBinaryTokenizer::OneOrBinaryTokenizer(const char *const *azArg, int nArg, v
 , m_cursorTokenType(UnicodeType::None)
 , m_preTokenType(UnicodeType::None)
 , m_subTokensCursor(0)
+, m_subTokenLength(0)
+, m_nextSubTokenLength(0)
 , m_subTokensDoubleChar(true)
 , m_tokenLength(0)
 , m_needBinary(false)
@@ -79,8 +81,9 @@ void OneOrBinaryTokenizer::loadInput(const char *pText, int nText, int flags)
     m_cursorTokenLength = 0;
     m_cursorTokenType = UnicodeType::None;
     m_preTokenType = UnicodeType::None;
-    m_subTokensLengthArray.clear();
     m_subTokensCursor = 0;
+    m_subTokenLength = 0;
+    m_nextSubTokenLength = 0;
     m_subTokensDoubleChar = true;
     m_token.clear();
     m_tokenLength = 0;
@@ -113,7 +116,7 @@ int OneOrBinaryTokenizer::stepNextToken()
     if (m_position == 0) {
         cursorStep();
     }
-    if (m_subTokensLengthArray.empty()) {
+    if (m_subTokenLength == 0) {
         if (!m_needSymbol) { //Skip symbol
             while (m_cursorTokenType == UnicodeType::BasicMultilingualPlaneSymbol) {
                 cursorStep();
@@ -124,9 +127,7 @@ int OneOrBinaryTokenizer::stepNextToken()
         case UnicodeType::BasicMultilingualPlaneLetter:
         case UnicodeType::BasicMultilingualPlaneDigit:
             m_startOffset = m_cursor;
-            do {
-                cursorStep();
-            } while (m_cursorTokenType == m_preTokenType);
+            cursorStepRun();
             m_endOffset = m_cursor;
             m_tokenLength = m_endOffset - m_startOffset;
             break;
@@ -134,11 +135,9 @@ int OneOrBinaryTokenizer::stepNextToken()
         case UnicodeType::BasicMultilingualPlaneOther:
         case UnicodeType::AuxiliaryPlaneOther:
             m_subTokensCursor = m_cursor;
+            m_subTokenLength = m_cursorTokenLength;
             m_subTokensDoubleChar = m_needBinary;
-            do {
-                m_subTokensLengthArray.push_back(m_cursorTokenLength);
-                cursorStep();
-            } while (m_cursorTokenType == m_preTokenType);
+            subTokensLookAhead();
             subTokensStep();
             break;
         case UnicodeType::None:
@@ -164,32 +163,49 @@ void OneOrBinaryTokenizer::cursorStep()
     m_cursorTokenLength = 0;
 }
 
+void OneOrBinaryTokenizer::cursorStepRun()
+{
+    // Letters and digits are all single-byte, so the whole run can be skipped at once.
+    WCTAssert(m_cursorTokenLength == 1);
+    m_cursorTokenLength = BaseTokenizerUtil::stepAsciiRun(
+    UnsafeStringView(m_input + m_cursor, m_inputLength - m_cursor), m_cursorTokenType);
+    cursorStep();
+}
+
 void OneOrBinaryTokenizer::lemmatization(const char *input, int inputLength)
 {
     // tolower only. You can implement your own lemmatization.
-    m_token.assign(input, input + inputLength);
-    std::transform(m_token.begin(), m_token.end(), m_token.begin(), ::tolower);
+    // The buffer is reused across tokens, so it is only reallocated for a longer token.
+    m_token.resize(inputLength);
+    std::transform(input, input + inputLength, m_token.begin(), ::tolower);
+    m_tokenLength = inputLength;
     if (!m_skipStemming) {
         m_tokenLength = porterStem(m_token.data(), 0, m_tokenLength - 1) + 1;
     }
 }
 
+void OneOrBinaryTokenizer::subTokensLookAhead()
+{
+    cursorStep();
+    m_nextSubTokenLength
+    = m_cursorTokenType == m_preTokenType ? m_cursorTokenLength : 0;
+}
+
 void OneOrBinaryTokenizer::subTokensStep()
 {
     m_startOffset = m_subTokensCursor;
-    m_tokenLength = m_subTokensLengthArray[0];
-    if (m_subTokensDoubleChar) {
-        if (m_subTokensLengthArray.size() > 1) {
-            m_tokenLength += m_subTokensLengthArray[1];
-            if (m_needBinary) {
-                m_subTokensDoubleChar = false;
-            }
-        } else {
-            m_subTokensLengthArray.clear();
-        }
+    m_tokenLength = m_subTokenLength;
+    if (m_subTokensDoubleChar && m_nextSubTokenLength > 0) {
+        // Binary token. The cursor stays for the following single token.
+        WCTAssert(m_needBinary);
+        m_tokenLength += m_nextSubTokenLength;
+        m_subTokensDoubleChar = false;
     } else {
-        m_subTokensCursor += m_subTokensLengthArray[0];
-        m_subTokensLengthArray.erase(m_subTokensLengthArray.begin());
+        m_subTokensCursor += m_subTokenLength;
+        m_subTokenLength = m_nextSubTokenLength;
+        if (m_subTokenLength > 0) {
+            subTokensLookAhead();
+        }
         if (m_needBinary) {
             m_subTokensDoubleChar = true;
         }
@@ -197,39 +213,51 @@ void OneOrBinaryTokenizer::subTokensStep()
     m_endOffset = m_startOffset + m_tokenLength;
 }
 
+void OneOrBinaryTokenizer::appendNormalizedToken(UnsafeStringView token)
+{
+    if (BaseTokenizerUtil::needNormalize()) {
+        StringView normalizedToken = BaseTokenizerUtil::normalizeToken(token);
+        m_token.insert(m_token.end(),
+                       normalizedToken.data(),
+                       normalizedToken.data() + normalizedToken.length());
+    } else {
+        m_token.insert(m_token.end(), token.data(), token.data() + token.length());
+    }
+}
+
 void OneOrBinaryTokenizer::genToken()
 {
     if (m_preTokenType == UnicodeType::BasicMultilingualPlaneLetter) {
         lemmatization(m_input + m_startOffset, m_tokenLength);
-    } else if (m_preTokenType != UnicodeType::BasicMultilingualPlaneOther
-               || !m_needSimplifiedChinese) {
-        UnsafeStringView token = UnsafeStringView(m_input + m_startOffset, m_tokenLength);
-        StringView nomalizeToken = BaseTokenizerUtil::normalizeToken(token);
-        m_tokenLength = (int) nomalizeToken.length();
-        m_token.assign(nomalizeToken.data(), nomalizeToken.data() + m_tokenLength);
+        m_position++;
+        return;
+    }
+    m_token.clear();
+    UnsafeStringView token = UnsafeStringView(m_input + m_startOffset, m_tokenLength);
+    if (m_preTokenType != UnicodeType::BasicMultilingualPlaneOther || !m_needSimplifiedChinese) {
+        appendNormalizedToken(token);
     } else if (!m_needBinary || m_subTokensDoubleChar) {
-        UnsafeStringView token = UnsafeStringView(m_input + m_startOffset, m_tokenLength);
-        StringView nomalizeToken = BaseTokenizerUtil::normalizeToken(token);
-        StringView simplifiedToken = BaseTokenizerUtil::getSimplifiedChinese(nomalizeToken);
-        m_tokenLength = (int) simplifiedToken.length();
-        m_token.assign(simplifiedToken.data(), simplifiedToken.data() + m_tokenLength);
+        if (BaseTokenizerUtil::needNormalize()) {
+            StringView nomalizeToken = BaseTokenizerUtil::normalizeToken(token);
+            UnsafeStringView simplifiedToken
+            = BaseTokenizerUtil::getSimplifiedChinese(nomalizeToken);
+            m_token.assign(simplifiedToken.data(),
+                           simplifiedToken.data() + simplifiedToken.length());
+        } else {
+            UnsafeStringView simplifiedToken = BaseTokenizerUtil::getSimplifiedChinese(token);
+            m_token.assign(simplifiedToken.data(),
+                           simplifiedToken.data() + simplifiedToken.length());
+        }
     } else {
+        // Binary token, whose characters are the current sub token and the next one.
         UnsafeStringView firstChar
-        = UnsafeStringView(m_input + m_startOffset, m_subTokensLengthArray[0]);
+        = UnsafeStringView(m_input + m_startOffset, m_subTokenLength);
         UnsafeStringView secondChar = UnsafeStringView(
-        m_input + m_startOffset + m_subTokensLengthArray[0], m_subTokensLengthArray[1]);
-        firstChar = BaseTokenizerUtil::getSimplifiedChinese(firstChar);
-        secondChar = BaseTokenizerUtil::getSimplifiedChinese(secondChar);
-        StringView normalizeFirstChar = BaseTokenizerUtil::normalizeToken(firstChar);
-        StringView normalizeSecondChar = BaseTokenizerUtil::normalizeToken(secondChar);
-        m_tokenLength
-        = (int) normalizeFirstChar.length() + (int) normalizeSecondChar.length();
-        m_token.assign(normalizeFirstChar.data(),
-                       normalizeFirstChar.data() + normalizeFirstChar.length());
-        m_token.insert(m_token.end(),
-                       normalizeSecondChar.data(),
-                       normalizeSecondChar.data() + normalizeSecondChar.length());
+        m_input + m_startOffset + m_subTokenLength, m_nextSubTokenLength);
+        appendNormalizedToken(BaseTokenizerUtil::getSimplifiedChinese(firstChar));
+        appendNormalizedToken(BaseTokenizerUtil::getSimplifiedChinese(secondChar));
     }
+    m_tokenLength = (int) m_token.size();
     m_position++;
 }
 
@@ -51,8 +51,10 @@ private:
     UnicodeType m_cursorTokenType;
     UnicodeType m_preTokenType;
 
-    std::vector<int> m_subTokensLengthArray;
+    // A run of CJK characters or symbols is tokenized in place, looking ahead one character at most.
     int m_subTokensCursor;
+    int m_subTokenLength;
+    int m_nextSubTokenLength;
     bool m_subTokensDoubleChar;
 
     std::vector<char> m_token;
@@ -65,9 +67,12 @@ private:
     bool m_skipStemming;
 
     void cursorStep();
+    void cursorStepRun();
+    void subTokensLookAhead();
     void subTokensStep();
 
     void lemmatization(const char *input, int inputLength);
+    void appendNormalizedToken(UnsafeStringView token);
     void genToken();
 };
 
@@ -45,10 +45,13 @@ PinyinTokenizer::PinyinTokenizer(const char *const *azArg, int nArg, void *pCtx)
 , m_normalTokenLength(0)
 , m_pinyinTokenIndex(0)
 , m_needSymbol(false)
+, m_needPrefix(false)
 {
     for (int i = 0; i < nArg; i++) {
         if (strcmp(azArg[i], BuiltinTokenizer::Parameter::NeedSymbol) == 0) {
             m_needSymbol = true;
+        } else if (strcmp(azArg[i], BuiltinTokenizer::Parameter::PinyinPrefix) == 0) {
+            m_needPrefix = true;
         }
     }
 }
@@ -104,7 +107,7 @@ const char **ppToken, int *nToken, int *iStart, int *iEnd, int *tflags, int *iPo
         if (m_pinyinTokenIndex > 0) {
             *tflags = FTS5_TOKEN_COLOCATED;
         }
-        const StringView &pinyinToken = m_pinyinTokenArr[m_pinyinTokenIndex];
+        const UnsafeStringView &pinyinToken = m_pinyinTokenArr[m_pinyinTokenIndex];
         *ppToken = pinyinToken.data();
         *nToken = (int) pinyinToken.length();
         *iStart = m_startOffset;
@@ -138,9 +141,7 @@ int PinyinTokenizer::stepNextToken()
     case UnicodeType::BasicMultilingualPlaneOther:
         m_startOffset = m_cursor;
         if (m_preTokenType == UnicodeType::BasicMultilingualPlaneLetter) {
-            do {
-                cursorStep();
-            } while (m_cursorTokenType == m_preTokenType);
+            cursorStepRun();
         } else {
             cursorStep();
         }
@@ -167,12 +168,24 @@ void PinyinTokenizer::cursorStep()
     m_cursorTokenLength = 0;
 }
 
+void PinyinTokenizer::cursorStepRun()
+{
+    // Letters are all single-byte, so the whole run can be skipped at once.
+    WCTAssert(m_cursorTokenLength == 1);
+    m_cursorTokenLength = BaseTokenizerUtil::stepAsciiRun(
+    UnsafeStringView(m_input + m_cursor, m_inputLength - m_cursor), m_cursorTokenType);
+    cursorStep();
+}
+
 void PinyinTokenizer::genNormalToken()
 {
-    m_normalToken.assign(m_input + m_startOffset, m_input + m_endOffset);
+    // The buffer is reused across tokens, so it is only reallocated for a longer token.
     if (m_preTokenType == UnicodeType::BasicMultilingualPlaneLetter) {
+        m_normalToken.resize(m_normalTokenLength);
         std::transform(
-        m_normalToken.begin(), m_normalToken.end(), m_normalToken.begin(), ::tolower);
+        m_input + m_startOffset, m_input + m_endOffset, m_normalToken.begin(), ::tolower);
+    } else {
+        m_normalToken.assign(m_input + m_startOffset, m_input + m_endOffset);
     }
 }
 
@@ -180,37 +193,51 @@ void PinyinTokenizer::genPinyinToken()
 {
     m_pinyinTokenArr.clear();
     m_pinyinTokenIndex = 0;
-    StringViewSet pinyinSet;
     UnsafeStringView token = UnsafeStringView(m_input + m_startOffset, m_normalTokenLength);
-    const std::vector<StringView> pinyinPtr = BaseTokenizerUtil::getPinYin(token);
-    if (pinyinPtr.size() == 0) {
+    const CharacterDictionary::Values pinyins = BaseTokenizerUtil::getPinYin(token);
+    if (pinyins.size() == 0) {
         if (m_preTokenType == UnicodeType::BasicMultilingualPlaneSymbol
             && token.length() > 0) {
             m_pinyinTokenArr.emplace_back(token);
         }
         return;
     }
-    for (const StringView &pinyin : pinyinPtr) {
+    for (size_t i = 0; i < pinyins.size(); ++i) {
+        UnsafeStringView pinyin = pinyins.at(i);
         if (pinyin.length() == 0) {
             continue;
         }
-        if (pinyinSet.find(pinyin) != pinyinSet.end()) {
+        if (containsPinyinToken(pinyin)) {
             continue;
         }
         //full pinyin
         m_pinyinTokenArr.emplace_back(pinyin);
-        pinyinSet.emplace(pinyin);
         if (pinyin.length() <= 1) {
             continue;
         }
-        UnsafeStringView shortPinyin = UnsafeStringView(pinyin.data(), 1);
-        if (pinyinSet.find(shortPinyin) != pinyinSet.end()) {
-            continue;
+        //prefixes of full pinyin
+        if (m_needPrefix) {
+            for (size_t length = pinyin.length() - 1; length > 1; --length) {
+                appendPinyinToken(UnsafeStringView(pinyin.data(), length));
+            }
         }
         //short pinyin
-        pinyinSet.emplace(shortPinyin);
-        m_pinyinTokenArr.emplace_back(shortPinyin);
+        appendPinyinToken(UnsafeStringView(pinyin.data(), 1));
+    }
+}
+
+void PinyinTokenizer::appendPinyinToken(const UnsafeStringView &pinyin)
+{
+    if (!containsPinyinToken(pinyin)) {
+        m_pinyinTokenArr.emplace_back(pinyin);
     }
 }
 
+bool PinyinTokenizer::containsPinyinToken(const UnsafeStringView &pinyin) const
+{
+    // There are only a few pinyins for a character, so a linear search is faster than a set.
+    return std::find(m_pinyinTokenArr.begin(), m_pinyinTokenArr.end(), pinyin)
+           != m_pinyinTokenArr.end();
+}
+
 } //namespace WCDB
@@ -54,17 +54,22 @@ private:
 
     std::vector<char> m_normalToken;
     int m_normalTokenLength;
-    std::vector<StringView> m_pinyinTokenArr;
+    // Views of the input or the pinyin dictionary.
+    std::vector<UnsafeStringView> m_pinyinTokenArr;
     int m_pinyinTokenIndex;
 
     // Can be configed by tokenizer parameters
     bool m_needSymbol;
+    bool m_needPrefix;
 
     void cursorStep();
+    void cursorStepRun();
     void subTokensStep();
 
     void genNormalToken();
     void genPinyinToken();
+    void appendPinyinToken(const UnsafeStringView &pinyin);
+    bool containsPinyinToken(const UnsafeStringView &pinyin) const;
 };
 
 } //namespace WCDB
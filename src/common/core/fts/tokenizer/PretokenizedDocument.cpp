@@ -0,0 +1,160 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PretokenizedDocument.hpp"
+#include "Assertion.hpp"
+#include "SQLite.h"
+#include "ThreadLocal.hpp"
+#include <atomic>
+#include <cstring>
+
+namespace WCDB {
+
+static std::atomic<int> &numberOfReplayingThreads()
+{
+    static std::atomic<int> *s_count = new std::atomic<int>(0);
+    return *s_count;
+}
+
+static ThreadLocal<const PretokenizedDocument::Documents *> &replayingDocuments()
+{
+    static ThreadLocal<const PretokenizedDocument::Documents *> *s_documents
+    = new ThreadLocal<const PretokenizedDocument::Documents *>();
+    return *s_documents;
+}
+
+PretokenizedDocument::PretokenizedDocument()
+: m_tokenize(nullptr), m_arguments(nullptr)
+{
+}
+
+PretokenizedDocument::~PretokenizedDocument() = default;
+
+PretokenizedDocument::PretokenizedDocument(PretokenizedDocument &&) = default;
+
+PretokenizedDocument &PretokenizedDocument::operator=(PretokenizedDocument &&) = default;
+
+bool PretokenizedDocument::tokenize(FTS5TokenizerModule &module,
+                                    AbstractFTSTokenizer *tokenizer,
+                                    const std::vector<StringView> &arguments,
+                                    const UnsafeStringView &text)
+{
+    WCTAssert(arguments == tokenizer->getArguments());
+    clear();
+    m_tokenize = module.getTokenize();
+    m_arguments = &arguments;
+    int rc = module.tokenize(
+    tokenizer, this, FTS5_TOKENIZE_DOCUMENT, text.data(), (int) text.length(), onToken);
+    if (rc != SQLITE_OK) {
+        clear();
+        return false;
+    }
+    m_text = text;
+    return true;
+}
+
+bool PretokenizedDocument::isTokenized() const
+{
+    return m_tokenize != nullptr;
+}
+
+void PretokenizedDocument::clear()
+{
+    m_text = UnsafeStringView();
+    m_tokenize = nullptr;
+    m_arguments = nullptr;
+    m_buffer.clear();
+    m_tokens.clear();
+}
+
+int PretokenizedDocument::onToken(
+void *pCtx, int tflags, const char *pToken, int nToken, int iStart, int iEnd)
+{
+    PretokenizedDocument *document = static_cast<PretokenizedDocument *>(pCtx);
+    Token token;
+    token.flags = tflags;
+    token.offset = (int) document->m_buffer.size();
+    token.length = nToken;
+    token.start = iStart;
+    token.end = iEnd;
+    document->m_buffer.insert(document->m_buffer.end(), pToken, pToken + nToken);
+    document->m_tokens.push_back(token);
+    return SQLITE_OK;
+}
+
+int PretokenizedDocument::replay(void *pCtx, FTS5TokenizerModule::TokenCallback callback) const
+{
+    const char *buffer = m_buffer.data();
+    for (const Token &token : m_tokens) {
+        int rc = callback(
+        pCtx, token.flags, buffer + token.offset, token.length, token.start, token.end);
+        if (rc != SQLITE_OK) {
+            return rc;
+        }
+    }
+    return SQLITE_OK;
+}
+
+void PretokenizedDocument::setReplayingDocuments(const Documents *documents)
+{
+    const Documents *&current = replayingDocuments().getOrCreate();
+    if (current == nullptr && documents != nullptr) {
+        ++numberOfReplayingThreads();
+    } else if (current != nullptr && documents == nullptr) {
+        --numberOfReplayingThreads();
+    }
+    current = documents;
+}
+
+bool PretokenizedDocument::tryReplay(FTS5TokenizerModule::Tokenize tokenize,
+                                     const AbstractFTSTokenizer *tokenizer,
+                                     void *pCtx,
+                                     int flags,
+                                     const char *pText,
+                                     int nText,
+                                     FTS5TokenizerModule::TokenCallback callback,
+                                     int &rc)
+{
+    // Avoid touching the thread local storage when there is no bulk indexing at all.
+    if (numberOfReplayingThreads().load(std::memory_order_relaxed) == 0
+        || flags != FTS5_TOKENIZE_DOCUMENT || pText == nullptr || nText <= 0) {
+        return false;
+    }
+    const Documents *documents = replayingDocuments().getOrCreate();
+    if (documents == nullptr) {
+        return false;
+    }
+    // Tokenizers of the same kind may produce different tokens with different arguments.
+    for (const PretokenizedDocument &document : *documents) {
+        if (document.m_tokenize == tokenize && document.m_text.length() == (size_t) nText
+            && memcmp(document.m_text.data(), pText, nText) == 0
+            && *document.m_arguments == tokenizer->getArguments()) {
+            rc = document.replay(pCtx, callback);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace WCDB
@@ -0,0 +1,87 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "StringView.hpp"
+#include "TokenizerModule.hpp"
+#include <vector>
+
+namespace WCDB {
+
+/*
+ The tokens of a text, produced in advance by a fts5 tokenizer.
+ When the same text is indexed by the same kind of tokenizer with the same arguments in a thread replaying it,
+ the tokens are passed to fts5 directly instead of tokenizing the text again.
+ */
+class PretokenizedDocument final {
+public:
+    PretokenizedDocument();
+    ~PretokenizedDocument();
+
+    PretokenizedDocument(PretokenizedDocument &&);
+    PretokenizedDocument &operator=(PretokenizedDocument &&);
+
+    // The tokenizer should be created with the arguments.
+    // The text and the arguments should stay alive until the document is replayed.
+    bool tokenize(FTS5TokenizerModule &module,
+                  AbstractFTSTokenizer *tokenizer,
+                  const std::vector<StringView> &arguments,
+                  const UnsafeStringView &text);
+    bool isTokenized() const;
+    void clear();
+
+    typedef std::vector<PretokenizedDocument> Documents;
+    // The documents are replayed in current thread until it's set to null.
+    static void setReplayingDocuments(const Documents *documents);
+    // Return true if the text is replayed, and the result code is set to `rc`.
+    static bool tryReplay(FTS5TokenizerModule::Tokenize tokenize,
+                          const AbstractFTSTokenizer *tokenizer,
+                          void *pCtx,
+                          int flags,
+                          const char *pText,
+                          int nText,
+                          FTS5TokenizerModule::TokenCallback callback,
+                          int &rc);
+
+private:
+    int replay(void *pCtx, FTS5TokenizerModule::TokenCallback callback) const;
+    static int
+    onToken(void *pCtx, int tflags, const char *pToken, int nToken, int iStart, int iEnd);
+
+    struct Token {
+        int flags;
+        int offset;
+        int length;
+        int start;
+        int end;
+    };
+    UnsafeStringView m_text;
+    FTS5TokenizerModule::Tokenize m_tokenize;
+    const std::vector<StringView> *m_arguments;
+    std::vector<char> m_buffer;
+    std::vector<Token> m_tokens;
+};
+
+} // namespace WCDB
@@ -24,6 +24,7 @@
 
 #include "TokenizerModule.hpp"
 #include "Assertion.hpp"
+#include "PretokenizedDocument.hpp"
 #include "SQLite.h"
 #include "SQLiteFTS3Tokenizer.h"
 #include <cstring>
@@ -39,12 +40,18 @@ namespace WCDB {
 AbstractFTSTokenizer::AbstractFTSTokenizer(const char *const *azArg, int nArg, void *pCtx)
 {
     WCDB_UNUSED(pCtx);
-    WCDB_UNUSED(azArg);
-    WCDB_UNUSED(nArg);
+    for (int i = 0; i < nArg; ++i) {
+        m_arguments.emplace_back(azArg[i]);
+    }
 }
 
 AbstractFTSTokenizer::~AbstractFTSTokenizer() = default;
 
+const std::vector<StringView> &AbstractFTSTokenizer::getArguments() const
+{
+    return m_arguments;
+}
+
 struct FTS3TokenizerWrap {
     sqlite3_tokenizer base;
     AbstractFTSTokenizer *tokenizer;
@@ -122,6 +129,21 @@ void AbstractFTS3TokenizerModuleTemplate::deleteCursor(FTS3TokenizeCursorWrap *p
     }
 }
 
+#pragma mark - AbstractFTS5TokenizerModuleTemplate
+bool AbstractFTS5TokenizerModuleTemplate::replayPretokenized(
+Tokenize tokenize,
+const AbstractFTSTokenizer *tokenizer,
+void *pCtx,
+int flags,
+const char *pText,
+int nText,
+int (*xToken)(void *, int, const char *, int, int, int),
+int &rc)
+{
+    return PretokenizedDocument::tryReplay(
+    tokenize, tokenizer, pCtx, flags, pText, nText, xToken, rc);
+}
+
 #pragma mark - FTS3TokenizerModule
 FTS3TokenizerModule::FTS3TokenizerModule()
 : m_version(0)
@@ -195,6 +217,37 @@ void *FTS5TokenizerModule::getContext()
     return m_pCtx;
 }
 
+AbstractFTSTokenizer *FTS5TokenizerModule::createTokenizer(const char *const *azArg, int nArg)
+{
+    AbstractFTSTokenizer *tokenizer = nullptr;
+    if (m_create(m_pCtx, azArg, nArg, &tokenizer) != SQLITE_OK) {
+        return nullptr;
+    }
+    return tokenizer;
+}
+
+void FTS5TokenizerModule::destroyTokenizer(AbstractFTSTokenizer *tokenizer)
+{
+    if (tokenizer != nullptr) {
+        m_destroy(tokenizer);
+    }
+}
+
+int FTS5TokenizerModule::tokenize(AbstractFTSTokenizer *tokenizer,
+                                  void *pCtx,
+                                  int flags,
+                                  const char *pText,
+                                  int nText,
+                                  TokenCallback callback)
+{
+    return m_tokenize(tokenizer, pCtx, flags, pText, nText, callback);
+}
+
+FTS5TokenizerModule::Tokenize FTS5TokenizerModule::getTokenize() const
+{
+    return m_tokenize;
+}
+
 #pragma mark - TokenizerModule
 
 TokenizerModule::TokenizerModule(std::shared_ptr<FTS3TokenizerModule> fts3Module)
@@ -24,7 +24,9 @@
 
 #pragma once
 #include "FTSError.hpp"
+#include "StringView.hpp"
 #include <memory>
+#include <vector>
 
 namespace WCDB {
 
@@ -43,6 +45,12 @@ public:
                           int *iPosition //iPosition is only used in FTS3/4
                           )
     = 0;
+
+    // The arguments following the tokenizer name in the `tokenize` option of the fts table.
+    const std::vector<StringView> &getArguments() const;
+
+private:
+    std::vector<StringView> m_arguments;
 };
 
 typedef struct FTS3TokenizerWrap FTS3TokenizerWrap;
@@ -113,6 +121,23 @@ public:
     AbstractFTS5TokenizerModuleTemplate &
     operator=(const AbstractFTS5TokenizerModuleTemplate &)
     = delete;
+
+protected:
+    typedef int (*Tokenize)(AbstractFTSTokenizer *pTokenizer,
+                            void *pCtx,
+                            int flags,
+                            const char *pText,
+                            int nText,
+                            int (*xToken)(void *, int, const char *, int, int, int));
+    // Return true if the text is tokenized in advance by a bulk indexing, and its tokens are replayed.
+    static bool replayPretokenized(Tokenize tokenize,
+                                   const AbstractFTSTokenizer *tokenizer,
+                                   void *pCtx,
+                                   int flags,
+                                   const char *pText,
+                                   int nText,
+                                   int (*xToken)(void *, int, const char *, int, int, int),
+                                   int &rc);
 };
 
 class WCDB_API FTS5TokenizerModule final {
@@ -135,6 +160,16 @@ public:
                         void *pCtx);
     void *getContext();
 
+    AbstractFTSTokenizer *createTokenizer(const char *const *azArg, int nArg);
+    void destroyTokenizer(AbstractFTSTokenizer *tokenizer);
+    int tokenize(AbstractFTSTokenizer *tokenizer,
+                 void *pCtx,
+                 int flags,
+                 const char *pText,
+                 int nText,
+                 TokenCallback callback);
+    Tokenize getTokenize() const;
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-private-field"
 private:
@@ -155,6 +155,9 @@ public:
         } else if (nText <= 0) {
             nText = (int) strlen(pText);
         }
+        if (replayPretokenized(tokenize, pTokenizer, pCtx, flags, pText, nText, xToken, rc)) {
+            return rc;
+        }
         pTokenizer->loadInput(pText, nText, flags);
         while (FTSError::isOK(rc = pTokenizer->nextToken(
                               &pToken, &nToken, &iStart, &iEnd, &tflags, nullptr))) {
@@ -168,6 +168,21 @@ void ScalarFunctionAPI::setErrorResult(int code, const UnsafeStringView &msg)
     sqlite3_result_error_code((sqlite3_context *) m_sqliteContext, code);
 }
 
+char *ScalarFunctionAPI::allocateTextResult(size_t length)
+{
+    return (char *) sqlite3_malloc64(length + 1);
+}
+
+void ScalarFunctionAPI::setAllocatedTextResult(char *buffer, size_t length)
+{
+    if (!m_sqliteContext) {
+        sqlite3_free(buffer);
+        return;
+    }
+    sqlite3_result_text64(
+    (sqlite3_context *) m_sqliteContext, buffer, length, sqlite3_free, SQLITE_UTF8);
+}
+
 void *ScalarFunctionAPI::getUserData() const
 {
     if (!m_sqliteContext) {
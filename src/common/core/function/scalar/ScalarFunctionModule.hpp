@@ -59,6 +59,14 @@ public:
     void setErrorResult(Error::Code code, const UnsafeStringView& msg);
     void setErrorResult(int code, const UnsafeStringView& msg);
 
+    /*
+     Allocate a buffer to build a text result of `length` bytes in place.
+     The buffer should be passed to `setAllocatedTextResult` then, which hands it over to sqlite without copying.
+     Return nullptr if out of memory.
+     */
+    char* allocateTextResult(size_t length);
+    void setAllocatedTextResult(char* buffer, size_t length);
+
 protected:
     ScalarFunctionAPI(SQLiteContext* ctx, SQLiteValue** values, int valueNum);
 
@@ -24,8 +24,12 @@
 
 #include "IntegerityHandleOperator.hpp"
 #include "Assertion.hpp"
+#include "Cell.hpp"
+#include "Cipher.hpp"
 #include "CoreConst.h"
 #include "Notifier.hpp"
+#include "Page.hpp"
+#include "Pager.hpp"
 
 namespace WCDB {
 
@@ -88,4 +92,64 @@ void IntegerityHandleOperator::checkIntegrity()
     }
 }
 
+Optional<bool> IntegerityHandleOperator::checkPagesIntegrity(Pages& pages,
+                                                             Repair::CipherDelegate* cipherDelegate)
+{
+    InnerHandle* handle = getHandle();
+    Repair::Pager pager(handle->getPath());
+    if (cipherDelegate != nullptr && cipherDelegate->isCipherDB()) {
+        size_t pageSize = cipherDelegate->getCipherPageSize();
+        if (pageSize == 0) {
+            return NullOpt;
+        }
+        pager.setCipherContext(cipherDelegate->getCipherContext());
+        pager.setPageSize((int) pageSize);
+    }
+    // Only the pages that are already checkpointed will be checked.
+    pager.setWalSkipped();
+    if (!pager.initialize()) {
+        if (pager.getError().isCorruption()) {
+            return false;
+        }
+        return NullOpt;
+    }
+    int numberOfPages = pager.getNumberOfPages();
+    for (auto iter = pages.begin(); iter != pages.end();) {
+        if (handle->isSuspended()) {
+            return NullOpt;
+        }
+        const Repair::IncrementalMaterial::Page& record = iter->second;
+        if (record.number == 0 || record.number > (uint32_t) numberOfPages) {
+            // The database file is truncated.
+            iter = pages.erase(iter);
+            continue;
+        }
+        Repair::Page page(record.number, &pager);
+        if (!page.initialize()) {
+            if (pager.getError().isCorruption()) {
+                return false;
+            }
+            return NullOpt;
+        }
+        if (page.getData().hash() != record.hash) {
+            // Modified after being checkpointed. It will be checked with its latest content.
+            ++iter;
+            continue;
+        }
+        if (!page.isInteriorPage() || page.isIndexPage()) {
+            for (int i = 0; i < page.getNumberOfCells(); ++i) {
+                Repair::Cell cell = page.getCell(i);
+                if (!cell.initialize()) {
+                    if (pager.getError().isCorruption()) {
+                        return false;
+                    }
+                    return NullOpt;
+                }
+            }
+        }
+        iter = pages.erase(iter);
+    }
+    return true;
+}
+
 } //namespace WCDB
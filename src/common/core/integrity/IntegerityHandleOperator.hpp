@@ -23,15 +23,28 @@
  */
 
 #include "HandleOperator.hpp"
+#include "IncrementalMaterial.hpp"
 
 namespace WCDB {
 
+namespace Repair {
+class CipherDelegate;
+}
+
 class IntegerityHandleOperator : public HandleOperator {
 public:
     IntegerityHandleOperator(InnerHandle* handle);
     ~IntegerityHandleOperator();
     void checkIntegrity();
 
+    typedef Repair::IncrementalMaterial::Pages Pages;
+    /*
+     It parses the b-tree pages and their cells with the repair parser, instead of running `PRAGMA integrity_check`.
+     The checked pages are removed from `pages`, and those modified after being collected are left.
+     It returns false if any page is suspected to be corrupted, and NullOpt if it fails or is interrupted.
+     */
+    Optional<bool> checkPagesIntegrity(Pages& pages, Repair::CipherDelegate* cipherDelegate);
+
 protected:
     StatementPragma m_statementForIntegrityCheck;
     StatementSelect m_statementForGetFTSTable;
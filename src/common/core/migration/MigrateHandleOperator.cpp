@@ -24,6 +24,8 @@
 
 #include "MigrateHandleOperator.hpp"
 #include "Assertion.hpp"
+#include "CompressingHandleDecorator.hpp"
+#include "CompressionInfo.hpp"
 #include "CoreConst.h"
 #include "Time.hpp"
 #include <cmath>
@@ -35,6 +37,10 @@ MigrateHandleOperator::MigrateHandleOperator(InnerHandle* handle)
 , m_migratingInfo(nullptr)
 , m_migrateStatement(handle->getStatement(DecoratorMigratingHandleStatement))
 , m_removeMigratedStatement(handle->getStatement(DecoratorMigratingHandleStatement))
+, m_compressionInfo(nullptr)
+, m_canCompressNewData(true)
+, m_selectMigratingRowStatement(handle->getStatement(DecoratorMigratingHandleStatement))
+, m_insertCompressedRowStatement(handle->getStatement(DecoratorAllType))
 , m_samplePointing(0)
 {
 }
@@ -44,6 +50,8 @@ MigrateHandleOperator::~MigrateHandleOperator()
     finalizeMigrationStatement();
     getHandle()->returnStatement(m_migrateStatement);
     getHandle()->returnStatement(m_removeMigratedStatement);
+    getHandle()->returnStatement(m_selectMigratingRowStatement);
+    getHandle()->returnStatement(m_insertCompressedRowStatement);
 }
 
 void MigrateHandleOperator::onDecorationChange()
@@ -57,6 +65,12 @@ void MigrateHandleOperator::onDecorationChange()
 
     handle->returnStatement(m_removeMigratedStatement);
     m_removeMigratedStatement = handle->getStatement(DecoratorMigratingHandleStatement);
+
+    handle->returnStatement(m_selectMigratingRowStatement);
+    m_selectMigratingRowStatement = handle->getStatement(DecoratorMigratingHandleStatement);
+
+    handle->returnStatement(m_insertCompressedRowStatement);
+    m_insertCompressedRowStatement = handle->getStatement(DecoratorAllType);
 }
 
 bool MigrateHandleOperator::reAttach(const MigrationBaseInfo* info)
@@ -70,6 +84,7 @@ bool MigrateHandleOperator::reAttach(const MigrationBaseInfo* info)
         succeed = detach() && attach(info);
     }
     m_migratingInfo = nullptr;
+    m_compressionInfo = nullptr;
     finalizeMigrationStatement();
     return succeed;
 }
@@ -166,8 +181,21 @@ Optional<bool> MigrateHandleOperator::migrateRows(const MigrationInfo* info)
         m_migratingInfo = info;
     }
 
-    if (!m_migrateStatement->isPrepared()
-        && !m_migrateStatement->prepare(m_migratingInfo->getStatementForMigratingOneRow())) {
+    auto compressionInfo = getCompressionInfo(m_migratingInfo);
+    if (compressionInfo.failed()) {
+        return NullOpt;
+    }
+    if (m_compressionInfo != compressionInfo.value()) {
+        finalizeMigrationStatement();
+        m_compressionInfo = compressionInfo.value();
+    }
+
+    if (m_compressionInfo != nullptr) {
+        if (!prepareCompressingStatements()) {
+            return NullOpt;
+        }
+    } else if (!m_migrateStatement->isPrepared()
+               && !m_migrateStatement->prepare(m_migratingInfo->getStatementForMigratingOneRow())) {
         return NullOpt;
     }
 
@@ -197,6 +225,16 @@ Optional<bool> MigrateHandleOperator::migrateRows(const MigrationInfo* info)
         addSample(timeIntervalWithinTransaction, timeIntervalWholeTranscation);
 
         WCTAssert(migrated.succeed());
+        if (migrated.value() && !m_migratingInfo->isSourceDrained()) {
+            // The conflicting rows are ignored by migration so they may be still in the source table.
+            InnerHandle* handle = getHandle();
+            if (handle->prepare(m_migratingInfo->getStatementForSelectingAnyMigratingRow())) {
+                if (handle->step() && handle->done()) {
+                    m_migratingInfo->setSourceDrained();
+                }
+                handle->finalize();
+            }
+        }
         return migrated;
     }
     return NullOpt;
@@ -204,6 +242,9 @@ Optional<bool> MigrateHandleOperator::migrateRows(const MigrationInfo* info)
 
 Optional<bool> MigrateHandleOperator::migrateRow()
 {
+    if (m_compressionInfo != nullptr) {
+        return migrateAndCompressRow();
+    }
     WCTAssert(m_migrateStatement->isPrepared() && m_removeMigratedStatement->isPrepared());
     WCTAssert(getHandle()->isInTransaction());
     Optional<bool> migrated;
@@ -225,6 +266,76 @@ void MigrateHandleOperator::finalizeMigrationStatement()
 {
     m_migrateStatement->finalize();
     m_removeMigratedStatement->finalize();
+    m_selectMigratingRowStatement->finalize();
+    m_insertCompressedRowStatement->finalize();
+}
+
+#pragma mark - Compression
+Optional<const CompressionTableInfo*>
+MigrateHandleOperator::getCompressionInfo(const MigrationInfo* info)
+{
+    DecorativeHandle* handle = dynamic_cast<DecorativeHandle*>(getHandle());
+    if (handle == nullptr || !handle->containDecorator(DecoratorCompressingHandle)) {
+        return nullptr;
+    }
+    CompressingHandleDecorator* compressingDecorator
+    = handle->getDecorator<CompressingHandleDecorator>(DecoratorCompressingHandle);
+    m_canCompressNewData = compressingDecorator->canCompressNewData();
+    return compressingDecorator->tryGetCompressionInfo(info->getTable());
+}
+
+bool MigrateHandleOperator::prepareCompressingStatements()
+{
+    WCTAssert(m_compressionInfo != nullptr);
+    if (!m_selectMigratingRowStatement->isPrepared()
+        && !m_selectMigratingRowStatement->prepare(
+        m_migratingInfo->getStatementForSelectingOneMigratingRow())) {
+        return false;
+    }
+    if (!m_insertCompressedRowStatement->isPrepared()) {
+        Columns typeColumns;
+        for (const auto& column : m_compressionInfo->getColumnInfos()) {
+            typeColumns.push_back(column.getTypeColumn());
+        }
+        if (!m_insertCompressedRowStatement->prepare(
+            m_migratingInfo->getStatementForInsertingMigratingRow(typeColumns))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Optional<bool> MigrateHandleOperator::migrateAndCompressRow()
+{
+    WCTAssert(m_selectMigratingRowStatement->isPrepared()
+              && m_insertCompressedRowStatement->isPrepared()
+              && m_removeMigratedStatement->isPrepared());
+    WCTAssert(getHandle()->isInTransaction());
+    Optional<bool> migrated;
+    if (m_selectMigratingRowStatement->step()) {
+        if (m_selectMigratingRowStatement->done()) {
+            migrated = true;
+        } else {
+            OneRowValue row = m_selectMigratingRowStatement->getOneRow();
+            if (m_compressionInfo->compressMigratingRow(
+                m_migratingInfo->getColumnsForMigrating(), row, m_canCompressNewData, getHandle())) {
+                m_insertCompressedRowStatement->bindRow(row);
+                if (m_insertCompressedRowStatement->step()) {
+                    if (getHandle()->getChanges() != 0) {
+                        if (m_removeMigratedStatement->step()) {
+                            migrated = false;
+                        }
+                    } else {
+                        migrated = true;
+                    }
+                }
+            }
+        }
+    }
+    m_selectMigratingRowStatement->reset();
+    m_insertCompressedRowStatement->reset();
+    m_removeMigratedStatement->reset();
+    return migrated;
 }
 
 #pragma mark - Sample
@@ -31,6 +31,8 @@
 
 namespace WCDB {
 
+class CompressionTableInfo;
+
 // Each step of migration should be as small as possible to avoid blocking user operations.
 // However, it's very wasteful for those resources(CPU, IO...) when the step is too small.
 // So stepper will try to migrate one by one until the count of dirty pages(to be written) is changed.
@@ -66,6 +68,20 @@ private:
     HandleStatement* m_migrateStatement;
     HandleStatement* m_removeMigratedStatement;
 
+#pragma mark - Compression
+protected:
+    // Rows migrated into a compressing table are compressed while copying,
+    // instead of being inserted and then updated by the compressing decorator.
+    Optional<const CompressionTableInfo*> getCompressionInfo(const MigrationInfo* info);
+    bool prepareCompressingStatements();
+    Optional<bool> migrateAndCompressRow();
+
+private:
+    const CompressionTableInfo* m_compressionInfo;
+    bool m_canCompressNewData;
+    HandleStatement* m_selectMigratingRowStatement;
+    HandleStatement* m_insertCompressedRowStatement;
+
 #pragma mark - Sample
 protected:
     void addSample(double timeIntervalWithinTransaction, double timeIntervalForWholeTransaction);
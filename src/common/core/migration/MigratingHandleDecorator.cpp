@@ -343,6 +343,8 @@ bool MigratingHandleDecorator::commitTransaction()
 void MigratingHandleDecorator::rollbackTransaction()
 {
     Super::rollbackTransaction();
+    // The rows inserted in transaction are discarded.
+    invalidateCachedRowids();
     if (m_createdNewViewInTransaction) {
         setNeedRebind();
         m_createdNewViewInTransaction = false;
@@ -28,6 +28,7 @@
 #include "SQLite.h"
 #include "StringView.hpp"
 #include "WINQ.h"
+#include <limits>
 
 namespace WCDB {
 
@@ -224,6 +225,10 @@ MigratingStatementDecorator::process(const Statement& originStatement)
                 const MigrationInfo* info
                 = m_migrationBinder->getBoundInfo(migratedTableName);
                 WCTAssert(info != nullptr);
+                clearMigrateStatus();
+                if (info->isUpdatingRowid(falledBackStatement)) {
+                    m_migratingInfo = info;
+                }
                 info->generateStatementsForUpdateMigrating(
                 falledBackStatement, statements, m_rowidBindIndex);
             }
@@ -259,6 +264,7 @@ MigratingStatementDecorator::process(const Statement& originStatement)
                 const MigrationInfo* info
                 = m_migrationBinder->getBoundInfo(migratedSTMT.table);
                 WCTAssert(info != nullptr);
+                info->invalidateNextRowid();
                 statements.push_back(info->getStatementForDeletingFromTable(falledBackStatement));
             }
         } break;
@@ -275,6 +281,10 @@ MigratingStatementDecorator::process(const Statement& originStatement)
                 stmt.schema = Schema::main();
             }
         } break;
+        case Syntax::Identifier::Type::SelectSTMT: {
+            tryRouteToTables(falledBackStatement);
+            statements.push_back(falledBackStatement);
+        } break;
         default:
             statements.push_back(falledBackStatement);
             break;
@@ -298,7 +308,10 @@ bool MigratingStatementDecorator::tryFallbackToUnionedView(Syntax::Schema& schem
             return false;
         }
         const MigrationInfo* info = optionalInfo.value();
-        if (info != nullptr) {
+        // All the rows are in the target table once the source table is drained.
+        // Note that the transaction may be started before it's drained.
+        if (info != nullptr
+            && (!info->isSourceDrained() || getHandle()->isInTransaction())) {
             schema = Schema::temp();
             table = info->getUnionedView();
         }
@@ -550,10 +563,31 @@ bool MigratingStatementDecorator::stepInsert()
     }
 
     int64_t maxId = 1;
+    bool seeding = false;
 
     if (!m_migratingInfo->getIntegerPrimaryKey().empty()) {
         if (m_assignedPrimaryKey.hasValue()) {
             maxId = m_assignedPrimaryKey.value();
+        } else {
+            auto cachedRowid = m_migratingInfo->getCachedNextRowid();
+            if (cachedRowid.succeed()) {
+                maxId = cachedRowid.value();
+            } else {
+                WCTAssert(iter != m_additionalStatements.end());
+                if (!iter->step()) {
+                    return false;
+                }
+                if (!iter->done()) {
+                    maxId = std::max(maxId, iter->getInteger());
+                }
+                seeding = true;
+            }
+        }
+    } else {
+        maxId = std::max(maxId, rowid);
+        auto cachedRowid = m_migratingInfo->getCachedNextRowid();
+        if (cachedRowid.succeed()) {
+            maxId = std::max(maxId, cachedRowid.value());
         } else {
             WCTAssert(iter != m_additionalStatements.end());
             if (!iter->step()) {
@@ -562,19 +596,12 @@ bool MigratingStatementDecorator::stepInsert()
             if (!iter->done()) {
                 maxId = std::max(maxId, iter->getInteger());
             }
-        }
-    } else {
-        WCTAssert(iter != m_additionalStatements.end());
-        maxId = std::max(maxId, rowid);
-        if (!iter->step()) {
-            return false;
-        }
-        if (!iter->done()) {
-            maxId = std::max(maxId, iter->getInteger());
+            seeding = true;
         }
     }
     Super::bindInteger(maxId, m_rowidBindIndex);
     if (!Super::step()) {
+        m_migratingInfo->invalidateNextRowid();
         if (getHandle()->getError().code() == Error::Code::Constraint) {
             Error error = Error(
             Error::Code::Warning,
@@ -584,6 +611,11 @@ bool MigratingStatementDecorator::stepInsert()
         }
         return false;
     }
+    if (seeding && maxId < std::numeric_limits<int64_t>::max()) {
+        m_migratingInfo->seedNextRowid(maxId + 1);
+    } else {
+        m_migratingInfo->advanceNextRowid(maxId);
+    }
     return true;
 }
 
@@ -598,6 +630,10 @@ void MigratingStatementDecorator::clearMigrateStatus()
 bool MigratingStatementDecorator::stepUpdateOrDelete()
 {
     WCTAssert(m_additionalStatements.size() == 2);
+    if (m_migratingInfo != nullptr) {
+        // The updated rowid may be larger than the cached one.
+        m_migratingInfo->invalidateNextRowid();
+    }
     auto iter = m_additionalStatements.begin();
     HandleStatement& selectStatement = *iter;
     if (!selectStatement.step()) {
@@ -621,7 +657,178 @@ bool MigratingStatementDecorator::stepUpdateOrDelete()
             return false;
         }
     }
+    if (m_migratingInfo != nullptr) {
+        // A concurrent insert may seed the cache again before the update holds the write lock.
+        m_migratingInfo->invalidateNextRowid();
+    }
     return true;
 }
 
+#pragma mark - Select
+void MigratingStatementDecorator::tryRouteToTables(Statement& statement)
+{
+    WCTAssert(statement.getType() == Syntax::Identifier::Type::SelectSTMT);
+    Syntax::SelectSTMT& selectSyntax = static_cast<Syntax::SelectSTMT&>(statement.syntax());
+    // Only the simple select statement reading from one migrating table is routed.
+    if (!selectSyntax.commonTableExpressions.empty() || !selectSyntax.cores.empty()
+        || !selectSyntax.select.hasValue()) {
+        return;
+    }
+    Syntax::SelectCore& coreSyntax = selectSyntax.select.value();
+    if (coreSyntax.switcher != Syntax::SelectCore::Switch::Select
+        || coreSyntax.tableOrSubqueries.size() != 1 || coreSyntax.joinClause.hasValue()
+        || !coreSyntax.groups.empty() || !coreSyntax.windowDefs.empty()) {
+        return;
+    }
+    Syntax::TableOrSubquery& tableSyntax = coreSyntax.tableOrSubqueries.front();
+    const char* unionedViewPrefix = MigrationInfo::getUnionedViewPrefix();
+    if (tableSyntax.switcher != Syntax::TableOrSubquery::Switch::Table
+        || !tableSyntax.schema.isTargetingSameSchema(Schema::temp().syntax())
+        || !tableSyntax.tableOrFunction.hasPrefix(unionedViewPrefix)
+        || tableSyntax.indexType != Syntax::TableOrSubquery::IndexType::NotSet) {
+        return;
+    }
+    size_t prefixLength = strlen(unionedViewPrefix);
+    const MigrationInfo* info = m_migrationBinder->getBoundInfo(
+    UnsafeStringView(tableSyntax.tableOrFunction.data() + prefixLength,
+                     tableSyntax.tableOrFunction.length() - prefixLength));
+    if (info == nullptr || info->getUnionedView() != tableSyntax.tableOrFunction) {
+        return;
+    }
+
+    for (const auto& resultColumn : coreSyntax.resultColumns) {
+        if (resultColumn.expression.hasValue()
+            && resultColumn.expression.value().switcher == Syntax::Expression::Switch::Column
+            && resultColumn.expression.value().column().wildcard) {
+            // The columns of the unioned view are unknown here.
+            return;
+        }
+    }
+
+    // Collect the columns it reads.
+    Columns columns;
+    bool routable = true;
+    int numberOfCores = 0;
+    statement.iterate([&](Syntax::Identifier& identifier, bool isBegin, bool& stop) {
+        if (!isBegin) {
+            return;
+        }
+        switch (identifier.getType()) {
+        case Syntax::Identifier::Type::SelectCore:
+            routable = ++numberOfCores == 1;
+            break;
+        case Syntax::Identifier::Type::Column: {
+            Syntax::Column& column = (Syntax::Column&) identifier;
+            if (column.wildcard) {
+                // e.g. count(*)
+                break;
+            }
+            if (!column.table.empty()
+                || column.name.caseInsensitiveEqual("_rowid_")
+                || column.name.caseInsensitiveEqual("oid")) {
+                routable = false;
+            } else if (!column.name.caseInsensitiveEqual("rowid")) {
+                for (const auto& resultColumn : coreSyntax.resultColumns) {
+                    if (resultColumn.alias.caseInsensitiveEqual(column.name)) {
+                        // It can't be told whether it's the alias or the column.
+                        routable = false;
+                    }
+                }
+                bool exists = false;
+                for (const auto& existing : columns) {
+                    if (existing.syntax().name.caseInsensitiveEqual(column.name)) {
+                        exists = true;
+                        break;
+                    }
+                }
+                if (!exists) {
+                    columns.push_back(Column(column.name));
+                }
+            }
+        } break;
+        case Syntax::Identifier::Type::BindParameter: {
+            Syntax::BindParameter& bindParameter = (Syntax::BindParameter&) identifier;
+            // The key equality is copied into the routed subquery, and the copies of an unnumbered `?` are numbered by sqlite one by one,
+            // which shifts the indexes of the following parameters.
+            if (bindParameter.switcher == Syntax::BindParameter::Switch::QuestionSign
+                && bindParameter.n == 0) {
+                routable = false;
+            }
+        } break;
+        case Syntax::Identifier::Type::Expression: {
+            Syntax::Expression& expression = (Syntax::Expression&) identifier;
+            if (expression.switcher == Syntax::Expression::Switch::In) {
+                routable = expression.inSwitcher != Syntax::Expression::SwitchIn::Table
+                           && expression.inSwitcher != Syntax::Expression::SwitchIn::Function;
+            }
+        } break;
+        default:
+            break;
+        }
+        if (!routable) {
+            stop = true;
+        }
+    });
+    if (!routable || numberOfCores != 1) {
+        return;
+    }
+
+    // Find the equality constraint of [rowid/primary key].
+    // The range queries are left to the unioned view since sqlite flattens it and merges the ordered rows of both tables.
+    StringView key = info->getIntegerPrimaryKey();
+    if (key.empty()) {
+        key = "rowid";
+    }
+    const Syntax::Expression* equality = nullptr;
+    if (coreSyntax.condition.hasValue() && coreSyntax.condition.value().isValid()) {
+        std::list<const Syntax::Expression*> terms = { &coreSyntax.condition.value() };
+        while (!terms.empty() && equality == nullptr) {
+            const Syntax::Expression* term = terms.front();
+            terms.pop_front();
+            if (term->switcher == Syntax::Expression::Switch::BinaryOperation
+                && term->binaryOperator == Syntax::Expression::BinaryOperator::And) {
+                for (const auto& subTerm : term->expressions) {
+                    terms.push_back(&subTerm);
+                }
+            } else if (term->switcher == Syntax::Expression::Switch::Expressions
+                       && term->expressions.size() == 1) {
+                terms.push_back(&term->expressions.front());
+            } else if (isEqualToKey(*term, key)) {
+                equality = term;
+            }
+        }
+    }
+    if (equality == nullptr) {
+        return;
+    }
+
+    // [rowid/primary key] is unique so the source table is skipped once the row is found in the target table.
+    StatementSelect routed
+    = info->getStatementForSelectingRoutedRows(columns, Expression(*equality)).limit(1);
+    StringView alias
+    = tableSyntax.alias.empty() ? info->getUnionedView() : tableSyntax.alias;
+    tableSyntax = TableOrSubquery(routed).as(alias).syntax();
+}
+
+bool MigratingStatementDecorator::isEqualToKey(const Syntax::Expression& term,
+                                               const UnsafeStringView& key) const
+{
+    if (term.switcher != Syntax::Expression::Switch::BinaryOperation
+        || term.binaryOperator != Syntax::Expression::BinaryOperator::Equal) {
+        return false;
+    }
+    auto isKey = [&key](const Syntax::Expression& expression) {
+        return expression.switcher == Syntax::Expression::Switch::Column
+               && expression.column().name.caseInsensitiveEqual(key);
+    };
+    auto isConstant = [](const Syntax::Expression& expression) {
+        return expression.switcher == Syntax::Expression::Switch::BindParameter
+               || expression.switcher == Syntax::Expression::Switch::LiteralValue;
+    };
+    WCTAssert(term.expressions.size() == 2);
+    const Syntax::Expression& left = term.expressions.front();
+    const Syntax::Expression& right = term.expressions.back();
+    return (isKey(left) && isConstant(right)) || (isConstant(left) && isKey(right));
+}
+
 } //namespace WCDB
@@ -89,6 +89,11 @@ private:
 #pragma mark - Update/Delete
 protected:
     bool stepUpdateOrDelete();
+
+#pragma mark - Select
+protected:
+    void tryRouteToTables(Statement &statement);
+    bool isEqualToKey(const Syntax::Expression &term, const UnsafeStringView &key) const;
 };
 
 } // namespace WCDB
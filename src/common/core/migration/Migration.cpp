@@ -137,8 +137,7 @@ bool Migration::initInfo(InfoInitializer& initializer, const UnsafeStringView& t
                 m_hints.emplace(targetTable);
                 m_tableAcquired = false;
             } else {
-                m_holder.push_back(MigrationInfo(
-                userInfo, columns, autoincrement, integerPrimaryKey));
+                m_holder.emplace_back(userInfo, columns, autoincrement, integerPrimaryKey);
                 const MigrationInfo* hold = &m_holder.back();
                 m_migratings.emplace(hold);
                 m_referenceds.emplace(hold, 0);
@@ -516,6 +515,13 @@ void Migration::Binder::setTableInfoCommitted(bool committed)
     m_migration.setTableInfoCommitted(committed);
 }
 
+void Migration::Binder::invalidateCachedRowids()
+{
+    for (const auto& iter : m_bounds) {
+        iter.second->invalidateNextRowid();
+    }
+}
+
 Optional<RecyclableMigrationInfo>
 Migration::getOrInitInfo(InfoInitializer& initializer, const UnsafeStringView& table)
 {
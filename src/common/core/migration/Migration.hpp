@@ -154,6 +154,7 @@ public:
         virtual bool bindInfos(const StringViewMap<const MigrationInfo*>& infos) = 0;
 
         void setTableInfoCommitted(bool committed);
+        void invalidateCachedRowids();
 
     private:
         Migration& m_migration;
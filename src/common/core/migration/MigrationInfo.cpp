@@ -25,6 +25,7 @@
 #include "MigrationInfo.hpp"
 #include "Assertion.hpp"
 #include "StringView.hpp"
+#include <limits>
 
 namespace WCDB {
 
@@ -236,6 +237,8 @@ MigrationInfo::MigrationInfo(const MigrationUserInfo& userInfo,
 , m_autoincrement(autoincrement)
 , m_integerPrimaryKey(integerPrimaryKey)
 , m_needUpdateSequence(autoincrement)
+, m_nextRowid(0)
+, m_sourceDrained(false)
 {
     WCTAssert(!uniqueColumns.empty());
 
@@ -281,16 +284,20 @@ MigrationInfo::MigrationInfo(const MigrationUserInfo& userInfo,
           OrderingTerm(rowid).order(Order::DESC) :
           OrderingTerm(Column(m_integerPrimaryKey)).order(Order::DESC);
 
+        m_columnsForMigrating = columns;
+
+        m_statementForSelectingOneMigratingRow = StatementSelect()
+                                                 .select(resultColumns)
+                                                 .from(sourceTableQuery)
+                                                 .where(m_filterCondition)
+                                                 .order(migrateOrder)
+                                                 .limit(1);
+
         m_statementForMigratingOneRow = StatementInsert()
                                         .insertIntoTable(getTable())
                                         .orIgnore()
                                         .columns(columns)
-                                        .values(StatementSelect()
-                                                .select(resultColumns)
-                                                .from(sourceTableQuery)
-                                                .where(m_filterCondition)
-                                                .order(migrateOrder)
-                                                .limit(1));
+                                        .values(m_statementForSelectingOneMigratingRow);
 
         m_statementForDeletingMigratedOneRow = StatementDelete()
                                                .deleteFrom(qualifiedSourceTable)
@@ -300,6 +307,12 @@ MigrationInfo::MigrationInfo(const MigrationUserInfo& userInfo,
 
         m_statementForSelectingAnyRowFromSourceTable
         = StatementSelect().select(Column::all()).from(sourceTableQuery).limit(1);
+
+        m_statementForSelectingAnyMigratingRow = StatementSelect()
+                                                 .select(1)
+                                                 .from(sourceTableQuery)
+                                                 .where(m_filterCondition)
+                                                 .limit(1);
     }
 
     // Compatible
@@ -420,6 +433,30 @@ const StatementDelete& MigrationInfo::getStatementForDeletingMigratedOneRow() co
     return m_statementForDeletingMigratedOneRow;
 }
 
+const StatementSelect& MigrationInfo::getStatementForSelectingOneMigratingRow() const
+{
+    return m_statementForSelectingOneMigratingRow;
+}
+
+const Columns& MigrationInfo::getColumnsForMigrating() const
+{
+    return m_columnsForMigrating;
+}
+
+StatementInsert
+MigrationInfo::getStatementForInsertingMigratingRow(const Columns& additionalColumns) const
+{
+    Columns columns = m_columnsForMigrating;
+    columns.insert(columns.end(), additionalColumns.begin(), additionalColumns.end());
+    size_t count = columns.size();
+    return StatementInsert()
+    .insertIntoTable(getTable())
+    .schema(Schema::main())
+    .orIgnore()
+    .columns(columns)
+    .values(BindParameter::bindParameters(count));
+}
+
 void MigrationInfo::generateStatementsForInsertMigrating(const Statement& sourceStatement,
                                                          std::list<Statement>& statements,
                                                          int& primaryKeyIndex,
@@ -592,11 +629,103 @@ MigrationInfo::getStatementForDeletingFromTable(const Statement& sourceStatement
     return StatementDelete().deleteFrom(table).where(m_filterCondition);
 }
 
+StatementSelect MigrationInfo::getStatementForSelectingRoutedRows(const Columns& columns,
+                                                                 const Expression& condition) const
+{
+    ResultColumns resultColumns;
+    resultColumns.push_back(Column::rowid().as("rowid"));
+    resultColumns.insert(resultColumns.end(), columns.begin(), columns.end());
+
+    Expression sourceCondition = condition;
+    if (m_filterCondition.syntax().isValid()) {
+        sourceCondition = condition.syntax().isValid() ? condition && m_filterCondition :
+                                                         m_filterCondition;
+    }
+
+    return StatementSelect()
+    .select(resultColumns)
+    .from(TableOrSubquery(m_table).schema(Schema::main()))
+    .where(condition)
+    .unionAll()
+    .select(resultColumns)
+    .from(TableOrSubquery(getSourceTable()).schema(m_databaseInfo.getSchemaForSourceDatabase()))
+    .where(sourceCondition);
+}
+
+bool MigrationInfo::isUpdatingRowid(const Statement& sourceStatement) const
+{
+    WCTAssert(sourceStatement.getType() == Syntax::Identifier::Type::UpdateSTMT);
+    const Syntax::UpdateSTMT& updateSyntax
+    = static_cast<const Syntax::UpdateSTMT&>(sourceStatement.syntax());
+    for (const auto& columns : updateSyntax.columnsList) {
+        for (const auto& column : columns) {
+            if (column.name.caseInsensitiveEqual("rowid")
+                || column.name.caseInsensitiveEqual("_rowid_")
+                || column.name.caseInsensitiveEqual("oid")
+                || (!m_integerPrimaryKey.empty()
+                    && column.name.caseInsensitiveEqual(m_integerPrimaryKey))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+Optional<int64_t> MigrationInfo::getCachedNextRowid() const
+{
+    int64_t nextRowid = m_nextRowid.load();
+    if (nextRowid > 0) {
+        return nextRowid;
+    }
+    return NullOpt;
+}
+
+void MigrationInfo::seedNextRowid(int64_t nextRowid) const
+{
+    int64_t current = m_nextRowid.load();
+    while (current < nextRowid
+           && !m_nextRowid.compare_exchange_weak(current, nextRowid)) {
+    }
+}
+
+void MigrationInfo::advanceNextRowid(int64_t usedRowid) const
+{
+    if (usedRowid == std::numeric_limits<int64_t>::max()) {
+        // Let sqlite handle the overflow.
+        invalidateNextRowid();
+        return;
+    }
+    int64_t current = m_nextRowid.load();
+    while (current > 0 && current <= usedRowid
+           && !m_nextRowid.compare_exchange_weak(current, usedRowid + 1)) {
+    }
+}
+
+void MigrationInfo::invalidateNextRowid() const
+{
+    m_nextRowid.store(0);
+}
+
 const StatementSelect& MigrationInfo::getStatementForSelectingAnyRowFromSourceTable() const
 {
     return m_statementForSelectingAnyRowFromSourceTable;
 }
 
+const StatementSelect& MigrationInfo::getStatementForSelectingAnyMigratingRow() const
+{
+    return m_statementForSelectingAnyMigratingRow;
+}
+
+bool MigrationInfo::isSourceDrained() const
+{
+    return m_sourceDrained.load();
+}
+
+void MigrationInfo::setSourceDrained() const
+{
+    m_sourceDrained.store(true);
+}
+
 const StatementDropTable& MigrationInfo::getStatementForDroppingSourceTable() const
 {
     return m_statementForDroppingSourceTable;
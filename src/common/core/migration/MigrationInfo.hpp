@@ -27,6 +27,7 @@
 #include "Lock.hpp"
 #include "StringView.hpp"
 #include "WINQ.h"
+#include <atomic>
 #include <set>
 
 namespace WCDB {
@@ -206,7 +207,10 @@ public:
      
         INSERT INTO main.targetTable([columns], rowid) VALUES (..., ?rowidIndex)
      
-        Note that newRowid is SELECT max(rowid)+1 FROM temp.[unionedView]
+        Note that newRowid is max(rowid of the row inserted into source table, SELECT max(rowid)+1 FROM main.[table])
+     
+     For the case 2 and 3, the next rowid is cached in memory after the first insertion,
+     so that the following insertions take it directly instead of selecting from the tables again.
      */
     void generateStatementsForInsertMigrating(const Statement& sourceStatement,
                                               std::list<Statement>& statements,
@@ -238,9 +242,34 @@ public:
 
     StatementDelete getStatementForDeletingFromTable(const Statement& sourceStatement) const;
 
+    /*
+     SELECT rowid AS rowid, [columns] FROM main.[table] WHERE [condition]
+     UNION ALL
+     SELECT rowid AS rowid, [columns] FROM [schemaForSourceDatabase].[sourceTable] WHERE [condition] AND [filter]
+     
+     It's used instead of the unioned view for the lookup of [rowid/primary key],
+     so that the target table is probed first and the source table is probed only if the row is not found.
+     */
+    StatementSelect getStatementForSelectingRoutedRows(const Columns& columns,
+                                                       const Expression& condition) const;
+
+    // Returns true if the update statement may assign the [rowid/primary key].
+    bool isUpdatingRowid(const Statement& sourceStatement) const;
+
+    /*
+     The cached next rowid may be larger than the real one after rollback, which is still safe for insertion.
+     It's invalidated whenever it may become smaller than the real one.
+     */
+    Optional<int64_t> getCachedNextRowid() const;
+    void seedNextRowid(int64_t nextRowid) const;
+    void advanceNextRowid(int64_t usedRowid) const;
+    void invalidateNextRowid() const;
+
 protected:
     StatementDelete m_statementForDeletingSpecifiedRow;
     StatementSelect m_statementForSelectingMaxID;
+    // 0 for not seeded yet
+    mutable std::atomic<int64_t> m_nextRowid;
 
 #pragma mark - Migrate
 public:
@@ -265,21 +294,60 @@ public:
      */
     const StatementDelete& getStatementForDeletingMigratedOneRow() const;
 
+    /*
+     SELECT rowid, [columns]
+     FROM [schemaForSourceDatabase].[sourceTable]
+     WHERE [filter]
+     ORDER BY [rowid/primary key] DESC
+     LIMIT 1
+     
+     It's the selecting part of the statement for migrating one row,
+     which is used to migrate and compress the row in a single pass when the target table is compressing.
+     */
+    const StatementSelect& getStatementForSelectingOneMigratingRow() const;
+
+    /*
+     rowid, [columns]
+     */
+    const Columns& getColumnsForMigrating() const;
+
+    /*
+     INSERT OR IGNORE INTO main.[table](rowid, [columns], [additionalColumns])
+     VALUES(?1, ?2, ...)
+     */
+    StatementInsert getStatementForInsertingMigratingRow(const Columns& additionalColumns) const;
+
     /*
      SELECT * FROM [schemaForSourceDatabase].[sourceTable] LIMIT 1
      */
     const StatementSelect& getStatementForSelectingAnyRowFromSourceTable() const;
 
+    /*
+     SELECT 1 FROM [schemaForSourceDatabase].[sourceTable] WHERE [filter] LIMIT 1
+     */
+    const StatementSelect& getStatementForSelectingAnyMigratingRow() const;
+
+    /*
+     All the rows are in the target table after the source table is drained.
+     Then the reading of it can skip the unioned view, while the source table is still waiting to be dropped.
+     */
+    bool isSourceDrained() const;
+    void setSourceDrained() const;
+
     /*
      DROP TABLE IF EXISTS [schemaForSourceDatabase].[sourceTable]
      */
     const StatementDropTable& getStatementForDroppingSourceTable() const;
 
 protected:
+    Columns m_columnsForMigrating;
+    StatementSelect m_statementForSelectingOneMigratingRow;
     StatementInsert m_statementForMigratingOneRow;
     StatementDelete m_statementForDeletingMigratedOneRow;
     StatementDropTable m_statementForDroppingSourceTable;
     StatementSelect m_statementForSelectingAnyRowFromSourceTable;
+    StatementSelect m_statementForSelectingAnyMigratingRow;
+    mutable std::atomic<bool> m_sourceDrained;
 };
 
 } // namespace WCDB
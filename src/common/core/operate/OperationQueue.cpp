@@ -42,7 +42,10 @@ OperationQueue::OperationQueue(const UnsafeStringView& name, OperationEvent* eve
 , m_observerForMemoryWarning(registerNotificationWhenMemoryWarning())
 {
     Notifier::shared().setNotification(
-    0, name, std::bind(&OperationQueue::handleError, this, std::placeholders::_1));
+    0,
+    name,
+    std::bind(&OperationQueue::handleError, this, std::placeholders::_1),
+    Error::Level::Warning);
 #ifndef _WIN32
     Global::shared().setNotificationWhenFileOpened(
     name,
@@ -71,6 +74,9 @@ void OperationQueue::stopAllDatabaseEvent(const UnsafeStringView& path)
     Operation integerity(Operation::Type::Integrity, path);
     m_timedQueue.remove(integerity);
 
+    Operation incrementalIntegerity(Operation::Type::IncrementalIntegrity, path);
+    m_timedQueue.remove(incrementalIntegerity);
+
     Operation checkpoint(Operation::Type::Checkpoint, path);
     m_timedQueue.remove(checkpoint);
 
@@ -83,8 +89,20 @@ void OperationQueue::stopAllDatabaseEvent(const UnsafeStringView& path)
     Operation compress(Operation::Type::Compress, path);
     m_timedQueue.remove(compress);
 
+    Operation vacuum(Operation::Type::Vacuum, path);
+    m_timedQueue.remove(vacuum);
+
     Operation mergeIndex(Operation::Type::MergeIndex, path);
     m_timedQueue.remove(mergeIndex);
+
+    Operation warmUpHandles(Operation::Type::WarmUpHandles, path);
+    m_timedQueue.remove(warmUpHandles);
+
+    Operation evictIdleHandles(Operation::Type::EvictIdleHandles, path);
+    m_timedQueue.remove(evictIdleHandles);
+
+    Operation prewarm(Operation::Type::Prewarm, path);
+    m_timedQueue.remove(prewarm);
 }
 
 void OperationQueue::stop()
@@ -214,6 +232,9 @@ void OperationQueue::onTimed(const Operation& operation, const Parameter& parame
         case Operation::Type::Compress:
             doCompress(operation.path, parameter.numberOfFailures);
             break;
+        case Operation::Type::Vacuum:
+            doVacuum(operation.path, parameter.numberOfFailures);
+            break;
         case Operation::Type::Checkpoint:
             doCheckpoint(operation.path);
             break;
@@ -224,6 +245,9 @@ void OperationQueue::onTimed(const Operation& operation, const Parameter& parame
         case Operation::Type::Integrity:
             doCheckIntegrity(operation.path);
             break;
+        case Operation::Type::IncrementalIntegrity:
+            doCheckIntegrityIncrementally(operation.path);
+            break;
         case Operation::Type::NotifyCorruption:
             doNotifyCorruption(operation.path, parameter.identifier);
             break;
@@ -233,6 +257,19 @@ void OperationQueue::onTimed(const Operation& operation, const Parameter& parame
         case Operation::Type::Backup:
             doBackup(operation.path);
             break;
+        case Operation::Type::WarmUpHandles:
+            doWarmUpHandles(operation.path);
+            break;
+        case Operation::Type::EvictIdleHandles:
+            doEvictIdleHandles(operation.path);
+            break;
+        case Operation::Type::DrainPerformanceTraces:
+            WCTAssert(operation.path.empty());
+            doDrainPerformanceTraces();
+            break;
+        case Operation::Type::Prewarm:
+            doPrewarm(operation.path);
+            break;
         }
         if (operation.type != Operation::Type::NotifyCorruption) {
             Core::shared().setThreadedErrorIgnorable(false);
@@ -249,8 +286,11 @@ void OperationQueue::async(const Operation& operation, double delay, const Param
 OperationQueue::Record::Record()
 : registeredForMigration(false)
 , registeredForCompression(false)
+, registeredForVacuum(false)
 , registeredForBackup(false)
 , registeredForCheckpoint(false)
+, registeredForMergeFTSIndex(false)
+, registeredForIncrementalIntegrity(false)
 {
 }
 
@@ -398,6 +438,71 @@ void OperationQueue::doCompress(const UnsafeStringView& path, int numberOfFailur
     }
 }
 
+#pragma mark - Vacuum
+void OperationQueue::registerAsRequiredVacuum(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+
+    LockGuard lockGuard(m_lock);
+    m_records[path].registeredForVacuum = true;
+}
+
+void OperationQueue::registerAsNoVacuumRequired(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+
+    LockGuard lockGuard(m_lock);
+    m_records[path].registeredForVacuum = false;
+    Operation operation(Operation::Type::Vacuum, path);
+    m_timedQueue.remove(operation);
+}
+
+void OperationQueue::asyncVacuum(const UnsafeStringView& path)
+{
+    asyncVacuum(path, OperationQueueTimeIntervalForVacuum, 0);
+}
+
+void OperationQueue::asyncVacuum(const UnsafeStringView& path, double delay, int numberOfFailures)
+{
+    WCTAssert(!path.empty());
+    WCTAssert(numberOfFailures >= 0 && numberOfFailures < OperationQueueTolerableFailuresForVacuum);
+
+    SharedLockGuard lockGuard(m_lock);
+    if (m_records[path].registeredForVacuum) {
+        Operation operation(Operation::Type::Vacuum, path);
+        Parameter parameter;
+        parameter.numberOfFailures = numberOfFailures;
+        async(operation, delay, parameter);
+    }
+}
+
+void OperationQueue::doVacuum(const UnsafeStringView& path, int numberOfFailures)
+{
+    WCTAssert(!path.empty());
+    WCTAssert(numberOfFailures >= 0 && numberOfFailures < OperationQueueTolerableFailuresForVacuum);
+
+    auto done = m_event->vacuumShouldBeOperated(path);
+    if (done.succeed()) {
+        if (!done.value()) {
+            asyncVacuum(path, OperationQueueTimeIntervalForVacuum, numberOfFailures);
+        } else {
+            LockGuard lockGuard(m_lock);
+            m_records[path].registeredForVacuum = false;
+        }
+    } else {
+        if (numberOfFailures + 1 < OperationQueueTolerableFailuresForVacuum) {
+            asyncVacuum(path, OperationQueueTimeIntervalForRetringAfterFailure, numberOfFailures + 1);
+        } else {
+            Error error(Error::Code::Notice,
+                        Error::Level::Notice,
+                        "Auto vacuum is stopped due to too many errors.");
+            error.infos.insert_or_assign(ErrorStringKeyPath, path);
+            error.infos.insert_or_assign(ErrorStringKeyType, ErrorTypeVacuum);
+            Notifier::shared().notify(error);
+        }
+    }
+}
+
 #pragma mark - Merge FTS Index
 void OperationQueue::registerAsRequiredMergeFTSIndex(const UnsafeStringView& path)
 {
@@ -602,12 +707,120 @@ void OperationQueue::asyncPurgeWhenMemoryWarning()
     this->asyncPurge(parameter);
 }
 
+#pragma mark - Handles
+void OperationQueue::asyncWarmUpHandles(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+
+    Operation operation(Operation::Type::WarmUpHandles, path);
+    Parameter parameter;
+    async(operation, 0, parameter);
+}
+
+void OperationQueue::asyncEvictIdleHandles(const UnsafeStringView& path, double delay)
+{
+    WCTAssert(!path.empty());
+
+    Operation operation(Operation::Type::EvictIdleHandles, path);
+    Parameter parameter;
+    async(operation,
+          std::max(delay, OperationQueueMinTimeIntervalForEvictingIdleHandles),
+          parameter,
+          AsyncMode::ForwardOnly);
+}
+
+void OperationQueue::doWarmUpHandles(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+
+    m_event->handlesShouldBeWarmedUp(path);
+}
+
+void OperationQueue::doEvictIdleHandles(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+
+    Optional<double> delay = m_event->idleHandlesShouldBeEvicted(path);
+    if (delay.hasValue()) {
+        asyncEvictIdleHandles(path, delay.value());
+    }
+}
+
+#pragma mark - Prewarm
+void OperationQueue::asyncPrewarm(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+
+    Operation operation(Operation::Type::Prewarm, path);
+    Parameter parameter;
+    async(operation, 0, parameter);
+}
+
+void OperationQueue::doPrewarm(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+
+    m_event->pagesShouldBePrewarmed(path);
+}
+
+#pragma mark - Performance Trace
+void OperationQueue::asyncDrainPerformanceTraces()
+{
+    Operation operation(Operation::Type::DrainPerformanceTraces);
+    Parameter parameter;
+    async(operation,
+          OperationQueueTimeIntervalForDrainingPerformanceTraces,
+          parameter,
+          AsyncMode::ForwardOnly);
+}
+
+void OperationQueue::doDrainPerformanceTraces()
+{
+    if (m_event->performanceTracesShouldBeDrained()) {
+        asyncDrainPerformanceTraces();
+    }
+}
+
 #pragma mark - Check Integrity
 void OperationQueue::skipIntegrityCheck(const UnsafeStringView& path)
 {
     m_skipIntegrityCheckPath.getOrCreate() = path;
 }
 
+void OperationQueue::registerAsRequiredIncrementalIntegrity(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+
+    LockGuard lockGuard(m_lock);
+    m_records[path].registeredForIncrementalIntegrity = true;
+}
+
+void OperationQueue::registerAsNoIncrementalIntegrityRequired(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+
+    LockGuard lockGuard(m_lock);
+    m_records[path].registeredForIncrementalIntegrity = false;
+    Operation operation(Operation::Type::IncrementalIntegrity, path);
+    m_timedQueue.remove(operation);
+}
+
+void OperationQueue::asyncCheckIntegrityIncrementally(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+
+    SharedLockGuard lockGuard(m_lock);
+    auto iter = m_records.find(path);
+    if (iter != m_records.end() && iter->second.registeredForIncrementalIntegrity) {
+        Operation operation(Operation::Type::IncrementalIntegrity, path);
+        Parameter parameter; // useless
+        async(operation,
+              OperationQueueTimeIntervalForIncrementalIntegrity,
+              parameter,
+              AsyncMode::ForwardOnly);
+    }
+}
+
 void OperationQueue::asyncCheckIntegrity(const UnsafeStringView& path, uint32_t identifier)
 {
     WCTAssert(!path.empty());
@@ -628,6 +841,13 @@ void OperationQueue::doCheckIntegrity(const UnsafeStringView& path)
     m_event->integrityShouldBeChecked(path);
 }
 
+void OperationQueue::doCheckIntegrityIncrementally(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+
+    m_event->incrementalIntegrityShouldBeChecked(path);
+}
+
 #pragma mark - Corrupted
 void OperationQueue::setNotificationWhenCorrupted(const UnsafeStringView& path,
                                                   const CorruptionNotification& notification)
@@ -35,6 +35,7 @@
 #include "AutoBackupConfig.hpp"
 #include "AutoCheckpointConfig.hpp"
 #include "AutoCompressConfig.hpp"
+#include "AutoIntegrityCheckConfig.hpp"
 #include "AutoMergeFTSIndexConfig.hpp"
 #include "AutoMigrateConfig.hpp"
 #include "OperationQueueForMemory.hpp"
@@ -49,10 +50,18 @@ public:
 protected:
     virtual Optional<bool> migrationShouldBeOperated(const UnsafeStringView& path) = 0;
     virtual Optional<bool> compressionShouldBeOperated(const UnsafeStringView& path) = 0;
+    virtual Optional<bool> vacuumShouldBeOperated(const UnsafeStringView& path) = 0;
     virtual void backupShouldBeOperated(const UnsafeStringView& path) = 0;
     virtual void checkpointShouldBeOperated(const UnsafeStringView& path) = 0;
     virtual void integrityShouldBeChecked(const UnsafeStringView& path) = 0;
+    virtual void incrementalIntegrityShouldBeChecked(const UnsafeStringView& path) = 0;
     virtual void purgeShouldBeOperated() = 0;
+    virtual void handlesShouldBeWarmedUp(const UnsafeStringView& path) = 0;
+    // Return the delay of next eviction. NullOpt means no more eviction is needed.
+    virtual Optional<double> idleHandlesShouldBeEvicted(const UnsafeStringView& path) = 0;
+    // Return false if no more drain is needed.
+    virtual bool performanceTracesShouldBeDrained() = 0;
+    virtual void pagesShouldBePrewarmed(const UnsafeStringView& path) = 0;
 
     using TableArray = AutoMergeFTSIndexOperator::TableArray;
     virtual Optional<bool>
@@ -68,6 +77,7 @@ class OperationQueue final : public AsyncQueue,
                              public AutoCompressOperator,
                              public AutoBackupOperator,
                              public AutoMergeFTSIndexOperator,
+                             public AutoIntegrityCheckOperator,
                              public AutoCheckpointOperator {
 public:
     OperationQueue(const UnsafeStringView& name, OperationEvent* event);
@@ -93,13 +103,19 @@ protected:
     public:
         enum class Type {
             Integrity,
+            IncrementalIntegrity,
             Purge,
             NotifyCorruption,
             Checkpoint,
             Backup,
             Migrate,
             Compress,
+            Vacuum,
             MergeIndex,
+            WarmUpHandles,
+            EvictIdleHandles,
+            DrainPerformanceTraces,
+            Prewarm,
         };
 
         const Type type;
@@ -145,9 +161,11 @@ protected:
         Record();
         bool registeredForMigration;
         bool registeredForCompression;
+        bool registeredForVacuum;
         bool registeredForBackup;
         bool registeredForCheckpoint;
         bool registeredForMergeFTSIndex;
+        bool registeredForIncrementalIntegrity;
     };
     typedef struct Record Record;
     StringViewMap<Record> m_records;
@@ -174,6 +192,16 @@ protected:
     void asyncCompress(const UnsafeStringView& path, double delay, int numberOfFailures);
     void doCompress(const UnsafeStringView& path, int numberOfFailures);
 
+#pragma mark - Vacuum
+public:
+    void registerAsRequiredVacuum(const UnsafeStringView& path);
+    void registerAsNoVacuumRequired(const UnsafeStringView& path);
+    void asyncVacuum(const UnsafeStringView& path);
+
+protected:
+    void asyncVacuum(const UnsafeStringView& path, double delay, int numberOfFailures);
+    void doVacuum(const UnsafeStringView& path, int numberOfFailures);
+
 #pragma mark - Merge FTS Index
 public:
     using TableArray = AutoMergeFTSIndexOperator::TableArray;
@@ -221,14 +249,42 @@ protected:
     SteadyClock m_lastPurge;
     void* m_observerForMemoryWarning;
 
+#pragma mark - Handles
+public:
+    void asyncWarmUpHandles(const UnsafeStringView& path);
+    void asyncEvictIdleHandles(const UnsafeStringView& path, double delay);
+
+protected:
+    void doWarmUpHandles(const UnsafeStringView& path);
+    void doEvictIdleHandles(const UnsafeStringView& path);
+
+#pragma mark - Prewarm
+public:
+    void asyncPrewarm(const UnsafeStringView& path);
+
+protected:
+    void doPrewarm(const UnsafeStringView& path);
+
+#pragma mark - Performance Trace
+public:
+    void asyncDrainPerformanceTraces();
+
+protected:
+    void doDrainPerformanceTraces();
+
 #pragma mark - Integrity
 public:
     void skipIntegrityCheck(const UnsafeStringView& path);
 
+    void registerAsRequiredIncrementalIntegrity(const UnsafeStringView& path);
+    void registerAsNoIncrementalIntegrityRequired(const UnsafeStringView& path);
+    void asyncCheckIntegrityIncrementally(const UnsafeStringView& path) override final;
+
 protected:
     void asyncCheckIntegrity(const UnsafeStringView& path, uint32_t identifier);
 
     void doCheckIntegrity(const UnsafeStringView& path);
+    void doCheckIntegrityIncrementally(const UnsafeStringView& path);
 
     // identifier of the corrupted database file -> the times of ignored corruption
     // it will be kept forever in memory since the identifier will be changed after removed/recovered
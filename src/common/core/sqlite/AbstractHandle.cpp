@@ -36,6 +36,7 @@ namespace WCDB {
 AbstractHandle::AbstractHandle()
 : m_handle(nullptr)
 , m_customOpenFlag(0)
+, m_adaptiveMMap(false)
 , m_tag(Tag::invalid())
 , m_transactionLevel(0)
 , m_transactionError(TransactionError::Allowed)
@@ -198,6 +199,16 @@ bool AbstractHandle::canWriteMainDB()
     return m_customOpenFlag & SQLITE_OPEN_READWRITE;
 }
 
+void AbstractHandle::enableAdaptiveMMap(bool enable)
+{
+    m_adaptiveMMap = enable;
+}
+
+bool AbstractHandle::isAdaptiveMMapEnabled() const
+{
+    return m_adaptiveMMap;
+}
+
 int AbstractHandle::getChanges()
 {
     WCTAssert(isOpened());
@@ -457,6 +468,28 @@ bool AbstractHandle::getSchemaInfo(int &memoryUsed, int &tableCount, int &indexC
            && APIExit(sqlite3_schema_info(m_handle, &tableCount, &indexCount, &triggerCount));
 }
 
+bool AbstractHandle::getCacheStatus(int &memoryUsed, int &hits, int &misses)
+{
+    int highWater;
+    return APIExit(sqlite3_db_status(
+           m_handle, SQLITE_DBSTATUS_CACHE_USED, &memoryUsed, &highWater, false))
+           && APIExit(sqlite3_db_status(m_handle, SQLITE_DBSTATUS_CACHE_HIT, &hits, &highWater, true))
+           && APIExit(sqlite3_db_status(
+           m_handle, SQLITE_DBSTATUS_CACHE_MISS, &misses, &highWater, true));
+}
+
+bool AbstractHandle::setCacheSizeLimit(int64_t bytes)
+{
+    // Negative cache size is the limit in KiB, and -2000 is the default one of sqlite.
+    int64_t cacheSize = bytes > 0 ? -std::max<int64_t>(bytes / 1024, 1) : -2000;
+    return executeStatement(StatementPragma().pragma(Pragma::cacheSize()).to(cacheSize));
+}
+
+void AbstractHandle::releaseCacheMemory()
+{
+    sqlite3_db_release_memory(m_handle);
+}
+
 #pragma mark - Transaction
 void AbstractHandle::markErrorNotAllowedWithinTransaction()
 {
@@ -729,6 +762,23 @@ void AbstractHandle::postSQLNotification(const UnsafeStringView &sql,
     m_notification.postSQLTraceNotification(m_tag, m_path, m_handle, sql, info);
 }
 
+void AbstractHandle::setStatementStatisticsEnable(bool enable)
+{
+    if (isOpened()) {
+        m_notification.setStatementStatisticsEnable(enable);
+    }
+}
+
+bool AbstractHandle::isStatementStatisticsEnabled() const
+{
+    return m_notification.isStatementStatisticsEnabled();
+}
+
+bool AbstractHandle::consumeProfiledPerformance(sqlite3_stmt *stmt, PerformanceInfo &info)
+{
+    return m_notification.consumeProfiledPerformance(stmt, info);
+}
+
 void AbstractHandle::setBusyTraceEnable(bool enable)
 {
     m_busyTrace = enable;
@@ -803,6 +853,15 @@ void AbstractHandle::notifyError(int rc, const UnsafeStringView &sql, const Unsa
 {
     WCTAssert(Error::isError(rc));
     Error::Code code = Error::rc2c(rc);
+    bool ignorable = std::find(m_ignorableCodes.begin(), m_ignorableCodes.end(), rc)
+                     != m_ignorableCodes.end();
+    if (ignorable && code != Error::Code::ZstdError
+        && !Notifier::shared().isObserving(Error::Level::Ignore)) {
+        // Expected failure that nobody listens to. Skip message formatting and notification.
+        m_error.setIgnorableSQLiteCode(rc);
+        m_error.infos.erase(ErrorStringKeySQL);
+        return;
+    }
     if (code == Error::Code::ZstdError) {
         m_error.setCode(code, !msg.empty() ? msg : sqlite3_errmsg(m_handle));
         m_error.infos.insert_or_assign(ErrorStringKeySource, ErrorSourceZstd);
@@ -813,8 +872,7 @@ void AbstractHandle::notifyError(int rc, const UnsafeStringView &sql, const Unsa
         // extended error code/message will not be set in some case for misuse error
         m_error.setSQLiteCode(rc, msg);
     }
-    if (std::find(m_ignorableCodes.begin(), m_ignorableCodes.end(), rc)
-        == m_ignorableCodes.end()) {
+    if (!ignorable) {
         m_error.level = Error::Level::Error;
         if (code == Error::Code::Warning) {
             m_error.level = Error::Level::Warning;
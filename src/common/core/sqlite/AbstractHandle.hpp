@@ -77,6 +77,8 @@ public:
 
     void enableWriteMainDB(bool enable);
     bool canWriteMainDB();
+    void enableAdaptiveMMap(bool enable);
+    bool isAdaptiveMMapEnabled() const;
 
     long long getLastInsertedRowID();
     //    const char *getErrorMessage();
@@ -95,6 +97,7 @@ public:
 
 protected:
     int m_customOpenFlag;
+    bool m_adaptiveMMap;
     Tag m_tag;
 
 #pragma mark - Statement
@@ -134,6 +137,12 @@ public:
 
     bool getSchemaInfo(int &memoryUsed, int &tableCount, int &indexCount, int &triggerCount);
 
+    // The counters of hits and misses are reset after reading.
+    bool getCacheStatus(int &memoryUsed, int &hits, int &misses);
+    // 0 to restore the default cache size of sqlite.
+    bool setCacheSizeLimit(int64_t bytes);
+    void releaseCacheMemory();
+
 #pragma mark - Transaction
 public:
     virtual bool beginTransaction();
@@ -211,6 +220,11 @@ public:
     bool isFullSQLEnable();
     void postSQLNotification(const UnsafeStringView &sql, const UnsafeStringView &info);
 
+    // It only takes effect on an opened handle, and is reset when the handle is closed.
+    void setStatementStatisticsEnable(bool enable);
+    bool isStatementStatisticsEnabled() const;
+    bool consumeProfiledPerformance(sqlite3_stmt *stmt, PerformanceInfo &info);
+
     void setBusyTraceEnable(bool enable);
     bool isBusyTraceEnable() const;
     void setCurrentSQL(const UnsafeStringView &sql);
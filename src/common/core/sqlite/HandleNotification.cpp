@@ -35,9 +35,12 @@ HandleNotification::~HandleNotification() = default;
 void HandleNotification::purge()
 {
     bool isOpened = getHandle()->isOpened();
-    bool set = areSQLTraceNotificationsSet() || arePerformanceTraceNotificationsSet();
+    bool set = areSQLTraceNotificationsSet() || arePerformanceTraceNotificationsSet()
+               || m_statementStatistics;
     m_sqlNotifications.clear();
     m_performanceNotifications.clear();
+    m_statementStatistics = false;
+    m_profiledStmt = nullptr;
     if (set && isOpened) {
         setupTraceNotifications();
     }
@@ -82,9 +85,15 @@ void HandleNotification::postTraceNotification(unsigned int flag, void *P, void
     case SQLITE_TRACE_PROFILE: {
         const char *sql = sqlite3_sql(stmt);
         PerformanceInfo *info = (PerformanceInfo *) X;
-        AbstractHandle *handle = getHandle();
-        postPerformanceTraceNotification(
-        handle->getTag(), handle->getPath(), getHandle(), sql, *info);
+        if (m_statementStatistics) {
+            m_profiledStmt = stmt;
+            m_profiledPerformance = *info;
+        }
+        if (arePerformanceTraceNotificationsSet()) {
+            AbstractHandle *handle = getHandle();
+            postPerformanceTraceNotification(
+            handle->getTag(), handle->getPath(), getHandle(), sql, *info);
+        }
     } break;
     default:
         break;
@@ -97,7 +106,7 @@ void HandleNotification::setupTraceNotifications()
     if (!m_sqlNotifications.empty() && !m_fullSQLTrace) {
         flag |= SQLITE_TRACE_STMT;
     }
-    if (!m_performanceNotifications.empty()) {
+    if (!m_performanceNotifications.empty() || m_statementStatistics) {
         flag |= SQLITE_TRACE_PROFILE;
     }
     if (flag != 0) {
@@ -182,6 +191,32 @@ void HandleNotification::postPerformanceTraceNotification(const Tag &tag,
     }
 }
 
+#pragma mark - Statement Statistics
+void HandleNotification::setStatementStatisticsEnable(bool enable)
+{
+    bool before = m_statementStatistics;
+    m_statementStatistics = enable;
+    m_profiledStmt = nullptr;
+    if (before != enable) {
+        setupTraceNotifications();
+    }
+}
+
+bool HandleNotification::isStatementStatisticsEnabled() const
+{
+    return m_statementStatistics;
+}
+
+bool HandleNotification::consumeProfiledPerformance(sqlite3_stmt *stmt, PerformanceInfo &info)
+{
+    if (stmt == nullptr || m_profiledStmt != stmt) {
+        return false;
+    }
+    info = m_profiledPerformance;
+    m_profiledStmt = nullptr;
+    return true;
+}
+
 #pragma mark - Committed
 int HandleNotification::committed(void *p, sqlite3 *handle, const char *name, int numberOfFrames)
 {
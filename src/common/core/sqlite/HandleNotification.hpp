@@ -91,6 +91,18 @@ private:
                                           const PerformanceInfo &info);
     StringViewMap<PerformanceNotification> m_performanceNotifications;
 
+#pragma mark - Statement Statistics
+public:
+    void setStatementStatisticsEnable(bool enable);
+    bool isStatementStatisticsEnabled() const;
+    // Take the performance of the statement profiled most recently, if it is the specified one.
+    bool consumeProfiledPerformance(sqlite3_stmt *stmt, PerformanceInfo &info);
+
+private:
+    bool m_statementStatistics = false;
+    sqlite3_stmt *m_profiledStmt = nullptr;
+    PerformanceInfo m_profiledPerformance;
+
 #pragma mark - Committed
 public:
     //committed dispatch will abort if any notification return false
@@ -161,6 +173,7 @@ private:
 
 #pragma mark - Table Modification
 public:
+    // Both tables are empty if the modified table of a write statement is unknown.
     typedef std::function<void(const UnsafeStringView &path, const UnsafeStringView &newTable, const UnsafeStringView &modifiedTable)> TableModifiedNotification;
     void setNotificationWhenTableModified(const UnsafeStringView &name,
                                           const TableModifiedNotification &tableModified);
@@ -34,6 +34,7 @@
 #include "MigratingHandleDecorator.hpp"
 #include "MigrationInfo.hpp"
 #include "SQLite.h"
+#include "StatementStatistics.hpp"
 #include "WINQ.h"
 #include <iomanip>
 #include <string.h>
@@ -51,6 +52,8 @@ HandleStatement::HandleStatement(HandleStatement &&other)
 , m_fullTrace(other.m_fullTrace)
 , m_needReport(other.m_needReport)
 , m_stepCount(other.m_stepCount)
+, m_fingerprint(std::move(other.m_fingerprint))
+, m_numberOfRows(other.m_numberOfRows)
 {
     other.m_done = false;
     other.m_stmt = nullptr;
@@ -64,6 +67,7 @@ HandleStatement::HandleStatement(AbstractHandle *handle)
 , m_fullTrace(handle->isFullSQLEnable())
 , m_needReport(false)
 , m_stepCount(0)
+, m_numberOfRows(0)
 {
 }
 
@@ -78,11 +82,19 @@ bool HandleStatement::prepare(const Statement &statement)
         analysisStatement(statement);
     }
 
+    StringView fingerprint;
+    if (getHandle()->isStatementStatisticsEnabled()) {
+        fingerprint = StatementStatistics::fingerprint(statement);
+    }
+
     const StringView &sql = statement.getDescription();
     if (m_needAutoAddColumn) {
         cacheCurrentTransactionError();
     }
     if (prepareSQL(sql)) {
+        if (!fingerprint.empty()) {
+            m_fingerprint = fingerprint;
+        }
         return true;
     }
 
@@ -140,7 +152,13 @@ bool HandleStatement::prepare(const Statement &statement)
     }
 
     resumeCacheTransactionError();
-    return prepareSQL(sql);
+    if (!prepareSQL(sql)) {
+        return false;
+    }
+    if (!fingerprint.empty()) {
+        m_fingerprint = fingerprint;
+    }
+    return true;
 }
 
 void HandleStatement::analysisStatement(const Statement &statement)
@@ -379,8 +397,10 @@ bool HandleStatement::prepareSQL(const UnsafeStringView &sql)
     sqlite3_prepare_v2(getRawHandle(), sql.data(), -1, &m_stmt, nullptr), sql);
     m_done = false;
     m_fullTrace = getHandle()->isFullSQLEnable();
+    m_numberOfRows = 0;
     if (!result) {
         m_stmt = nullptr;
+        m_fingerprint.clear();
     } else {
         if (m_fullTrace) {
             clearReport();
@@ -388,6 +408,10 @@ bool HandleStatement::prepareSQL(const UnsafeStringView &sql)
         if (isBusyTraceEnable()) {
             m_sql = sql;
         }
+        if (getHandle()->isStatementStatisticsEnabled()) {
+            // The literals can't be stripped without the syntax tree.
+            m_fingerprint = sql;
+        }
     }
     return result;
 }
@@ -397,6 +421,8 @@ void HandleStatement::reset()
     WCTAssert(isPrepared());
     tryReportSQL();
     APIExit(sqlite3_reset(m_stmt));
+    tryReportStatistics();
+    m_numberOfRows = 0;
 }
 
 void HandleStatement::clearBindings()
@@ -426,8 +452,9 @@ bool HandleStatement::step()
     }
 
     if (m_done) {
+        // A write whose table can't be analyzed is posted with both tables empty.
         if (getHandle()->needMonitorTable()
-            && (!m_newTable.empty() || !m_modifiedTable.empty())) {
+            && (!m_newTable.empty() || !m_modifiedTable.empty() || !isReadOnly())) {
             getHandle()->postTableNotification(m_newTable, m_modifiedTable);
         }
         tryReportSQL();
@@ -435,6 +462,12 @@ bool HandleStatement::step()
         m_stepCount++;
     }
 
+    if (rc == SQLITE_ROW) {
+        m_numberOfRows++;
+    } else {
+        tryReportStatistics();
+    }
+
     const char *sql = nullptr;
     if (isPrepared()) {
         // There will be privacy issues if use sqlite3_expanded_sql
@@ -449,7 +482,12 @@ void HandleStatement::finalize()
         tryReportSQL();
         // no need to call APIExit since it returns old code only.
         sqlite3_finalize(m_stmt);
+        tryReportStatistics();
         m_stmt = nullptr;
+        m_fingerprint.clear();
+        m_numberOfRows = 0;
+        m_newTable.clear();
+        m_modifiedTable.clear();
         resetCurrentSQL(m_sql);
         m_sql.clear();
     }
@@ -797,6 +835,24 @@ void HandleStatement::tryReportSQL()
     clearReport();
 }
 
+#pragma mark - Statement statistics
+void HandleStatement::tryReportStatistics()
+{
+    // The performance is profiled by sqlite while the statement is stepped to the end, reset or finalized.
+    AbstractHandle::PerformanceInfo info;
+    if (!getHandle()->consumeProfiledPerformance(m_stmt, info) || m_fingerprint.empty()) {
+        return;
+    }
+    StatementStatistics::shared().record(
+    getHandle()->getPath(),
+    m_fingerprint,
+    info.costInNanoseconds,
+    info.tablePageReadCount + info.indexPageReadCount + info.overflowPageReadCount,
+    info.tablePageWriteCount + info.indexPageWriteCount + info.overflowPageWriteCount,
+    m_numberOfRows);
+    m_numberOfRows = 0;
+}
+
 void HandleStatement::clearReport()
 {
     m_stream.str("");
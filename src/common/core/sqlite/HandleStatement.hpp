@@ -129,6 +129,13 @@ private:
     bool m_needReport;
     int m_stepCount;
     std::ostringstream m_stream;
+
+#pragma mark - Statement statistics
+private:
+    void tryReportStatistics();
+
+    StringView m_fingerprint;
+    int64_t m_numberOfRows;
 };
 
 } //namespace WCDB
@@ -24,41 +24,99 @@
 
 #include "VacuumHandleOperator.hpp"
 #include "CoreConst.h"
+#include "FileManager.hpp"
+#include "VacuumCheckpoint.hpp"
 #include "WINQ.h"
+#include <algorithm>
+#include <limits>
 
 namespace WCDB {
 
 const char *VacuumHandleOperator::kOriginSchema = "origin";
 
 VacuumHandleOperator::VacuumHandleOperator(InnerHandle *handle)
-: HandleOperator(handle), Repair::VacuumDelegate(), m_tableWeight(0)
+: HandleOperator(handle)
+, Repair::VacuumDelegate()
+, m_tableWeight(0)
+, m_workerHandleGenerator(nullptr)
+, m_maxNumberOfWorkers(0)
+, m_stopWorkers(false)
+, m_numberOfRunningWorkers(0)
+, m_pendingWorkerProgress(0)
+, m_workerFailed(false)
 {
 }
 
 VacuumHandleOperator::~VacuumHandleOperator()
 {
+    stopWorkers();
 }
 
 #pragma mark - Vacuum
 bool VacuumHandleOperator::executeVacuum()
 {
-    if (!configDatabase()) {
-        return false;
+    m_paused = false;
+    m_startTime = SteadyClock::now();
+    m_lastCommitTime = m_startTime;
+    bool succeed = copyTables();
+    stopWorkers();
+    if (succeed && !m_paused) {
+        succeed = createAssociatedItems();
+    }
+    InnerHandle *handle = getHandle();
+    if (succeed) {
+        succeed = commitBatch();
+    } else if (handle->isInTransaction()) {
+        // The last saved checkpoint matches the committed rows.
+        handle->rollbackTransaction();
     }
-    if (!initTables()) {
+    if (!succeed) {
         return false;
     }
+    handle->close();
+    return m_paused || finishProgress();
+}
+
+const Error &VacuumHandleOperator::getVacuumError()
+{
+    if (m_workerFailed) {
+        return m_workerError;
+    }
+    return getHandle()->getError();
+}
+
+bool VacuumHandleOperator::copyTables()
+{
     InnerHandle *handle = getHandle();
+    if (!configDatabase(handle, m_vacuumPath, true)) {
+        return false;
+    }
+    if (!initTables() || !dropStaleTables()) {
+        return false;
+    }
     WCTAssert(handle->isOpened());
-    auto seqIter = m_tables.find(Syntax::sequenceTable);
-    if (seqIter != m_tables.end() && !copyWithouRowidTable(seqIter->second)) {
+    if (!startWorkers() || !beginBatch()) {
         return false;
     }
+    auto seqIter = m_tables.find(Syntax::sequenceTable);
+    if (seqIter != m_tables.end()) {
+        if (isTableFinished(Syntax::sequenceTable)) {
+            if (!increaseProgress(m_tableWeight)) {
+                return false;
+            }
+        } else if (!copyWithouRowidTable(seqIter->second)) {
+            return false;
+        }
+    }
     bool needCheckShadowTable = false;
     for (const auto &table : m_tables) {
         if (table.first.equal(Syntax::sequenceTable)) {
             continue;
         }
+        if (m_parallelTables.find(table.first) != m_parallelTables.end()) {
+            // Copied by workers.
+            continue;
+        }
         if (needCheckShadowTable) {
             auto exist = handle->tableExists(table.first);
             if (exist.failed()) {
@@ -73,44 +131,53 @@ bool VacuumHandleOperator::executeVacuum()
         if (attribute.failed()) {
             return false;
         }
-        if (attribute.value().withoutRowid) {
+        if (attribute.value().isVirtual) {
+            needCheckShadowTable = true;
+        }
+        if (isTableFinished(table.first)) {
+            // Copied by last vacuum.
+            if (!increaseProgress(m_tableWeight)) {
+                return false;
+            }
+            continue;
+        }
+        if (isTimeSliceExhausted()) {
+            m_paused = true;
+        } else if (attribute.value().withoutRowid) {
             if (!copyWithouRowidTable(table.second)) {
                 return false;
             }
         } else {
-            if (attribute.value().isVirtual) {
-                needCheckShadowTable = true;
-            }
             if (!copyNormalTable(table.second)) {
                 return false;
             }
         }
-    }
-    for (const auto &sql : m_associatedSQLs) {
-        if (!handle->execute(sql)) {
+        if (m_paused) {
+            return true;
+        }
+        if (!reportWorkerProgress()) {
             return false;
         }
     }
-    handle->close();
-    return finishProgress();
+    return waitForWorkers() && mergeStagingDatabases();
 }
 
-const Error &VacuumHandleOperator::getVacuumError()
-{
-    return getHandle()->getError();
-}
-
-bool VacuumHandleOperator::configDatabase()
+bool VacuumHandleOperator::configDatabase(InnerHandle *handle, const UnsafeStringView &path, bool durable)
 {
-    WCTAssert(!m_vacuumPath.empty());
+    WCTAssert(!path.empty());
     WCTAssert(!m_originalPath.empty());
-    InnerHandle *handle = getHandle();
     WCTAssert(!handle->isOpened());
-    handle->setPath(m_vacuumPath);
+    handle->setPath(path);
     if (!handle->open()) {
         return false;
     }
-    if (!handle->execute(StatementPragma().pragma(Pragma::journalMode()).to("OFF"))) {
+    // Staging databases are discarded if vacuum is interrupted, so they are not journaled.
+    if (!handle->execute(
+        StatementPragma().pragma(Pragma::journalMode()).to(durable ? "DELETE" : "OFF"))) {
+        return false;
+    }
+    if (durable
+        && !handle->execute(StatementPragma().pragma(Pragma::synchronous()).to("FULL"))) {
         return false;
     }
     if (!handle->execute(StatementPragma().pragma(Pragma::mmapSize()).to(2147418112))) {
@@ -168,7 +235,7 @@ bool VacuumHandleOperator::initTables()
                 }
             }
         } else {
-            m_associatedSQLs.push_back(row[4].textValue());
+            m_associatedSQLs.push_back({ row[1].textValue(), row[4].textValue() });
         }
         if (!handle->step()) {
             handle->finalize();
@@ -180,9 +247,41 @@ bool VacuumHandleOperator::initTables()
     return true;
 }
 
-bool VacuumHandleOperator::createTable(const TableInfo &info)
+bool VacuumHandleOperator::dropStaleTables()
+{
+    if (m_checkpoint == nullptr) {
+        return true;
+    }
+    // The tables copied by last vacuum may be dropped or renamed in the original database since then.
+    StringViewSet staleTables;
+    for (const auto &table : m_checkpoint->finishedTables) {
+        if (m_tables.find(table) == m_tables.end()) {
+            staleTables.emplace(table);
+        }
+    }
+    for (const auto &table : m_checkpoint->copyingTables) {
+        if (m_tables.find(table.first) == m_tables.end()) {
+            staleTables.emplace(table.first);
+        }
+    }
+    for (const auto &table : staleTables) {
+        m_checkpoint->finishedTables.erase(table);
+        m_checkpoint->copyingTables.erase(table);
+        m_checkpoint->restartedTables.erase(table);
+        if (table.equal(Syntax::sequenceTable)) {
+            // Sequence table can not be dropped.
+            continue;
+        }
+        if (!getHandle()->execute(
+            StatementDropTable().dropTable(table).schema(Schema::main()).ifExists())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool VacuumHandleOperator::createTable(InnerHandle *handle, const TableInfo &info)
 {
-    InnerHandle *handle = getHandle();
     WCTAssert(handle->isOpened());
     if (!handle->execute(info.sql)) {
         return false;
@@ -195,60 +294,413 @@ bool VacuumHandleOperator::createTable(const TableInfo &info)
     return true;
 }
 
+bool VacuumHandleOperator::recreateTable(const TableInfo &info)
+{
+    // The table may be partially created by last vacuum.
+    if (!getHandle()->execute(
+        StatementDropTable().dropTable(info.name).schema(Schema::main()).ifExists())) {
+        return false;
+    }
+    return createTable(getHandle(), info);
+}
+
+Optional<std::pair<int64_t, int64_t>>
+VacuumHandleOperator::getRowidRange(InnerHandle *handle, const UnsafeStringView &table)
+{
+    WCTAssert(handle->isOpened());
+    auto select = StatementSelect()
+                  .select({ Column::rowid().min(), Column::rowid().max() })
+                  .from(TableOrSubquery(table).schema(kOriginSchema));
+    if (!handle->prepare(select)) {
+        return NullOpt;
+    }
+    if (!handle->step()) {
+        handle->finalize();
+        return NullOpt;
+    }
+    std::pair<int64_t, int64_t> range = { 0, 0 };
+    if (!handle->done()) {
+        range = { handle->getInteger(0), handle->getInteger(1) };
+    }
+    handle->finalize();
+    return range;
+}
+
 bool VacuumHandleOperator::copyWithouRowidTable(const TableInfo &info)
 {
-    if (!createTable(info)) {
+    InnerHandle *handle = getHandle();
+    WCTAssert(handle->isOpened());
+    if (info.name.equal(Syntax::sequenceTable)) {
+        // Sequence table can not be dropped.
+        auto exists = handle->tableExists(info.name);
+        if (exists.failed()) {
+            return false;
+        }
+        if (exists.value()) {
+            if (!handle->execute(StatementDelete().deleteFrom(
+                QualifiedTable(info.name).schema(Schema::main())))) {
+                return false;
+            }
+        } else if (!createTable(handle, info)) {
+            return false;
+        }
+    } else if (!recreateTable(info)) {
         return false;
     }
     StatementInsert insert = StatementInsert().insertIntoTable(info.name).values(
     StatementSelect().select(Column::all()).from(TableOrSubquery(info.name).schema(kOriginSchema)));
-    if (!getHandle()->execute(insert)) {
+    if (!handle->execute(insert)) {
         return false;
     }
-    return increaseProgress(m_tableWeight);
+    markTableAsFinished(info.name);
+    return tryCommitBatch() && increaseProgress(m_tableWeight);
 }
 
 bool VacuumHandleOperator::copyNormalTable(const TableInfo &info)
 {
-    if (!createTable(info)) {
-        return false;
-    }
     InnerHandle *handle = getHandle();
     WCTAssert(handle->isOpened());
-    auto selectMaxRowid = StatementSelect()
-                          .select(Column::rowid().max())
-                          .from(TableOrSubquery(info.name).schema(kOriginSchema));
-    if (!handle->prepare(selectMaxRowid)) {
+    auto rowidRange = getRowidRange(handle, info.name);
+    if (rowidRange.failed()) {
         return false;
     }
-    if (!handle->step()) {
-        handle->finalize();
+    int64_t minRowid = rowidRange.value().first;
+    int64_t maxRowid = rowidRange.value().second;
+
+    auto resumedRowid = getResumedRowid(info, minRowid);
+    if (resumedRowid.failed()) {
         return false;
     }
-    if (handle->done()) {
-        handle->finalize();
-        return increaseProgress(m_tableWeight);
+    int64_t curMinRowid = resumedRowid.value();
+    if (curMinRowid > minRowid
+        && !increaseProgress((double) (curMinRowid - minRowid) / (maxRowid - minRowid + 1)
+                             * m_tableWeight)) {
+        return false;
     }
-    int64_t maxRowid = handle->getInteger();
-    handle->finalize();
 
-    auto selectMinRowid = StatementSelect()
-                          .select(Column::rowid().min())
-                          .from(TableOrSubquery(info.name).schema(kOriginSchema));
-    if (!handle->prepare(selectMinRowid)) {
+    auto optionalMetas = handle->getTableMeta(Schema(), info.name);
+    if (!optionalMetas.succeed()) {
         return false;
     }
-    if (!handle->step()) {
+    auto &metas = optionalMetas.value();
+    Columns columns = { Column::rowid() };
+    for (const auto &meta : metas) {
+        columns.push_back(Column(meta.name));
+    }
+
+    auto insert = StatementInsert().insertIntoTable(info.name).columns(columns).values(
+    StatementSelect()
+    .select(columns)
+    .from(TableOrSubquery(info.name).schema(kOriginSchema))
+    .where(Column::rowid() >= BindParameter())
+    .order(Column::rowid().asOrder(Order::ASC))
+    .limit(VacuumBatchCount));
+    if (!handle->prepare(insert)) {
+        return false;
+    }
+    do {
+        handle->reset();
+        handle->bindInteger(curMinRowid);
+        if (!handle->step()) {
+            handle->finalize();
+            return false;
+        }
+        if (handle->getChanges() == 0) {
+            break;
+        }
+        int64_t lastRowid = handle->getLastInsertedRowID();
+        markTableAsCopying(info.name, lastRowid);
+        if (!tryCommitBatch()) {
+            handle->finalize();
+            return false;
+        }
+        double incre
+        = (double) (lastRowid - curMinRowid + 1) / (maxRowid - minRowid + 1) * m_tableWeight;
+        WCTAssert(incre >= 0);
+        if (!increaseProgress(incre)) {
+            handle->finalize();
+            return false;
+        }
+        curMinRowid = lastRowid + 1;
+        if (isTimeSliceExhausted()) {
+            handle->finalize();
+            m_paused = true;
+            return true;
+        }
+    } while (true);
+    handle->finalize();
+    markTableAsFinished(info.name);
+    return tryCommitBatch();
+}
+
+bool VacuumHandleOperator::createAssociatedItems()
+{
+    InnerHandle *handle = getHandle();
+    WCTAssert(handle->isOpened());
+    auto select = StatementSelect()
+                  .select(1)
+                  .from(TableOrSubquery(Syntax::masterTable).schema(Schema::main()))
+                  .where(Column("name") == BindParameter())
+                  .limit(1);
+    for (const auto &associated : m_associatedSQLs) {
+        // The item may be created by last vacuum.
+        if (!handle->prepare(select)) {
+            return false;
+        }
+        handle->bindText(associated.first);
+        if (!handle->step()) {
+            handle->finalize();
+            return false;
+        }
+        bool exists = !handle->done();
         handle->finalize();
+        if (!exists && !handle->execute(associated.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#pragma mark - Checkpoint
+bool VacuumHandleOperator::beginBatch()
+{
+    InnerHandle *handle = getHandle();
+    return handle->isInTransaction() || handle->beginTransaction();
+}
+
+bool VacuumHandleOperator::commitBatch()
+{
+    InnerHandle *handle = getHandle();
+    if (handle->isInTransaction() && !handle->commitTransaction()) {
         return false;
     }
-    if (handle->done()) {
+    // The committed rows are durable since the vacuum database is fully synchronized.
+    saveCheckpoint();
+    m_lastCommitTime = SteadyClock::now();
+    return true;
+}
+
+bool VacuumHandleOperator::tryCommitBatch()
+{
+    if (SteadyClock::timeIntervalSinceSteadyClockToNow(m_lastCommitTime) < VacuumCheckpointInterval) {
+        return true;
+    }
+    return commitBatch() && beginBatch();
+}
+
+bool VacuumHandleOperator::isTableFinished(const UnsafeStringView &table) const
+{
+    return m_checkpoint != nullptr
+           && m_checkpoint->finishedTables.find(table) != m_checkpoint->finishedTables.end();
+}
+
+Optional<int64_t> VacuumHandleOperator::getCopiedRowid(const UnsafeStringView &table) const
+{
+    if (m_checkpoint != nullptr) {
+        auto iter = m_checkpoint->copyingTables.find(table);
+        if (iter != m_checkpoint->copyingTables.end()) {
+            return iter->second;
+        }
+    }
+    return NullOpt;
+}
+
+Optional<int64_t> VacuumHandleOperator::getResumedRowid(const TableInfo &info, int64_t minRowid)
+{
+    InnerHandle *handle = getHandle();
+    auto copiedRowid = getCopiedRowid(info.name);
+    if (copiedRowid.succeed()) {
+        if (!handle->prepare(StatementSelect()
+                             .select(Column::rowid().max())
+                             .from(TableOrSubquery(info.name).schema(Schema::main())))) {
+            return NullOpt;
+        }
+        if (!handle->step()) {
+            handle->finalize();
+            return NullOpt;
+        }
+        bool empty = handle->done() || handle->getColumnType(0) == ColumnType::Null;
+        int64_t maxCopiedRowid = empty ? 0 : (int64_t) handle->getInteger();
         handle->finalize();
-        return increaseProgress(m_tableWeight);
+        // Rows after the checkpoint may be copied but not recorded.
+        // On the contrary, if the recorded rows are missing, the table should be copied again.
+        if (!empty && maxCopiedRowid >= copiedRowid.value()) {
+            return maxCopiedRowid + 1;
+        }
+        if (empty && copiedRowid.value() < minRowid) {
+            return minRowid;
+        }
     }
-    int64_t minRowid = handle->getInteger();
-    handle->finalize();
+    if (!recreateTable(info)) {
+        return NullOpt;
+    }
+    if (minRowid > std::numeric_limits<int64_t>::min()) {
+        markTableAsCopying(info.name, minRowid - 1);
+    }
+    return minRowid;
+}
+
+void VacuumHandleOperator::markTableAsCopying(const UnsafeStringView &table, int64_t lastRowid)
+{
+    if (m_checkpoint != nullptr) {
+        m_checkpoint->copyingTables.insert_or_assign(table, lastRowid);
+    }
+}
+
+void VacuumHandleOperator::markTableAsFinished(const UnsafeStringView &table)
+{
+    if (m_checkpoint != nullptr) {
+        m_checkpoint->copyingTables.erase(table);
+        m_checkpoint->restartedTables.erase(table);
+        m_checkpoint->finishedTables.emplace(table);
+    }
+}
 
+bool VacuumHandleOperator::isTimeSliceExhausted() const
+{
+    return m_timeSlice > 0
+           && SteadyClock::timeIntervalSinceSteadyClockToNow(m_startTime) > m_timeSlice;
+}
+
+#pragma mark - Parallel
+void VacuumHandleOperator::setWorkerHandleGenerator(const WorkerHandleGenerator &generator,
+                                                    int maxNumberOfWorkers)
+{
+    m_workerHandleGenerator = generator;
+    m_maxNumberOfWorkers = maxNumberOfWorkers;
+}
+
+bool VacuumHandleOperator::startWorkers()
+{
+    WCTAssert(m_workers.empty());
+    int maxNumberOfWorkers
+    = std::min(m_maxNumberOfWorkers, (int) std::thread::hardware_concurrency() - 1);
+    // Time-sliced vacuum copies tables one by one so that the progress can be saved.
+    if (m_workerHandleGenerator == nullptr || maxNumberOfWorkers <= 0 || m_timeSlice > 0) {
+        return true;
+    }
+    InnerHandle *handle = getHandle();
+    std::list<StringView> virtualTables;
+    std::vector<ParallelTable> candidates;
+    for (const auto &table : m_tables) {
+        if (table.first.equal(Syntax::sequenceTable) || isTableFinished(table.first)
+            || getCopiedRowid(table.first).succeed()) {
+            continue;
+        }
+        auto attribute = handle->getTableAttribute(kOriginSchema, table.first);
+        if (attribute.failed()) {
+            return false;
+        }
+        if (attribute.value().isVirtual) {
+            virtualTables.push_back(table.first);
+            continue;
+        }
+        if (attribute.value().withoutRowid) {
+            continue;
+        }
+        auto rowidRange = getRowidRange(handle, table.first);
+        if (rowidRange.failed()) {
+            return false;
+        }
+        if (rowidRange.value().second - rowidRange.value().first + 1 < VacuumMinParallelRowCount) {
+            continue;
+        }
+        candidates.push_back(
+        { &table.second, rowidRange.value().first, rowidRange.value().second });
+    }
+    // Shadow tables are created along with their virtual tables.
+    candidates.erase(
+    std::remove_if(candidates.begin(),
+                   candidates.end(),
+                   [&virtualTables](const ParallelTable &table) {
+                       for (const auto &virtualTable : virtualTables) {
+                           if (table.info->name.size() > virtualTable.size()
+                               && table.info->name.hasPrefix(virtualTable)
+                               && table.info->name.at(virtualTable.size()) == '_') {
+                               return true;
+                           }
+                       }
+                       return false;
+                   }),
+    candidates.end());
+    if (candidates.empty()) {
+        return true;
+    }
+
+    // Assign the largest table to the least loaded worker.
+    std::sort(candidates.begin(),
+              candidates.end(),
+              [](const ParallelTable &left, const ParallelTable &right) {
+                  return left.maxRowid - left.minRowid > right.maxRowid - right.minRowid;
+              });
+    int numberOfWorkers = std::min(maxNumberOfWorkers, (int) candidates.size());
+    for (int i = 0; i < numberOfWorkers; ++i) {
+        std::shared_ptr<InnerHandle> workerHandle = m_workerHandleGenerator();
+        if (workerHandle == nullptr) {
+            // Fallback to copy by current handle.
+            break;
+        }
+        StringView stagingPath = StringView::formatted("%s-staging-%d", m_vacuumPath.data(), i);
+        if (!FileManager::removeItem(stagingPath)) {
+            break;
+        }
+        m_workers.emplace_back();
+        Worker &worker = m_workers.back();
+        worker.handle = workerHandle;
+        worker.stagingPath = stagingPath;
+        worker.numberOfRows = 0;
+    }
+    if (m_workers.empty()) {
+        return true;
+    }
+    for (const auto &candidate : candidates) {
+        auto worker = std::min_element(
+        m_workers.begin(), m_workers.end(), [](const Worker &left, const Worker &right) {
+            return left.numberOfRows < right.numberOfRows;
+        });
+        worker->tables.push_back(candidate);
+        worker->numberOfRows += candidate.maxRowid - candidate.minRowid + 1;
+        m_parallelTables.emplace(candidate.info->name);
+    }
+
+    m_stopWorkers = false;
+    m_numberOfRunningWorkers = (int) m_workers.size();
+    for (auto &worker : m_workers) {
+        worker.thread = std::thread(&VacuumHandleOperator::runWorker, this, std::ref(worker));
+    }
+    return true;
+}
+
+void VacuumHandleOperator::runWorker(Worker &worker)
+{
+    InnerHandle *handle = worker.handle.get();
+    bool succeed = configDatabase(handle, worker.stagingPath, false);
+    for (const auto &table : worker.tables) {
+        if (!succeed || m_stopWorkers) {
+            break;
+        }
+        succeed = createTable(handle, *table.info) && copyRowsInWorker(handle, table);
+    }
+    Error error;
+    if (!succeed) {
+        error = handle->getError();
+    }
+    // Staging database should be closed before merged.
+    handle->close();
+    {
+        std::lock_guard<std::mutex> lockGuard(m_workerLock);
+        if (!succeed && !m_stopWorkers && !m_workerFailed) {
+            m_workerFailed = true;
+            m_workerError = std::move(error);
+        }
+        --m_numberOfRunningWorkers;
+    }
+    m_workerCond.notify_all();
+}
+
+bool VacuumHandleOperator::copyRowsInWorker(InnerHandle *handle, const ParallelTable &table)
+{
+    const TableInfo &info = *table.info;
     auto optionalMetas = handle->getTableMeta(Schema(), info.name);
     if (!optionalMetas.succeed()) {
         return false;
@@ -269,25 +721,124 @@ bool VacuumHandleOperator::copyNormalTable(const TableInfo &info)
     if (!handle->prepare(insert)) {
         return false;
     }
-    int64_t curMinRowid = minRowid;
-    do {
+    int64_t curMinRowid = table.minRowid;
+    while (!m_stopWorkers) {
         handle->reset();
         handle->bindInteger(curMinRowid);
         if (!handle->step()) {
             handle->finalize();
             return false;
         }
-        double incre = (double) (handle->getLastInsertedRowID() - curMinRowid + 1)
-                       / (maxRowid - minRowid + 1) * m_tableWeight;
-        WCTAssert(incre >= 0);
-        if (!increaseProgress(incre)) {
-            handle->finalize();
-            return false;
+        if (handle->getChanges() == 0) {
+            break;
         }
-        curMinRowid = handle->getLastInsertedRowID() + 1;
-    } while (handle->getChanges() > 0);
+        int64_t lastRowid = handle->getLastInsertedRowID();
+        {
+            std::lock_guard<std::mutex> lockGuard(m_workerLock);
+            m_pendingWorkerProgress += (double) (lastRowid - curMinRowid + 1)
+                                       / (table.maxRowid - table.minRowid + 1)
+                                       * m_tableWeight;
+        }
+        curMinRowid = lastRowid + 1;
+    }
     handle->finalize();
     return true;
 }
 
+bool VacuumHandleOperator::reportWorkerProgress()
+{
+    if (m_workers.empty()) {
+        return true;
+    }
+    double increment = 0;
+    {
+        std::lock_guard<std::mutex> lockGuard(m_workerLock);
+        if (m_workerFailed) {
+            return false;
+        }
+        // Tiny increment is accumulated until it's large enough to be reported.
+        if (m_pendingWorkerProgress > 0.001) {
+            increment = m_pendingWorkerProgress;
+            m_pendingWorkerProgress = 0;
+        }
+    }
+    return increment == 0 || increaseProgress(increment);
+}
+
+bool VacuumHandleOperator::waitForWorkers()
+{
+    bool running = true;
+    while (running) {
+        {
+            std::unique_lock<std::mutex> lockGuard(m_workerLock);
+            if (m_numberOfRunningWorkers > 0 && !m_workerFailed) {
+                m_workerCond.wait_for(lockGuard, 0.1);
+            }
+            running = m_numberOfRunningWorkers > 0;
+        }
+        if (!reportWorkerProgress()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void VacuumHandleOperator::stopWorkers()
+{
+    m_stopWorkers = true;
+    for (auto &worker : m_workers) {
+        if (worker.thread.joinable()) {
+            worker.thread.join();
+        }
+        FileManager::removeItem(worker.stagingPath);
+    }
+    m_workers.clear();
+    m_parallelTables.clear();
+}
+
+bool VacuumHandleOperator::mergeStagingDatabases()
+{
+    InnerHandle *handle = getHandle();
+    if (m_workers.empty()) {
+        return true;
+    }
+    // Staging databases can't be attached within a transaction.
+    if (!commitBatch()) {
+        return false;
+    }
+    int index = 0;
+    for (const auto &worker : m_workers) {
+        Schema staging(StringView::formatted("staging%d", index++));
+        auto attach = StatementAttach().attach(worker.stagingPath).as(staging);
+        if (handle->hasCipher()) {
+            Data cipher = handle->getRawCipherKey();
+            attach.key(UnsafeStringView((const char *) cipher.buffer(), cipher.size()));
+        }
+        if (!handle->execute(attach)) {
+            return false;
+        }
+        for (const auto &table : worker.tables) {
+            if (!recreateTable(*table.info)) {
+                return false;
+            }
+            // The table is empty and has the same schema as the staging one,
+            // so that SQLite can transfer the records without decoding them.
+            StatementInsert insert
+            = StatementInsert()
+              .insertIntoTable(table.info->name)
+              .schema(Schema::main())
+              .values(StatementSelect().select(Column::all()).from(TableOrSubquery(table.info->name).schema(staging)));
+            if (!handle->execute(insert)) {
+                return false;
+            }
+            markTableAsFinished(table.info->name);
+            saveCheckpoint();
+        }
+        if (!handle->execute(StatementDetach().detach(staging))) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace WCDB
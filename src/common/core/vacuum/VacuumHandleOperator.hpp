@@ -23,9 +23,16 @@
  */
 
 #include "HandleOperator.hpp"
+#include "Lock.hpp"
 #include "MasterItem.hpp"
 #include "StatementPragma.hpp"
+#include "Time.hpp"
 #include "Vacuum.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace WCDB {
@@ -49,15 +56,80 @@ private:
 
     static const char *kOriginSchema;
 
-    bool configDatabase();
+    bool copyTables();
+    // Durable database is journaled and fully synchronized, so that it can be resumed after a crash.
+    bool configDatabase(InnerHandle *handle, const UnsafeStringView &path, bool durable);
     bool initTables();
-    bool createTable(const TableInfo &info);
+    bool dropStaleTables();
+    bool createTable(InnerHandle *handle, const TableInfo &info);
+    bool recreateTable(const TableInfo &info);
+    Optional<std::pair<int64_t, int64_t>>
+    getRowidRange(InnerHandle *handle, const UnsafeStringView &table);
     bool copyWithouRowidTable(const TableInfo &info);
     bool copyNormalTable(const TableInfo &info);
+    bool createAssociatedItems();
 
     StringViewMap<TableInfo> m_tables;
     double m_tableWeight;
-    std::list<StringView> m_associatedSQLs; // View, Trigger
+    std::list<std::pair<StringView, StringView>> m_associatedSQLs; // Name and SQL of view, trigger
+
+#pragma mark - Checkpoint
+private:
+    // The copied rows are committed in batches, after which the checkpoint is saved.
+    bool beginBatch();
+    bool commitBatch();
+    bool tryCommitBatch();
+
+    bool isTableFinished(const UnsafeStringView &table) const;
+    Optional<int64_t> getCopiedRowid(const UnsafeStringView &table) const;
+    Optional<int64_t> getResumedRowid(const TableInfo &info, int64_t minRowid);
+    void markTableAsCopying(const UnsafeStringView &table, int64_t lastRowid);
+    void markTableAsFinished(const UnsafeStringView &table);
+    bool isTimeSliceExhausted() const;
+
+    SteadyClock m_startTime;
+    SteadyClock m_lastCommitTime;
+
+#pragma mark - Parallel
+public:
+    typedef std::function<std::shared_ptr<InnerHandle>(void)> WorkerHandleGenerator;
+    // Large tables will be copied into staging databases in parallel with the generated handles.
+    void setWorkerHandleGenerator(const WorkerHandleGenerator &generator, int maxNumberOfWorkers);
+
+private:
+    struct ParallelTable {
+        const TableInfo *info;
+        int64_t minRowid;
+        int64_t maxRowid;
+    };
+    struct Worker {
+        std::shared_ptr<InnerHandle> handle;
+        StringView stagingPath;
+        std::list<ParallelTable> tables;
+        int64_t numberOfRows;
+        std::thread thread;
+    };
+
+    bool startWorkers();
+    void runWorker(Worker &worker);
+    bool copyRowsInWorker(InnerHandle *handle, const ParallelTable &table);
+    bool reportWorkerProgress();
+    bool waitForWorkers();
+    void stopWorkers();
+    bool mergeStagingDatabases();
+
+    WorkerHandleGenerator m_workerHandleGenerator;
+    int m_maxNumberOfWorkers;
+    std::list<Worker> m_workers;
+    StringViewSet m_parallelTables;
+    std::atomic<bool> m_stopWorkers;
+
+    std::mutex m_workerLock;
+    Conditional m_workerCond;
+    int m_numberOfRunningWorkers;
+    double m_pendingWorkerProgress;
+    bool m_workerFailed;
+    Error m_workerError;
 };
 
 } //namespace WCDB
@@ -0,0 +1,137 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VacuumTrackConfig.hpp"
+#include "Assertion.hpp"
+#include "InnerHandle.hpp"
+#include "WINQ.h"
+
+namespace WCDB {
+
+VacuumTrackConfig::VacuumTrackConfig(const UnsafeStringView &path)
+: Config()
+, m_identifier(StringView::formatted("VacuumTrack-%p", this))
+, m_path(path)
+, m_untracked(false)
+, m_hasDependents(false)
+{
+    WCTAssert(!m_path.empty());
+}
+
+VacuumTrackConfig::~VacuumTrackConfig() = default;
+
+bool VacuumTrackConfig::invoke(InnerHandle *handle)
+{
+    if (!handle->getPath().equal(m_path)) {
+        // The handles of vacuum write into the temp database.
+        return true;
+    }
+    auto select
+    = StatementSelect()
+      .select(Column::all().count())
+      .from(Syntax::masterTable)
+      .where(Column("type") == "trigger" || Column("sql").like("% REFERENCES %"));
+    if (!handle->prepare(select)) {
+        return false;
+    }
+    bool succeed = handle->step();
+    bool hasDependents = succeed && !handle->done() && handle->getInteger() > 0;
+    handle->finalize();
+    if (!succeed) {
+        return false;
+    }
+    if (hasDependents) {
+        LockGuard lockGuard(m_lock);
+        m_hasDependents = true;
+    }
+    handle->setNotificationWhenTableModified(m_identifier,
+                                             std::bind(&VacuumTrackConfig::onTableModified,
+                                                       this,
+                                                       std::placeholders::_1,
+                                                       std::placeholders::_2,
+                                                       std::placeholders::_3));
+    handle->setNotificationWhenCommitted(
+    2,
+    m_identifier,
+    std::bind(&VacuumTrackConfig::onCommitted, this, std::placeholders::_1, std::placeholders::_2));
+    return true;
+}
+
+bool VacuumTrackConfig::uninvoke(InnerHandle *handle)
+{
+    handle->unsetNotificationWhenCommitted(m_identifier);
+    handle->setNotificationWhenTableModified(m_identifier, nullptr);
+    return true;
+}
+
+void VacuumTrackConfig::reset()
+{
+    LockGuard lockGuard(m_lock);
+    m_pendingTables.clear();
+    m_modifiedTables.clear();
+    m_untracked = false;
+    m_hasDependents = false;
+}
+
+Optional<StringViewSet> VacuumTrackConfig::getModifiedTables() const
+{
+    SharedLockGuard lockGuard(m_lock);
+    if (m_untracked || (m_hasDependents && !m_modifiedTables.empty())) {
+        return NullOpt;
+    }
+    return m_modifiedTables;
+}
+
+void VacuumTrackConfig::onTableModified(const UnsafeStringView &path,
+                                        const UnsafeStringView &newTable,
+                                        const UnsafeStringView &modifiedTable)
+{
+    if (!path.equal(m_path)) {
+        return;
+    }
+    LockGuard lockGuard(m_lock);
+    if (!newTable.empty() || modifiedTable.empty()) {
+        // The schema is changed or the modified table is unknown.
+        m_untracked = true;
+    } else {
+        m_pendingTables.emplace(modifiedTable);
+    }
+}
+
+bool VacuumTrackConfig::onCommitted(const UnsafeStringView &path, int frames)
+{
+    if (!path.equal(m_path)) {
+        return true;
+    }
+    LockGuard lockGuard(m_lock);
+    if (frames > 0 && m_pendingTables.empty()) {
+        // Written by the handle whose table monitor is disabled.
+        m_untracked = true;
+    }
+    m_modifiedTables.insert(m_pendingTables.begin(), m_pendingTables.end());
+    m_pendingTables.clear();
+    return true;
+}
+
+} //namespace WCDB
@@ -0,0 +1,65 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Config.hpp"
+#include "Lock.hpp"
+#include "StringView.hpp"
+#include "WCDBOptional.hpp"
+
+namespace WCDB {
+
+// Track the tables modified between the time slices of vacuum,
+// so that the vacuum can be resumed by copying these tables again.
+class VacuumTrackConfig final : public Config {
+public:
+    VacuumTrackConfig(const UnsafeStringView &path);
+    ~VacuumTrackConfig() override;
+
+    bool invoke(InnerHandle *handle) override final;
+    bool uninvoke(InnerHandle *handle) override final;
+
+    void reset();
+    // NullOpt means that some of the modifications can't be attributed to tables.
+    Optional<StringViewSet> getModifiedTables() const;
+
+protected:
+    const StringView m_identifier;
+    const StringView m_path;
+
+    void onTableModified(const UnsafeStringView &path,
+                         const UnsafeStringView &newTable,
+                         const UnsafeStringView &modifiedTable);
+    bool onCommitted(const UnsafeStringView &path, int frames);
+
+    StringViewSet m_pendingTables;
+    StringViewSet m_modifiedTables;
+    bool m_untracked;
+    // Triggers and foreign keys modify the tables other than the written one.
+    bool m_hasDependents;
+    mutable SharedLock m_lock;
+};
+
+} //namespace WCDB
@@ -117,6 +117,7 @@ WCDB_EXTERN_C_END
 #define wcdb_unlink ::_wunlink
 #define wcdb_remove ::_wremove
 #define wcdb_lseek ::_lseeki64
+#define wcdb_fsync ::_commit
 #define FileFullAccess S_IREAD | S_IWRITE
 #define DirFullAccess 0
 #else
@@ -125,6 +126,7 @@ WCDB_EXTERN_C_END
 #define wcdb_unlink ::unlink
 #define wcdb_remove ::remove
 #define wcdb_lseek ::lseek
+#define wcdb_fsync ::fsync
 #define FileFullAccess S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH
 #define DirFullAccess S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH
 #endif //_WIN32
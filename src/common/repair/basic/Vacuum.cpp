@@ -23,12 +23,19 @@
  */
 
 #include "Vacuum.hpp"
+#include "FileHandle.hpp"
+#include "FileManager.hpp"
+#include "Path.hpp"
+#include "VacuumCheckpoint.hpp"
 
 namespace WCDB {
 
 namespace Repair {
 
-VacuumDelegate::VacuumDelegate() = default;
+VacuumDelegate::VacuumDelegate()
+: m_checkpoint(nullptr), m_timeSlice(0), m_paused(false)
+{
+}
 
 VacuumDelegate::~VacuumDelegate() = default;
 
@@ -42,6 +49,50 @@ void VacuumDelegate::setVacuumDatabase(const UnsafeStringView &vacuumPath)
     m_vacuumPath = vacuumPath;
 }
 
+void VacuumDelegate::setCheckpoint(VacuumCheckpoint *checkpoint,
+                                   const UnsafeStringView &checkpointPath)
+{
+    m_checkpoint = checkpoint;
+    m_checkpointPath = checkpointPath;
+}
+
+void VacuumDelegate::setTimeSlice(double seconds)
+{
+    m_timeSlice = seconds;
+}
+
+bool VacuumDelegate::isPaused() const
+{
+    return m_paused;
+}
+
+void VacuumDelegate::saveCheckpoint()
+{
+    if (m_checkpoint == nullptr || m_checkpointPath.empty()) {
+        return;
+    }
+    Data data = m_checkpoint->serialize();
+    if (data.empty()) {
+        return;
+    }
+    // The checkpoint is written into a temp file and then renamed,
+    // so that a crash during saving leaves the last checkpoint intact.
+    StringView tempPath = Path::addExtention(m_checkpointPath, "-temp");
+    FileHandle fileHandle(tempPath);
+    if (!fileHandle.open(FileHandle::Mode::OverWrite)) {
+        return;
+    }
+    bool succeed = fileHandle.write(data) && fileHandle.sync();
+    fileHandle.close();
+    if (succeed) {
+        FileManager::setFileProtectionCompleteUntilFirstUserAuthenticationIfNeeded(tempPath);
+        succeed = FileManager::replaceFile(tempPath, m_checkpointPath);
+    }
+    if (!succeed) {
+        FileManager::removeItem(tempPath);
+    }
+}
+
 VacuumDelegateHolder::VacuumDelegateHolder() : m_vacuumDelegate(nullptr)
 {
 }
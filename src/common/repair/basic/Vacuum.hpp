@@ -32,6 +32,8 @@ namespace WCDB {
 
 namespace Repair {
 
+class VacuumCheckpoint;
+
 class VacuumDelegate : public Progress {
 public:
     VacuumDelegate();
@@ -39,13 +41,25 @@ public:
 
     void setOriginalDatabase(const UnsafeStringView &originalPath);
     void setVacuumDatabase(const UnsafeStringView &vacuumPath);
+    void setCheckpoint(VacuumCheckpoint *checkpoint, const UnsafeStringView &checkpointPath);
+    // Vacuum will be paused after running for the specified seconds. 0 means no limit.
+    void setTimeSlice(double seconds);
+    bool isPaused() const;
 
     virtual bool executeVacuum() = 0;
     virtual const Error &getVacuumError() = 0;
 
 protected:
+    // It should only be called after the copied rows are durable in the vacuum database.
+    // The failure of saving checkpoint is ignorable since the last saved one is still valid.
+    void saveCheckpoint();
+
     StringView m_originalPath;
     StringView m_vacuumPath;
+    VacuumCheckpoint *m_checkpoint;
+    StringView m_checkpointPath;
+    double m_timeSlice;
+    bool m_paused;
 };
 
 class VacuumDelegateHolder {
@@ -0,0 +1,231 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VacuumCheckpoint.hpp"
+#include "CoreConst.h"
+#include "Notifier.hpp"
+#include "WCDBError.hpp"
+
+namespace WCDB {
+
+namespace Repair {
+
+VacuumCheckpoint::VacuumCheckpoint() : numberOfRestarts(0)
+{
+}
+
+VacuumCheckpoint::~VacuumCheckpoint() = default;
+
+void VacuumCheckpoint::reset()
+{
+    identity = Identity();
+    finishedTables.clear();
+    copyingTables.clear();
+    restartedTables.clear();
+    numberOfRestarts = 0;
+}
+
+#pragma mark - Identity
+VacuumCheckpoint::Identity::Identity()
+: fileSize(0), modifiedTime(0), walSize(0), walModifiedTime(0), fileIdentifier(0)
+{
+}
+
+bool VacuumCheckpoint::Identity::operator==(const Identity &other) const
+{
+    return fileSize == other.fileSize && modifiedTime == other.modifiedTime
+           && walSize == other.walSize && walModifiedTime == other.walModifiedTime
+           && fileIdentifier == other.fileIdentifier;
+}
+
+bool VacuumCheckpoint::Identity::operator!=(const Identity &other) const
+{
+    return !operator==(other);
+}
+
+#pragma mark - Serialization
+bool VacuumCheckpoint::serialize(Serialization &serialization) const
+{
+    //Header
+    if (!serialization.expand(VacuumCheckpoint::headerSize + VacuumCheckpoint::identitySize)) {
+        return false;
+    }
+    serialization.put4BytesUInt(magic);
+    serialization.put4BytesUInt(version);
+
+    //Identity
+    serialization.put8BytesUInt(identity.fileSize);
+    serialization.put8BytesUInt(identity.modifiedTime);
+    serialization.put8BytesUInt(identity.walSize);
+    serialization.put8BytesUInt(identity.walModifiedTime);
+    serialization.put4BytesUInt(identity.fileIdentifier);
+
+    //Finished
+    if (serialization.putVarint(finishedTables.size()) == 0) {
+        return false;
+    }
+    for (const auto &item : finishedTables) {
+        if (!serialization.putSizedString(item)) {
+            return false;
+        }
+    }
+
+    //Copying
+    if (serialization.putVarint(copyingTables.size()) == 0) {
+        return false;
+    }
+    for (const auto &table : copyingTables) {
+        if (!serialization.putSizedString(table.first)
+            || serialization.putVarint((uint64_t) table.second) == 0) {
+            return false;
+        }
+    }
+
+    //Restarted
+    if (serialization.putVarint(restartedTables.size()) == 0) {
+        return false;
+    }
+    for (const auto &table : restartedTables) {
+        if (!serialization.putSizedString(table.first)
+            || serialization.putVarint(table.second) == 0) {
+            return false;
+        }
+    }
+
+    //Restarts
+    if (serialization.putVarint(numberOfRestarts) == 0) {
+        return false;
+    }
+    return true;
+}
+
+#pragma mark - Deserialization
+bool VacuumCheckpoint::deserialize(Deserialization &deserialization)
+{
+    reset();
+
+    //Header
+    if (!deserialization.canAdvance(VacuumCheckpoint::headerSize)) {
+        markAsCorrupt("Header");
+        return false;
+    }
+    uint32_t magicValue = deserialization.advance4BytesUInt();
+    uint32_t versionValue = deserialization.advance4BytesUInt();
+    if (magicValue != VacuumCheckpoint::magic) {
+        markAsCorrupt("Magic");
+        return false;
+    }
+    if (versionValue != VacuumCheckpoint::version) {
+        markAsCorrupt("Version");
+        return false;
+    }
+
+    //Identity
+    if (!deserialization.canAdvance(VacuumCheckpoint::identitySize)) {
+        markAsCorrupt("Identity");
+        return false;
+    }
+    identity.fileSize = (uint64_t) deserialization.advance8BytesInt();
+    identity.modifiedTime = (uint64_t) deserialization.advance8BytesInt();
+    identity.walSize = (uint64_t) deserialization.advance8BytesInt();
+    identity.walModifiedTime = (uint64_t) deserialization.advance8BytesInt();
+    identity.fileIdentifier = deserialization.advance4BytesUInt();
+
+    //Finished
+    auto varFinishedCount = deserialization.advanceVarint();
+    if (varFinishedCount.first == 0) {
+        markAsCorrupt("FinishedCount");
+        return false;
+    }
+    for (uint64_t i = 0; i < varFinishedCount.second; ++i) {
+        auto item = deserialization.advanceSizedString();
+        if (item.first == 0) {
+            markAsCorrupt("FinishedTable");
+            return false;
+        }
+        finishedTables.emplace(item.second);
+    }
+
+    //Copying
+    auto varCopyingCount = deserialization.advanceVarint();
+    if (varCopyingCount.first == 0) {
+        markAsCorrupt("CopyingCount");
+        return false;
+    }
+    for (uint64_t i = 0; i < varCopyingCount.second; ++i) {
+        auto table = deserialization.advanceSizedString();
+        if (table.first == 0) {
+            markAsCorrupt("CopyingTable");
+            return false;
+        }
+        auto varRowid = deserialization.advanceVarint();
+        if (varRowid.first == 0) {
+            markAsCorrupt("CopyingRowid");
+            return false;
+        }
+        copyingTables.insert_or_assign(table.second, (int64_t) varRowid.second);
+    }
+
+    //Restarted
+    auto varRestartedCount = deserialization.advanceVarint();
+    if (varRestartedCount.first == 0) {
+        markAsCorrupt("RestartedCount");
+        return false;
+    }
+    for (uint64_t i = 0; i < varRestartedCount.second; ++i) {
+        auto table = deserialization.advanceSizedString();
+        if (table.first == 0) {
+            markAsCorrupt("RestartedTable");
+            return false;
+        }
+        auto varTimes = deserialization.advanceVarint();
+        if (varTimes.first == 0) {
+            markAsCorrupt("RestartedTimes");
+            return false;
+        }
+        restartedTables.insert_or_assign(table.second, (uint32_t) varTimes.second);
+    }
+
+    //Restarts
+    auto varRestarts = deserialization.advanceVarint();
+    if (varRestarts.first == 0) {
+        markAsCorrupt("Restarts");
+        return false;
+    }
+    numberOfRestarts = (uint32_t) varRestarts.second;
+    return true;
+}
+
+void VacuumCheckpoint::markAsCorrupt(const UnsafeStringView &element)
+{
+    Error error(Error::Code::Corrupt, Error::Level::Notice, "Vacuum checkpoint is corrupted");
+    error.infos.insert_or_assign(ErrorStringKeySource, ErrorSourceRepair);
+    error.infos.insert_or_assign("Element", element);
+    Notifier::shared().notify(error);
+    setThreadedError(std::move(error));
+}
+
+} //namespace Repair
+
+} //namespace WCDB
@@ -0,0 +1,94 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Serialization.hpp"
+#include "StringView.hpp"
+
+namespace WCDB {
+
+namespace Repair {
+
+/*
+ It records the progress of vacuum, so that an interrupted vacuum can be resumed from where it stopped.
+ The checkpoint is valid for the original database with the same identity.
+ Within the same process, it's also valid for the same file if the tables modified since then are tracked,
+ see `FactoryVacuum::setModifiedTables`.
+ */
+class VacuumCheckpoint final : public Serializable, public Deserializable {
+public:
+    VacuumCheckpoint();
+    ~VacuumCheckpoint() override;
+
+    struct Identity {
+        Identity();
+        uint64_t fileSize;
+        uint64_t modifiedTime;
+        uint64_t walSize;
+        uint64_t walModifiedTime;
+        // It's not changed by writes, unless the file is replaced.
+        uint32_t fileIdentifier;
+
+        bool operator==(const Identity &other) const;
+        bool operator!=(const Identity &other) const;
+    };
+    Identity identity;
+
+    // The tables that are completely copied.
+    StringViewSet finishedTables;
+    // The last copied rowid of the tables that are partially copied.
+    StringViewMap<int64_t> copyingTables;
+    // The number of times that the tables are modified while being copied.
+    // Each time, the copied rows of the table are dropped and it's copied again from the start.
+    StringViewMap<uint32_t> restartedTables;
+    // Number of times that vacuum starts over since the database is modified.
+    uint32_t numberOfRestarts;
+
+    void reset();
+
+#pragma mark - Header
+protected:
+    static constexpr const uint32_t magic = 0x57435643;
+    static constexpr const uint32_t version = 0x01020000; //1.2.0.0
+    static constexpr const int headerSize = sizeof(magic) + sizeof(version); //magic + version
+    static constexpr const int identitySize = sizeof(uint64_t) * 4 + sizeof(uint32_t);
+
+#pragma mark - Serializable
+public:
+    bool serialize(Serialization &serialization) const override final;
+    using Serializable::serialize;
+
+#pragma mark - Deserializable
+public:
+    bool deserialize(Deserialization &deserialization) override final;
+    using Deserializable::deserialize;
+
+protected:
+    static void markAsCorrupt(const UnsafeStringView &element);
+};
+
+} //namespace Repair
+
+} //namespace WCDB
@@ -193,6 +193,11 @@ StringView Factory::incrementalMaterialPathForDatabase(const UnsafeStringView &d
     return Path::addExtention(database, "-incremental.material");
 }
 
+StringView Factory::integrityRecordPathForDatabase(const UnsafeStringView &database)
+{
+    return Path::addExtention(database, "-integrity.record");
+}
+
 StringView Factory::firstMaterialPathForDatabase(const UnsafeStringView &database)
 {
     return Path::addExtention(database, "-first.material");
@@ -236,6 +241,7 @@ std::list<StringView> Factory::associatedPathsForDatabase(const UnsafeStringView
         Path::addExtention(database, "-wal"),
         Path::addExtention(database, "-shm"),
         incrementalMaterialPathForDatabase(database),
+        integrityRecordPathForDatabase(database),
         firstMaterialPathForDatabase(database),
         lastMaterialPathForDatabase(database),
     };
@@ -86,6 +86,7 @@ public:
     static std::list<StringView> databasePathsForDatabase(const UnsafeStringView &database);
 
     static StringView incrementalMaterialPathForDatabase(const UnsafeStringView &database);
+    static StringView integrityRecordPathForDatabase(const UnsafeStringView &database);
     static StringView firstMaterialPathForDatabase(const UnsafeStringView &database);
     static StringView lastMaterialPathForDatabase(const UnsafeStringView &database);
     static StringView factoryPathForDatabase(const UnsafeStringView &database);
@@ -95,8 +96,6 @@ public:
     static Optional<StringView> latestMaterialForDatabase(const UnsafeStringView &database);
     static Optional<std::list<StringView>>
     materialsForDeserializingForDatabase(const UnsafeStringView &database);
-
-protected:
     static Optional<Time> getModifiedTimeOr0IfNotExists(const UnsafeStringView &path);
 };
 
@@ -29,6 +29,7 @@
 #include "FullCrawler.hpp"
 #include "Notifier.hpp"
 #include "Path.hpp"
+#include "SyntaxCommonConst.hpp"
 
 namespace WCDB {
 
@@ -38,6 +39,10 @@ FactoryVacuum::FactoryVacuum(const Factory &factory_)
 : FactoryRelated(factory_)
 , directory(factory.getVacuumDirectory())
 , database(Path::addComponent(directory, factory.getDatabaseName()))
+, tempDirectory(Path::addComponent(directory, "temp"))
+, tempDatabase(Path::addComponent(tempDirectory, factory.getDatabaseName()))
+, checkpoint(Path::addExtention(tempDatabase, "-vacuum.checkpoint"))
+, m_modificationsTracked(false)
 {
 }
 
@@ -51,6 +56,12 @@ bool FactoryVacuum::work()
         return exit(false);
     }
     if (!exists.value()) {
+        // Keep the unfinished vacuum so that it can be resumed next time.
+        auto resumable = FileManager::fileExists(checkpoint);
+        if (resumable.succeed() && resumable.value()) {
+            finishProgress();
+            return true;
+        }
         return exit(true);
     }
 
@@ -87,27 +98,56 @@ bool FactoryVacuum::prepare()
     WCTRemedialAssert(
     m_vacuumDelegate != nullptr, "Vacuum delegate is not available.", return false;);
 
-    // 1. create temp directory for acquisition
-    StringView tempDirectory = Path::addComponent(directory, "temp");
-    StringView tempDatabase
-    = Path::addComponent(tempDirectory, factory.getDatabaseName());
-
-    if (!FileManager::removeItem(tempDirectory)
-        || !FileManager::createDirectoryWithIntermediateDirectories(tempDirectory)) {
+    // 1. Resume from the checkpoint if the original database is not modified since last vacuum.
+    // Otherwise, create temp directory for acquisition.
+    auto identity = getOriginalIdentity();
+    if (!identity.succeed()) {
         assignWithSharedThreadedError();
         return exit(false);
     }
+    VacuumCheckpoint vacuumCheckpoint;
+    if (!loadCheckpoint(vacuumCheckpoint, identity.value())) {
+        uint32_t numberOfRestarts = vacuumCheckpoint.numberOfRestarts;
+        vacuumCheckpoint.reset();
+        vacuumCheckpoint.numberOfRestarts = numberOfRestarts;
+        // The orphaned temp database and checkpoint are removed along with the temp directory.
+        if (!FileManager::removeItem(tempDirectory)
+            || !FileManager::createDirectoryWithIntermediateDirectories(tempDirectory)) {
+            assignWithSharedThreadedError();
+            return exit(false);
+        }
+    }
+    vacuumCheckpoint.identity = identity.value();
+    if (isRestartedTooManyTimes(vacuumCheckpoint)) {
+        // Finishing the vacuum in one go would block the writes, so it's given up instead.
+        Error error(Error::Code::Busy,
+                    Error::Level::Warning,
+                    "Vacuum is not resumable since the database keeps being modified.");
+        error.infos.insert_or_assign(ErrorStringKeySource, ErrorSourceRepair);
+        error.infos.insert_or_assign(ErrorStringKeyPath, factory.database);
+        Notifier::shared().notify(error);
+        setError(std::move(error));
+        return exit(false);
+    }
 
     // 2. Copy all data into temp database
     m_vacuumDelegate->setVacuumDatabase(tempDatabase);
     m_vacuumDelegate->setOriginalDatabase(factory.database);
+    m_vacuumDelegate->setCheckpoint(&vacuumCheckpoint, checkpoint);
     m_vacuumDelegate->setProgressCallback(std::bind(
     &FactoryVacuum::increaseProgress, this, std::placeholders::_1, std::placeholders::_2));
-    ;
     if (!m_vacuumDelegate->executeVacuum()) {
         setError(m_vacuumDelegate->getVacuumError());
+        // Temp directory is kept so that the next vacuum can be resumed from the checkpoint.
+        auto resumable = FileManager::fileExists(checkpoint);
+        if (resumable.succeed() && resumable.value()) {
+            return false;
+        }
         return exit(false);
     }
+    if (m_vacuumDelegate->isPaused()) {
+        return true;
+    }
 
     // 3. move the assembled database to vacuum directory.
     std::list<StringView> toRemove = Factory::associatedPathsForDatabase(database);
@@ -133,6 +173,112 @@ bool FactoryVacuum::prepare()
     return true;
 }
 
+Optional<VacuumCheckpoint::Identity> FactoryVacuum::getOriginalIdentity() const
+{
+    VacuumCheckpoint::Identity identity;
+    StringView wal = Path::addExtention(factory.database, "-wal");
+
+    auto fileSize = FileManager::getFileSize(factory.database);
+    auto modifiedTime = Factory::getModifiedTimeOr0IfNotExists(factory.database);
+    auto walSize = FileManager::getFileSize(wal);
+    auto walModifiedTime = Factory::getModifiedTimeOr0IfNotExists(wal);
+    auto fileIdentifier = FileManager::getFileIdentifier(factory.database);
+    if (!fileSize.succeed() || !modifiedTime.succeed() || !walSize.succeed()
+        || !walModifiedTime.succeed() || !fileIdentifier.succeed()) {
+        return NullOpt;
+    }
+    identity.fileSize = fileSize.value();
+    identity.modifiedTime = modifiedTime.value().nanoseconds();
+    identity.walSize = walSize.value();
+    identity.walModifiedTime = walModifiedTime.value().nanoseconds();
+    identity.fileIdentifier = fileIdentifier.value();
+    return identity;
+}
+
+bool FactoryVacuum::loadCheckpoint(VacuumCheckpoint &vacuumCheckpoint,
+                                   const VacuumCheckpoint::Identity &identity) const
+{
+    auto exists = FileManager::fileExists(checkpoint);
+    if (!exists.succeed() || !exists.value()) {
+        return false;
+    }
+    exists = FileManager::fileExists(tempDatabase);
+    if (!exists.succeed() || !exists.value()) {
+        return false;
+    }
+    if (!vacuumCheckpoint.deserialize(checkpoint)) {
+        return false;
+    }
+    if (vacuumCheckpoint.identity == identity) {
+        return true;
+    }
+    // Normal writes don't change the file identifier, and the modified tables are copied again.
+    if (m_modificationsTracked
+        && vacuumCheckpoint.identity.fileIdentifier == identity.fileIdentifier) {
+        applyModifiedTables(vacuumCheckpoint);
+        return true;
+    }
+    ++vacuumCheckpoint.numberOfRestarts;
+    Error error(Error::Code::Notice,
+                Error::Level::Notice,
+                "Vacuum starts over since the database is modified.");
+    error.infos.insert_or_assign(ErrorStringKeySource, ErrorSourceRepair);
+    error.infos.insert_or_assign(ErrorStringKeyPath, factory.database);
+    Notifier::shared().notify(error);
+    return false;
+}
+
+void FactoryVacuum::applyModifiedTables(VacuumCheckpoint &vacuumCheckpoint) const
+{
+    for (const auto &table : m_modifiedTables) {
+        // Tables that are not copied yet will be copied with the modification.
+        // The copied rows of the others are dropped, and they are copied again from the start in time slices.
+        vacuumCheckpoint.finishedTables.erase(table);
+        if (vacuumCheckpoint.copyingTables.erase(table) > 0) {
+            ++vacuumCheckpoint.restartedTables[table];
+        }
+    }
+    if (!m_modifiedTables.empty()) {
+        // Sequence table is modified along with the autoincrement tables, and it's cheap to copy again.
+        vacuumCheckpoint.finishedTables.erase(Syntax::sequenceTable);
+    }
+}
+
+bool FactoryVacuum::isRestartedTooManyTimes(const VacuumCheckpoint &vacuumCheckpoint) const
+{
+    if (vacuumCheckpoint.numberOfRestarts >= VacuumMaxNumberOfRestarts) {
+        return true;
+    }
+    for (const auto &table : vacuumCheckpoint.restartedTables) {
+        if (table.second >= VacuumMaxNumberOfRestarts) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FactoryVacuum::setModifiedTables(const StringViewSet &tables)
+{
+    m_modificationsTracked = true;
+    m_modifiedTables = tables;
+}
+
+bool FactoryVacuum::isResumable() const
+{
+    auto exists = FileManager::fileExists(checkpoint);
+    return exists.succeed() && exists.value();
+}
+
+bool FactoryVacuum::discard()
+{
+    if (!FileManager::removeItem(directory)) {
+        assignWithSharedThreadedError();
+        return false;
+    }
+    factory.removeDirectoryIfEmpty();
+    return true;
+}
+
 bool FactoryVacuum::increaseProgress(double, double increment)
 {
     return Progress::increaseProgress(increment);
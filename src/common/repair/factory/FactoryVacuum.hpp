@@ -28,6 +28,7 @@
 #include "ErrorProne.hpp"
 #include "FactoryRelated.hpp"
 #include "Vacuum.hpp"
+#include "VacuumCheckpoint.hpp"
 
 namespace WCDB {
 
@@ -43,13 +44,32 @@ public:
 
     const StringView directory;
     const StringView database;
+    const StringView tempDirectory;
+    const StringView tempDatabase;
+    const StringView checkpoint;
 
     bool work();
     bool prepare();
 
+    // The tables modified since the checkpoint was saved, which are tracked by the caller.
+    // If it's set, the checkpoint stays valid for the modified database and only these tables are copied again.
+    void setModifiedTables(const StringViewSet &tables);
+    // Whether there is a checkpoint to resume from.
+    bool isResumable() const;
+    // Remove the unfinished vacuum, including the temp database and the checkpoint.
+    bool discard();
+
 protected:
+    Optional<VacuumCheckpoint::Identity> getOriginalIdentity() const;
+    bool loadCheckpoint(VacuumCheckpoint &checkpoint,
+                        const VacuumCheckpoint::Identity &identity) const;
+    void applyModifiedTables(VacuumCheckpoint &checkpoint) const;
+    bool isRestartedTooManyTimes(const VacuumCheckpoint &checkpoint) const;
     bool increaseProgress(double progress, double increment);
     bool exit(bool result);
+
+    bool m_modificationsTracked;
+    StringViewSet m_modifiedTables;
 };
 
 } // namespace Repair
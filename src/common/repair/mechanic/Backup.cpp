@@ -271,7 +271,7 @@ bool Backup::incrementalBackup()
         }
     }
 
-    if (m_verifyingPagenos->size() == 0) {
+    if (m_verifyingPagenos->size() == 0 || adoptCheckpointedLeaves()) {
         return true;
     }
 
@@ -337,6 +337,79 @@ bool Backup::incrementalBackup()
     return true;
 }
 
+bool Backup::adoptCheckpointedLeaves()
+{
+    /*
+     The hashes of the checkpointed leaves are already taken from the checkpoint notification.
+     If all the checkpointed table pages are leaves that have been backed up before,
+     no page is added, removed or moved among the b-trees, since any of them will modify an interior page or a root page.
+     Then the hashes can be adopted directly without crawling the b-trees again.
+     But the pages may be modified without checkpoint after the hashes are taken,
+     so that each of them is still compared with the page in the file. The stale ones are replaced,
+     and the b-trees are crawled instead.
+     */
+    uint32_t pageCount = m_pager.getNumberOfPages();
+    size_t numberOfTablePages = 0;
+    for (const auto &iter : *m_verifyingPagenos) {
+        switch (iter.second.type) {
+        case Page::Type::LeafTable:
+            if (iter.first > pageCount) {
+                return false;
+            }
+            numberOfTablePages++;
+            break;
+        case Page::Type::InteriorTable:
+            return false;
+        default:
+            break;
+        }
+    }
+    if (numberOfTablePages == 0) {
+        return false;
+    }
+
+    std::vector<Material::Page *> adoptedPages;
+    adoptedPages.reserve(numberOfTablePages);
+    for (auto &content : m_material.contentsList) {
+        for (auto &page : content.verifiedPagenos) {
+            if (page.number == 0) {
+                continue;
+            }
+            auto iter = m_verifyingPagenos->find(page.number);
+            if (iter != m_verifyingPagenos->end()
+                && iter->second.type == Page::Type::LeafTable) {
+                adoptedPages.push_back(&page);
+            }
+        }
+    }
+    if (adoptedPages.size() != numberOfTablePages) {
+        return false;
+    }
+    bool stale = false;
+    for (auto &iter : *m_verifyingPagenos) {
+        if (iter.second.type != Page::Type::LeafTable) {
+            continue;
+        }
+        UnsafeData data = m_pager.acquirePageData(iter.first);
+        if (data.size() == 0) {
+            return false;
+        }
+        uint32_t hash = data.hash();
+        if (hash != iter.second.hash) {
+            iter.second.hash = hash;
+            stale = true;
+        }
+    }
+    if (stale) {
+        return false;
+    }
+    for (auto &page : adoptedPages) {
+        page->hash = m_verifyingPagenos->find(page->number)->second.hash;
+    }
+    m_verifyingPagenos->clear();
+    return true;
+}
+
 bool Backup::loadWal()
 {
     bool exclusive = false;
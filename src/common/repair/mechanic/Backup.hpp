@@ -105,6 +105,8 @@ protected:
     Optional<bool> tryLoadLatestMaterial(SharedIncrementalMaterial incrementalMaterial);
     bool fullBackup();
     bool incrementalBackup();
+    // Return true if all the modified pages are verified by the hashes from checkpoint.
+    bool adoptCheckpointedLeaves();
     bool loadWal();
     void updateMaterial(bool isIncremental);
 
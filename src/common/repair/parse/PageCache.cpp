@@ -0,0 +1,287 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PageCache.hpp"
+#include "Assertion.hpp"
+#include "CoreConst.h"
+#include <tuple>
+
+namespace WCDB {
+
+namespace Repair {
+
+bool PageCache::Key::operator<(const Key &other) const
+{
+    return std::tie(file, pageno, frame, salt, generation, fileSize, modifiedTime, cipher)
+           < std::tie(other.file,
+                      other.pageno,
+                      other.frame,
+                      other.salt,
+                      other.generation,
+                      other.fileSize,
+                      other.modifiedTime,
+                      other.cipher);
+}
+
+PageCache &PageCache::shared()
+{
+    static PageCache *s_pageCache = new PageCache;
+    return *s_pageCache;
+}
+
+PageCache::PageCache() : m_cache(RepairSharedPageCacheSize), m_hits(0), m_misses(0)
+{
+}
+
+PageCache::~PageCache() = default;
+
+Optional<Data> PageCache::get(const Key &key)
+{
+    SharedLockGuard lockGuard(m_lock);
+    auto data = m_cache.find(key);
+    if (data.hasValue()) {
+        ++m_hits;
+    } else {
+        ++m_misses;
+    }
+    return data;
+}
+
+void PageCache::insert(const Key &key, const UnsafeData &data)
+{
+    // Copy the data so that it's not counted in the high water of any pager.
+    Data copied(data.buffer(), data.size());
+    if (copied.size() != data.size()) {
+        return;
+    }
+    LockGuard lockGuard(m_lock);
+    if (!m_cache.exists(key)) {
+        m_cache.insert(key, copied);
+        tryRemovePurgedFiles();
+    }
+}
+
+#pragma mark - File
+uint32_t PageCache::retainFile(const UnsafeStringView &path, uint32_t file)
+{
+    LockGuard lockGuard(m_lock);
+    m_identifiers[path] = file;
+    File &record = m_files[file];
+    record.path = path;
+    ++record.numberOfPagers;
+    return record.generation;
+}
+
+void PageCache::releaseFile(uint32_t file)
+{
+    LockGuard lockGuard(m_lock);
+    auto iter = m_files.find(file);
+    WCTAssert(iter != m_files.end() && iter->second.numberOfPagers > 0);
+    if (iter == m_files.end()) {
+        return;
+    }
+    --iter->second.numberOfPagers;
+    tryRemoveFile(file);
+}
+
+Optional<uint32_t> PageCache::getCipher(const Key &key, const void *cipherContext)
+{
+    SharedLockGuard lockGuard(m_lock);
+    auto iter = m_files.find(key.file);
+    if (iter == m_files.end()) {
+        return NullOpt;
+    }
+    const File &record = iter->second;
+    if (record.cipherContext != cipherContext || record.fileSize != key.fileSize
+        || record.modifiedTime != key.modifiedTime) {
+        return NullOpt;
+    }
+    return record.cipher;
+}
+
+void PageCache::setCipher(const Key &key, const void *cipherContext, uint32_t cipher)
+{
+    LockGuard lockGuard(m_lock);
+    auto iter = m_files.find(key.file);
+    if (iter == m_files.end()) {
+        return;
+    }
+    File &record = iter->second;
+    record.cipherContext = cipherContext;
+    record.fileSize = key.fileSize;
+    record.modifiedTime = key.modifiedTime;
+    record.cipher = cipher;
+}
+
+bool PageCache::containsPages(const UnsafeStringView &path)
+{
+    SharedLockGuard lockGuard(m_lock);
+    auto iter = m_identifiers.find(path);
+    if (iter == m_identifiers.end()) {
+        return false;
+    }
+    return m_cache.getNumberOfPagesOfDatabase(iter->second) > 0;
+}
+
+void PageCache::invalidate(const UnsafeStringView &path)
+{
+    LockGuard lockGuard(m_lock);
+    // The file identifier is the one that pages are cached with, even if the file is replaced.
+    auto iter = m_identifiers.find(path);
+    if (iter == m_identifiers.end()
+        || m_cache.getNumberOfPagesOfDatabase(iter->second) == 0) {
+        return;
+    }
+    // The expired pages will be purged by LRU.
+    auto file = m_files.find(iter->second);
+    WCTAssert(file != m_files.end());
+    if (file != m_files.end()) {
+        file->second.generation++;
+    }
+}
+
+void PageCache::tryRemoveFile(uint32_t file)
+{
+    WCTAssert(m_lock.writeSafety());
+    // The generation is still needed to expire the cached pages of database file.
+    auto iter = m_files.find(file);
+    if (iter == m_files.end() || iter->second.numberOfPagers > 0
+        || m_cache.getNumberOfPagesOfDatabase(file) > 0) {
+        return;
+    }
+    auto identifier = m_identifiers.find(iter->second.path);
+    if (identifier != m_identifiers.end() && identifier->second == file) {
+        m_identifiers.erase(identifier);
+    }
+    m_files.erase(iter);
+}
+
+void PageCache::tryRemovePurgedFiles()
+{
+    for (uint32_t file : m_cache.takePurgedFiles()) {
+        tryRemoveFile(file);
+    }
+}
+
+PageCache::Statistics PageCache::getStatistics()
+{
+    SharedLockGuard lockGuard(m_lock);
+    Statistics statistics;
+    statistics.numberOfPages = m_cache.size();
+    statistics.usedMemory = m_cache.getUsedMemory();
+    statistics.numberOfFiles = m_files.size();
+    statistics.hits = m_hits;
+    statistics.misses = m_misses;
+    return statistics;
+}
+
+void PageCache::setMaxAllowedMemory(size_t maxAllowedMemory)
+{
+    LockGuard lockGuard(m_lock);
+    m_cache.setMaxAllowedMemory(maxAllowedMemory);
+    tryRemovePurgedFiles();
+}
+
+PageCache::Cache::Cache(size_t maxAllowedMemory)
+: LRUCache<Key, Data>(), m_maxAllowedMemory(maxAllowedMemory), m_currentUsedMemery(0)
+{
+}
+
+PageCache::Cache::~Cache() = default;
+
+Optional<Data> PageCache::Cache::find(const Key &key)
+{
+    auto iter = m_map.find(key);
+    if (iter == m_map.end()) {
+        return NullOpt;
+    }
+    std::lock_guard<std::mutex> lockGuard(m_retainLock);
+    // Splicing doesn't move the elements, so concurrent finds can still read them.
+    retain(iter);
+    return iter->second->second;
+}
+
+void PageCache::Cache::insert(const Key &key, const Data &data)
+{
+    WCTAssert(!exists(key));
+    m_currentUsedMemery += data.size();
+    if (key.frame == 0) {
+        ++m_numberOfPagesOfDatabases[key.file];
+    }
+    put(key, data);
+    while (shouldPurge() && !empty()) {
+        purge();
+    }
+}
+
+size_t PageCache::Cache::getNumberOfPagesOfDatabase(uint32_t file) const
+{
+    auto iter = m_numberOfPagesOfDatabases.find(file);
+    if (iter != m_numberOfPagesOfDatabases.end()) {
+        return iter->second;
+    }
+    return 0;
+}
+
+std::vector<uint32_t> PageCache::Cache::takePurgedFiles()
+{
+    std::vector<uint32_t> purgedFiles;
+    purgedFiles.swap(m_purgedFiles);
+    return purgedFiles;
+}
+
+size_t PageCache::Cache::getUsedMemory() const
+{
+    return m_currentUsedMemery;
+}
+
+void PageCache::Cache::setMaxAllowedMemory(size_t maxAllowedMemory)
+{
+    m_maxAllowedMemory = maxAllowedMemory;
+    while (shouldPurge() && !empty()) {
+        purge();
+    }
+}
+
+bool PageCache::Cache::shouldPurge() const
+{
+    return m_currentUsedMemery > m_maxAllowedMemory;
+}
+
+void PageCache::Cache::willPurge(const Key &key, const Data &data)
+{
+    m_currentUsedMemery -= data.size();
+    if (key.frame == 0) {
+        auto iter = m_numberOfPagesOfDatabases.find(key.file);
+        WCTAssert(iter != m_numberOfPagesOfDatabases.end() && iter->second > 0);
+        if (--iter->second == 0) {
+            m_numberOfPagesOfDatabases.erase(iter);
+            m_purgedFiles.push_back(key.file);
+        }
+    }
+}
+
+} //namespace Repair
+
+} //namespace WCDB
@@ -0,0 +1,145 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Data.hpp"
+#include "LRUCache.hpp"
+#include "Lock.hpp"
+#include "StringView.hpp"
+#include "WCDBOptional.hpp"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace WCDB {
+
+namespace Repair {
+
+/*
+ It's a process-wide cache of decrypted pages, which are shared among all the `Pager`s.
+ So that the pages decrypted by backup can be reused by integrity check, and vice versa.
+ */
+class PageCache final {
+public:
+    static PageCache &shared();
+
+    PageCache(const PageCache &) = delete;
+    PageCache &operator=(const PageCache &) = delete;
+
+    struct Key {
+        uint32_t file;         // file identifier of the database
+        uint32_t cipher;       // hash of the decrypted header, to distinguish the cipher key
+        uint32_t generation;   // increased when the database is checkpointed
+        uint64_t fileSize;     // 0 for the page in wal
+        int64_t modifiedTime;  // 0 for the page in wal
+        uint64_t salt;         // 0 for the page in database file
+        uint32_t frame;        // 0 for the page in database file
+        uint32_t pageno;
+        bool operator<(const Key &other) const;
+    };
+
+    Optional<Data> get(const Key &key);
+    void insert(const Key &key, const UnsafeData &data);
+
+    // The path is remembered so that it can be invalidated without touching the file system.
+    // It's forgotten after the last pager releases the file and the pages of database file are all purged.
+    // Return the generation of the file.
+    uint32_t retainFile(const UnsafeStringView &path, uint32_t file);
+    void releaseFile(uint32_t file);
+
+    // The hash of the decrypted header is valid until the size or the modified time of the file changes,
+    // or the file is decrypted by another cipher context.
+    Optional<uint32_t> getCipher(const Key &key, const void *cipherContext);
+    void setCipher(const Key &key, const void *cipherContext, uint32_t cipher);
+    // Whether there are cached pages of database file, which will be expired by `invalidate`.
+    bool containsPages(const UnsafeStringView &path);
+    // All the cached pages of database file will be expired.
+    void invalidate(const UnsafeStringView &path);
+
+    struct Statistics {
+        size_t numberOfPages = 0;
+        size_t usedMemory = 0;
+        size_t numberOfFiles = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+    Statistics getStatistics();
+    // Purge the least recently used pages immediately if the cache exceeds the new size.
+    void setMaxAllowedMemory(size_t maxAllowedMemory);
+
+protected:
+    PageCache();
+    ~PageCache();
+
+    class Cache final : public LRUCache<Key, Data> {
+    public:
+        Cache(size_t maxAllowedMemory);
+        ~Cache() override;
+
+        // It's safe to be called concurrently with each other, but not with the modifications of the cache.
+        Optional<Data> find(const Key &key);
+        void insert(const Key &key, const Data &data);
+        size_t getNumberOfPagesOfDatabase(uint32_t file) const;
+        // The files whose pages of database file are all purged since last call.
+        std::vector<uint32_t> takePurgedFiles();
+        size_t getUsedMemory() const;
+        void setMaxAllowedMemory(size_t maxAllowedMemory);
+
+    protected:
+        bool shouldPurge() const override final;
+        void willPurge(const Key &key, const Data &data) override final;
+        size_t m_maxAllowedMemory;
+        size_t m_currentUsedMemery;
+        // Pages of database file, excluding the ones in wal.
+        std::map<uint32_t, size_t> m_numberOfPagesOfDatabases;
+        std::vector<uint32_t> m_purgedFiles;
+        // Recency is updated under the shared lock of page cache.
+        std::mutex m_retainLock;
+    };
+
+    struct File {
+        StringView path;
+        uint32_t generation = 0;
+        int numberOfPagers = 0;
+        const void *cipherContext = nullptr;
+        uint64_t fileSize = 0;
+        int64_t modifiedTime = 0;
+        uint32_t cipher = 0;
+    };
+    void tryRemoveFile(uint32_t file);
+    void tryRemovePurgedFiles();
+
+    SharedLock m_lock;
+    Cache m_cache;
+    std::map<uint32_t, File> m_files;
+    StringViewMap<uint32_t> m_identifiers;
+    std::atomic<uint64_t> m_hits;
+    std::atomic<uint64_t> m_misses;
+};
+
+} //namespace Repair
+
+} //namespace WCDB
@@ -51,10 +51,17 @@ Pager::Pager(const UnsafeStringView& path)
 , m_skipWal(false)
 , m_cache(maxAllowedCacheMemory)
 , m_highWater(std::make_shared<ShareableHighWater>())
+, m_sharedCacheEnabled(false)
+, m_sharedCacheKey()
 {
 }
 
-Pager::~Pager() = default;
+Pager::~Pager()
+{
+    if (m_sharedCacheEnabled) {
+        PageCache::shared().releaseFile(m_sharedCacheKey.file);
+    }
+}
 
 void Pager::setPageSize(int pageSize)
 {
@@ -123,6 +130,16 @@ UnsafeData Pager::acquirePageData(int number, offset_t offset, size_t size)
     if (m_cache.exists(number)) {
         return m_cache.get(number).subdata(offset, size);
     }
+    PageCache::Key sharedCacheKey = m_sharedCacheKey;
+    if (m_sharedCacheEnabled) {
+        sharedCacheKey = getSharedCacheKey(number);
+        auto sharedData = PageCache::shared().get(sharedCacheKey);
+        if (sharedData.hasValue()) {
+            m_cache.insert(number, sharedData.value());
+            tryPurgeCache();
+            return sharedData.value().subdata(offset, size);
+        }
+    }
     UnsafeData data;
     if (m_wal.containsPage(number)) {
         data = m_wal.acquirePageData(number, m_highWater);
@@ -155,6 +172,9 @@ UnsafeData Pager::acquirePageData(int number, offset_t offset, size_t size)
             return MappedData::null();
         }
         data = Data(reinterpret_cast<unsigned char*>(decodedBuffer), m_pageSize, m_highWater);
+        if (m_sharedCacheEnabled) {
+            PageCache::shared().insert(sharedCacheKey, data);
+        }
     }
     m_cache.insert(number, data);
     tryPurgeCache();
@@ -335,6 +355,7 @@ bool Pager::doInitialize()
     m_fileHandle.setPageSize(m_pageSize);
 
     m_numberOfPages = (int) ((m_fileSize + m_pageSize - 1) / m_pageSize);
+    m_sharedCacheEnabled = prepareSharedCache();
 
     if (m_skipWal) {
         return true;
@@ -371,6 +392,61 @@ void Pager::tryPurgeCache()
     }
 }
 
+#pragma mark - Shared Cache
+bool Pager::prepareSharedCache()
+{
+    if (m_pCodec == nullptr) {
+        return false;
+    }
+    auto file = FileManager::getFileIdentifier(getPath());
+    if (!file.hasValue()) {
+        return false;
+    }
+    auto modifiedTime = FileManager::getFileModifiedTime(getPath());
+    if (!modifiedTime.hasValue()) {
+        return false;
+    }
+    m_sharedCacheKey.file = file.value();
+    m_sharedCacheKey.fileSize = m_fileSize;
+    m_sharedCacheKey.modifiedTime = modifiedTime.value().nanoseconds();
+    PageCache& pageCache = PageCache::shared();
+    m_sharedCacheKey.generation = pageCache.retainFile(getPath(), file.value());
+    // Pagers with different cipher keys should not share the decrypted pages.
+    auto cipher = pageCache.getCipher(m_sharedCacheKey, m_pCodec);
+    if (!cipher.hasValue()) {
+        UnsafeData header = m_fileHandle.map(0, m_pageSize);
+        void* decodedBuffer = nullptr;
+        if (header.size() == (size_t) m_pageSize) {
+            decodedBuffer = sqlite3Codec(m_pCodec, header.buffer(), 1, 4);
+        }
+        if (decodedBuffer == nullptr) {
+            pageCache.releaseFile(file.value());
+            return false;
+        }
+        cipher = UnsafeData(reinterpret_cast<unsigned char*>(decodedBuffer), 100).hash();
+        pageCache.setCipher(m_sharedCacheKey, m_pCodec, cipher.value());
+    }
+    m_sharedCacheKey.cipher = cipher.value();
+    return true;
+}
+
+PageCache::Key Pager::getSharedCacheKey(int number) const
+{
+    PageCache::Key key = m_sharedCacheKey;
+    key.pageno = number;
+    int frame = m_wal.getFrameno(number);
+    if (frame > 0) {
+        // Frames are never rewritten until the wal is restarted with a new salt.
+        const Salt& salt = m_wal.getSalt();
+        key.generation = 0;
+        key.fileSize = 0;
+        key.modifiedTime = 0;
+        key.salt = (((uint64_t) salt.second) << 32) | salt.first;
+        key.frame = frame;
+    }
+    return key;
+}
+
 Pager::Cache::Cache(size_t maxAllowedMemory)
 : LRUCache<uint32_t, UnsafeData>()
 , m_maxAllowedMemory(maxAllowedMemory)
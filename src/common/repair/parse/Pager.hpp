@@ -27,6 +27,7 @@
 #include "ErrorProne.hpp"
 #include "HighWater.hpp"
 #include "Initializeable.hpp"
+#include "PageCache.hpp"
 #include "PageBasedFileHandle.hpp"
 #include "WCDBError.hpp"
 #include "Wal.hpp"
@@ -127,6 +128,14 @@ protected:
     void tryPurgeCache();
     Cache m_cache;
     SharedHighWater m_highWater;
+
+#pragma mark - Shared Cache
+protected:
+    // Only the decrypted pages are shared since decryption is much more expensive than reading.
+    bool prepareSharedCache();
+    PageCache::Key getSharedCacheKey(int number) const;
+    bool m_sharedCacheEnabled;
+    PageCache::Key m_sharedCacheKey;
 };
 
 } //namespace Repair
@@ -99,6 +99,15 @@ MappedData Wal::acquirePageData(int pageno, offset_t offset, size_t size, Shared
                        highWater);
 }
 
+int Wal::getFrameno(int pageno) const
+{
+    auto iter = m_pages2Frames.find(pageno);
+    if (iter == m_pages2Frames.end()) {
+        return 0;
+    }
+    return iter->second;
+}
+
 int Wal::getMaxPageno() const
 {
     if (m_pages2Frames.empty()) {
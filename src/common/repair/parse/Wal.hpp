@@ -57,6 +57,7 @@ public:
     MappedData
     acquirePageData(int pageno, offset_t offset, size_t size, SharedHighWater highWater = nullptr);
     int getMaxPageno() const;
+    int getFrameno(int pageno) const;
 
 protected:
     // pageno -> frameno
@@ -25,6 +25,7 @@
 #include "HandleOperation.hpp"
 #include "Assertion.hpp"
 #include "CoreConst.h"
+#include "FTS5BulkIndexer.hpp"
 #include "Handle.hpp"
 #include "InnerHandle.hpp"
 #include "Notifier.hpp"
@@ -153,6 +154,41 @@ bool HandleOperation::insertOrIgnoreRows(const MultiRowsValue &rows,
     }
 }
 
+bool HandleOperation::bulkInsertFTS5Rows(const MultiRowsValue &rows,
+                                         const Columns &columns,
+                                         const UnsafeStringView &table)
+{
+    for (const OneRowValue &row : rows) {
+        WCTRemedialAssert(columns.size() == row.size(),
+                          "Number of values is not equal to number of columns",
+                          return false;);
+    }
+    auto insertAction = [&](Handle &handle) {
+        StatementInsert insert
+        = StatementInsert().insertIntoTable(table).columns(columns).values(
+        BindParameter::bindParameters(columns.size()));
+        InnerHandle *innerHandle = handle.getOrGenerateHandle(true);
+        if (innerHandle == nullptr) {
+            return false;
+        }
+        FTS5BulkIndexer indexer(innerHandle);
+        if (!indexer.insertRows(insert, table, rows)) {
+            assignErrorToDatabase(handle.getError());
+            return false;
+        }
+        return true;
+    };
+    if (rows.size() == 0) {
+        return true;
+    } else if (rows.size() == 1) {
+        GetHandleOrReturnValue(true, false);
+        Handle newHandle = Handle(handle);
+        return insertAction(newHandle);
+    } else {
+        return lazyRunTransaction(insertAction);
+    }
+}
+
 bool HandleOperation::updateRow(const OneRowValue &row,
                                 const Columns &columns,
                                 const UnsafeStringView &table,
@@ -24,6 +24,7 @@
 
 #include "TableOperation.hpp"
 #include "Assertion.hpp"
+#include "FTS5BulkIndexer.hpp"
 #include "Handle.hpp"
 #include "InnerHandle.hpp"
 
@@ -162,6 +163,44 @@ bool TableOperation::insertOrIgnoreRows(const MultiRowsValue &rows, const Column
     }
 }
 
+bool TableOperation::bulkInsertFTS5Rows(const MultiRowsValue &rows, const Columns &columns)
+{
+    for (const OneRowValue &row : rows) {
+        WCTRemedialAssert(columns.size() == row.size(),
+                          "Number of values is not equal to number of columns",
+                          return false;);
+    }
+    auto insertAction = [&](Handle &handle) {
+        StatementInsert insert = StatementInsert()
+                                 .insertIntoTable(getTableName())
+                                 .columns(columns)
+                                 .values(BindParameter::bindParameters(columns.size()));
+        InnerHandle *innerHandle = handle.getOrGenerateHandle(true);
+        if (innerHandle == nullptr) {
+            return false;
+        }
+        FTS5BulkIndexer indexer(innerHandle);
+        if (!indexer.insertRows(insert, getTableName(), rows)) {
+            assignErrorToDatabase(handle.getError());
+            return false;
+        }
+        return true;
+    };
+    GetHandleOrReturnValue(true, false);
+    Handle newHandle = Handle(handle);
+    if (rows.size() == 0) {
+        return true;
+    } else if (rows.size() == 1) {
+        return insertAction(newHandle);
+    } else {
+        bool succeed = newHandle.lazyRunTransaction(insertAction);
+        if (!succeed) {
+            assignErrorToDatabase(newHandle.getError());
+        }
+        return succeed;
+    }
+}
+
 bool TableOperation::updateRow(const OneRowValue &row,
                                const Columns &columns,
                                const Expression &where,
@@ -54,6 +54,15 @@ public:
      */
     bool insertOrIgnoreRows(const MultiRowsValue &rows, const Columns &columns);
 
+    /**
+     @brief Execute inserting with multi rows of values into current fts5 table.
+     The text values are tokenized by multiple threads in advance, and the tokens are passed to fts5 when the rows are inserted. So it's much faster than `insertRows` to rebuild or backfill a large fts5 table.
+     @note  Only the tokenizers registered into WCDB, such as `BuiltinTokenizer::Verbatim` and `BuiltinTokenizer::Pinyin`, can be run in advance. Otherwise, it's the same as `insertRows`.
+     @note  It will run embedded transaction while rows.size>1.
+     @return True if no error occurs.
+     */
+    bool bulkInsertFTS5Rows(const MultiRowsValue &rows, const Columns &columns);
+
 #pragma mark - Update
 public:
     /**
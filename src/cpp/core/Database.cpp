@@ -196,6 +196,32 @@ bool Database::vacuum(ProgressUpdateCallback onProgressUpdated)
     return m_innerDatabase->vacuum(onProgressUpdated);
 }
 
+void Database::enableAutoVacuum(bool flag)
+{
+    Core::shared().enableAutoVacuum(m_innerDatabase, flag);
+}
+
+void Database::setThreadedHandlePriority(HandlePriority priority)
+{
+    HandleCounter::setThreadedPriority((WCDB::HandlePriority) priority);
+}
+
+std::map<Database::HandlePriority, Database::HandleWaitStatistics>
+Database::getHandleWaitStatistics() const
+{
+    std::map<HandlePriority, HandleWaitStatistics> result;
+    auto statistics = m_innerDatabase->getHandleWaitStatistics();
+    for (int i = 0; i < HandlePriorityCount; ++i) {
+        HandleWaitStatistics &waitStatistics = result[(HandlePriority) i];
+        waitStatistics.count = statistics[i].count;
+        waitStatistics.totalWaitTime = statistics[i].totalWaitTime;
+        waitStatistics.maxWaitTime = statistics[i].maxWaitTime;
+        waitStatistics.histogram.assign(statistics[i].histogram.begin(),
+                                        statistics[i].histogram.end());
+    }
+    return result;
+}
+
 #if defined(_WIN32)
 void Database::setUIThreadId(std::thread::id uiThreadId)
 {
@@ -277,6 +303,62 @@ void Database::tracePerformance(Database::PerformanceNotification trace)
     }
 }
 
+void Database::globalTracePerformanceInBatch(BatchedPerformanceNotification trace)
+{
+    if (trace != nullptr) {
+        Core::shared().setNotificationWhenPerformanceGlobalTracedInBatch(
+        [trace](const std::vector<BufferedPerformanceTracer::Trace>& traces,
+                uint64_t numberOfDroppedTraces) {
+            std::vector<PerformanceTrace> newTraces;
+            newTraces.reserve(traces.size());
+            for (const auto& bufferedTrace : traces) {
+                PerformanceTrace newTrace;
+                newTrace.tag = bufferedTrace.tag;
+                newTrace.path = bufferedTrace.path;
+                newTrace.handleIdentifier = (uint64_t) bufferedTrace.handle;
+                newTrace.sql = bufferedTrace.sql;
+                memcpy(&newTrace.info, &bufferedTrace.info, sizeof(bufferedTrace.info));
+                newTraces.push_back(std::move(newTrace));
+            }
+            trace(newTraces, numberOfDroppedTraces);
+        });
+    } else {
+        Core::shared().setNotificationWhenPerformanceGlobalTracedInBatch(nullptr);
+    }
+}
+
+void Database::enableStatementStatistics(bool enable)
+{
+    m_innerDatabase->setStatementStatisticsEnable(enable);
+}
+
+std::vector<Database::StatementStatistics> Database::getStatementStatistics() const
+{
+    std::vector<StatementStatistics> result;
+    auto entries = m_innerDatabase->getStatementStatistics();
+    result.reserve(entries.size());
+    for (const auto& entry : entries) {
+        StatementStatistics statistics;
+        statistics.fingerprint = entry.fingerprint;
+        statistics.numberOfCalls = entry.numberOfCalls;
+        statistics.totalCostInNanoseconds = entry.totalCostInNanoseconds;
+        statistics.inheritedCostInNanoseconds = entry.inheritedCostInNanoseconds;
+        statistics.p50CostInNanoseconds = entry.p50CostInNanoseconds;
+        statistics.p95CostInNanoseconds = entry.p95CostInNanoseconds;
+        statistics.p99CostInNanoseconds = entry.p99CostInNanoseconds;
+        statistics.pagesRead = entry.pagesRead;
+        statistics.pagesWritten = entry.pagesWritten;
+        statistics.rowsReturned = entry.rowsReturned;
+        result.push_back(std::move(statistics));
+    }
+    return result;
+}
+
+void Database::resetStatementStatistics()
+{
+    m_innerDatabase->resetStatementStatistics();
+}
+
 void Database::globalTraceSQL(Database::SQLNotification trace)
 {
     Core::shared().setNotificationForSQLGLobalTraced(trace);
@@ -356,6 +438,23 @@ void Database::enableAutoMergeFTS5Index(bool flag)
     Core::shared().enableAutoMergeFTSIndex(m_innerDatabase, flag);
 }
 
+void Database::setAutoMergeFTS5IndexBudget(double maxDuration, int maxPages)
+{
+    m_innerDatabase->setMergeFTSIndexBudget(maxDuration, maxPages);
+}
+
+StringViewMap<Database::FTS5MergeStatistics> Database::getFTS5MergeStatistics() const
+{
+    StringViewMap<FTS5MergeStatistics> result;
+    for (const auto& iter : m_innerDatabase->getMergeFTSIndexStatistics()) {
+        FTS5MergeStatistics& statistics = result[iter.first];
+        statistics.segmentCount = iter.second.segmentCount;
+        statistics.pagesWritten = iter.second.pagesWritten;
+        statistics.timeSpent = iter.second.timeSpent;
+    }
+    return result;
+}
+
 void Database::addTokenizer(const UnsafeStringView& tokenize)
 {
     StringView configName
@@ -399,11 +498,21 @@ void Database::configPinyinConverter(PinYinConverter converter)
     FTSTokenizerUtil::configPinyinConverter(converter);
 }
 
+bool Database::configPinyinDict(const UnsafeStringView &path)
+{
+    return FTSTokenizerUtil::configPinyinDict(path);
+}
+
 void Database::configTraditionalChineseConverter(TraditionalChineseConverter converter)
 {
     FTSTokenizerUtil::configTraditionalChineseConverter(converter);
 }
 
+bool Database::configTraditionalChineseDict(const UnsafeStringView &path)
+{
+    return FTSTokenizerUtil::configTraditionalChineseDict(path);
+}
+
 #pragma mark - Memory
 
 void Database::purge()
@@ -416,6 +525,47 @@ void Database::purgeAll()
     Core::shared().purgeDatabasePool();
 }
 
+void Database::setPageCacheBudget(int64_t bytes)
+{
+    Core::shared().setPageCacheBudget(bytes);
+}
+
+Database::PageCacheStatistics Database::getPageCacheStatistics() const
+{
+    PageCacheStatistics result;
+    auto statistics = m_innerDatabase->getPageCacheStatistics().valueOrDefault();
+    result.cacheUsed = statistics.cacheUsed;
+    result.hits = statistics.hits;
+    result.misses = statistics.misses;
+    result.limitPerHandle = statistics.limitPerHandle;
+    return result;
+}
+
+void Database::setNumberOfWarmHandles(int count)
+{
+    m_innerDatabase->setNumberOfWarmHandles(count);
+}
+
+void Database::setMaxIdleDurationOfHandles(double seconds)
+{
+    m_innerDatabase->setMaxIdleDurationOfHandles(seconds);
+}
+
+void Database::addWarmUpQuery(const StatementSelect& query)
+{
+    m_innerDatabase->addWarmUpStatement(query);
+}
+
+void Database::removeAllWarmUpQueries()
+{
+    m_innerDatabase->removeAllWarmUpStatements();
+}
+
+void Database::prewarm(const OneRowValue& bindings)
+{
+    m_innerDatabase->prewarm(bindings);
+}
+
 #pragma mark - Repair
 
 void Database::setNotificationWhenCorrupted(Database::CorruptionNotification onCorrupted)
@@ -438,6 +588,17 @@ bool Database::isAlreadyCorrupted()
     return Core::shared().isFileObservedCorrupted(getPath());
 }
 
+void Database::enableIncrementalIntegrityCheck(bool flag, double fullCheckInterval)
+{
+    m_innerDatabase->setFullIntegrityCheckInterval(fullCheckInterval);
+    Core::shared().enableAutoIncrementalIntegrityCheck(m_innerDatabase, flag);
+}
+
+void Database::enableIncrementalIntegrityCheck(bool flag)
+{
+    enableIncrementalIntegrityCheck(flag, IntegrityDefaultFullCheckInterval);
+}
+
 void Database::enableAutoBackup(bool flag)
 {
     Core::shared().enableAutoBackup(m_innerDatabase, flag);
@@ -523,6 +684,16 @@ void Database::removeConfig(const UnsafeStringView& name)
     m_innerDatabase->removeConfig(name);
 }
 
+void Database::enableAdaptiveMMap(bool flag)
+{
+    m_innerDatabase->setAdaptiveMMapEnable(flag);
+}
+
+void Database::enableSingleWriter(bool flag)
+{
+    m_innerDatabase->setSingleWriterEnable(flag);
+}
+
 bool Database::setDefaultTemporaryDirectory(const UnsafeStringView& directory)
 {
     return Core::shared().setDefaultTemporaryDirectory(directory);
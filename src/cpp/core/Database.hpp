@@ -176,11 +176,49 @@ public:
     /**
      @brief Vacuum current database.
      It can be used to vacuum a database of any size with limited memory usage.
+     The progress of vacuum is saved into a checkpoint file, so that an interrupted vacuum can be resumed next time if the database is not modified since then.
      @see   `Database::ProgressUpdateCallback`.
      @return true if vacuum succeed.
      */
     bool vacuum(ProgressUpdateCallback onProgressUpdated);
 
+    /**
+     @brief Configure the database to be vacuumed in the background in small time slices.
+     Each time slice blocks other operations of this database for a while, and the vacuum is resumed from the checkpoint in the next time slice.
+     The tables written by this process between two time slices are copied again from the start, also in time slices. Vacuum starts over if the writes can't be attributed to tables, such as those from other processes or with triggers. It's given up with a warning if it starts over, or a table is modified while being copied, for several times.
+     @param flag to enable background vacuum. It will be disabled automatically after vacuum finished. The unfinished vacuum is removed when it's disabled.
+     */
+    void enableAutoVacuum(bool flag);
+
+    enum class HandlePriority : unsigned char {
+        Background = 0,
+        Normal,
+        Interactive,
+    };
+
+    /**
+     @brief Set the priority of acquiring sqlite db handles in the current thread.
+     When the number of sqlite db handles in use reaches the limit, the waiting threads are admitted in the order of their priorities.
+     A waiting thread is promoted by one priority after every 0.5 seconds, so that it will not be starved.
+     The UI thread is `HandlePriority::Interactive` by default, while the others are `HandlePriority::Normal`.
+     */
+    static void setThreadedHandlePriority(HandlePriority priority);
+
+    struct HandleWaitStatistics {
+        // The number of times that a thread waits for a sqlite db handle.
+        int64_t count;
+        // The total time in seconds spent on waiting.
+        double totalWaitTime;
+        // The longest time in seconds spent on waiting.
+        double maxWaitTime;
+        // The i-th element counts the waits shorter than 2^i milliseconds, and the last one counts the rest.
+        std::vector<int64_t> histogram;
+    };
+    /**
+     @brief Get the statistics of waiting for sqlite db handles of current database, grouped by priority.
+     */
+    std::map<HandlePriority, HandleWaitStatistics> getHandleWaitStatistics() const;
+
 #if defined(_WIN32)
     /**
      @brief Config the id of UI thread.
@@ -266,6 +304,66 @@ public:
      */
     void tracePerformance(PerformanceNotification trace);
 
+    typedef struct PerformanceTrace {
+        long tag;
+        StringView path;
+        uint64_t handleIdentifier;
+        StringView sql;
+        PerformanceInfo info;
+    } PerformanceTrace;
+
+    /**
+     Triggered in background with the traces collected since last time, and the number of traces dropped due to buffer overflow.
+     */
+    typedef std::function<void(const std::vector<PerformanceTrace> &traces, uint64_t numberOfDroppedTraces)> BatchedPerformanceNotification;
+
+    /**
+     @brief Buffered version of `globalTracePerformance`, which is cheap enough to be enabled in production.
+     The executing thread only writes a compact record into its own lock-free ring buffer, and the records are delivered to tracer in batches by a background thread.
+     Records are dropped and counted if a thread produces them faster than they are drained.
+     @note  It shares the same slot with `globalTracePerformance`, so they can't be registered at the same time.
+     @param trace closure. Pass null to disable.
+     @see   `BatchedPerformanceNotification`
+     */
+    static void globalTracePerformanceInBatch(BatchedPerformanceNotification trace);
+
+    /**
+     @brief Enable the built-in statistics of the SQLs executed in the current database.
+     The SQLs are aggregated by their shapes, which are the SQLs with all literal values replaced by `?`.
+     At most 256 shapes are kept. When it's full, the shape with the least total cost is evicted, and the new shape inherits its total cost.
+     @note  The statistics are only collected for the SQLs executed by the handles opened after this is called.
+     @param enable to enable the statistics. It's disabled by default.
+     */
+    void enableStatementStatistics(bool enable);
+
+    typedef struct StatementStatistics {
+        // The SQL with all literal values replaced by `?`.
+        StringView fingerprint;
+        int64_t numberOfCalls;
+        int64_t totalCostInNanoseconds;
+        // The part of total cost inherited from the evicted shape, which is the upper bound of its overestimation.
+        int64_t inheritedCostInNanoseconds;
+        // The percentiles of the cost, with a relative error of at most 12.5%.
+        int64_t p50CostInNanoseconds;
+        int64_t p95CostInNanoseconds;
+        int64_t p99CostInNanoseconds;
+        // The total number of db pages read and written, including the table, index and overflow pages.
+        int64_t pagesRead;
+        int64_t pagesWritten;
+        int64_t rowsReturned;
+    } StatementStatistics;
+
+    /**
+     @brief Get the statement statistics of current database, which are sorted by total cost in descending order.
+     @see   `enableStatementStatistics()`
+     */
+    std::vector<StatementStatistics> getStatementStatistics() const;
+
+    /**
+     @brief Clear the statement statistics of current database.
+     */
+    void resetStatementStatistics();
+
     /**
      Triggered when a SQL is executed.
      */
@@ -428,6 +526,30 @@ public:
      */
     void enableAutoMergeFTS5Index(bool flag);
 
+    /**
+     @brief Limit the cost of each auto-merge run.
+     The fts5 tables with the most segments are merged first. The unfinished work will be continued in the following runs.
+     Auto-merge also backs off while there are foreground operations running in current database.
+     @warning Negative budgets are rejected, and the previous budget is kept.
+     @param maxDuration the maximum time in seconds spent in each run.
+     @param maxPages the maximum number of pages written in each run.
+     */
+    void setAutoMergeFTS5IndexBudget(double maxDuration, int maxPages);
+
+    struct FTS5MergeStatistics {
+        // The number of segments in fts5 index last observed by auto-merge.
+        int segmentCount;
+        // The total number of pages written by auto-merge.
+        int64_t pagesWritten;
+        // The total time in seconds spent by auto-merge.
+        double timeSpent;
+    };
+    /**
+     @brief Get the auto-merge statistics of each fts5 table in current database.
+     @return A map from table name to its statistics. Only the tables visited by auto-merge are included.
+     */
+    StringViewMap<FTS5MergeStatistics> getFTS5MergeStatistics() const;
+
     /**
      @brief Setup tokenizer with name for current database.
      It's recommended to use the builtin tokenizers defined in `FTSConst.h`.
@@ -505,6 +627,15 @@ public:
      */
     static void configPinyinConverter(PinYinConverter converter);
 
+    /**
+     @brief Configure the pinyins of Chinese characters with a dictionary file, which is loaded via mmap instead of being built in memory.
+     @note  Only available in C++. The dictionary file is saved by `WCDB::CharacterDictionary::save`, whose keys are Chinese characters and values are their pinyins.
+     @warning You should config this dictionary before using `WCDB::BuiltinTokenizer::Pinyin`. It replaces the converter configured before.
+     @param path path of the dictionary file.
+     @return false if the file can't be loaded, and the previous configuration is kept.
+     */
+    static bool configPinyinDict(const UnsafeStringView &path);
+
     /**
      Triggered when the WCDB implemented tokenizers with `WCDB::BuiltinTokenizer::Parameter::SimplifyChinese` parsing input content.
      Return the simplify Chiniese character of the input Chiniese character.
@@ -519,6 +650,15 @@ public:
      */
     static void configTraditionalChineseConverter(TraditionalChineseConverter converter);
 
+    /**
+     @brief Configure the simplified Chinese characters of traditional Chinese characters with a dictionary file, which is loaded via mmap instead of being built in memory.
+     @note  Only available in C++. The dictionary file is saved by `WCDB::CharacterDictionary::save`, whose keys are traditional Chinese characters and values are their simplified Chinese characters.
+     @warning You should config this dictionary before using the WCDB implemented tokenizers with `BuiltinTokenizer::Parameter::SimplifyChinese`. It replaces the converter configured before.
+     @param path path of the dictionary file.
+     @return false if the file can't be loaded, and the previous configuration is kept.
+     */
+    static bool configTraditionalChineseDict(const UnsafeStringView &path);
+
 #pragma mark - Memory
     /**
      @brief Purge all free memory of this database.
@@ -535,6 +675,67 @@ public:
      */
     static void purgeAll();
 
+    /**
+     @brief Limit the total memory of sqlite page cache used by all databases.
+     The budget is distributed across the sqlite db handles of all databases, weighted by their recent cache lookups and hits.
+     The cache size of each handle is adjusted while it's being obtained and recycled, and the cache of the recycled handles will be released if the budget is exceeded.
+     @note It will override the `cache_size` pragma you set in the configs.
+     @param bytes the total budget. It's 0 by default, which means each sqlite db handle uses the default cache size of sqlite.
+     */
+    static void setPageCacheBudget(int64_t bytes);
+
+    struct PageCacheStatistics {
+        // The memory in bytes used by the page cache of all sqlite db handles of current database.
+        int64_t cacheUsed;
+        // The total number of page cache hits.
+        int64_t hits;
+        // The total number of page cache misses.
+        int64_t misses;
+        // The cache size limit in bytes of each sqlite db handle most recently applied.
+        int64_t limitPerHandle;
+    };
+    /**
+     @brief Get the page cache statistics of current database.
+     @note The statistics are only collected while the page cache budget is set.
+     @see   `static Database::setPageCacheBudget()`
+     */
+    PageCacheStatistics getPageCacheStatistics() const;
+
+    /**
+     @brief Keep some sqlite db handles open even if they are not in use.
+     WCDB opens them in background after this is called, and again once the database is used after being purged or closed, so that the first reads do not pay for opening and configuring the sqlite db handles.
+     @param count the number of warm handles, which is at most 8. It's 0 by default.
+     */
+    void setNumberOfWarmHandles(int count);
+
+    /**
+     @brief Close the free sqlite db handles that have not been used for a while.
+     The warm handles set by `setNumberOfWarmHandles` are always kept.
+     @param seconds the idle duration after which a free handle is closed. It's 0 by default, which means the free handles are only closed by `purge`.
+     */
+    void setMaxIdleDurationOfHandles(double seconds);
+
+    /**
+     @brief Register a query that will be run by `prewarm()` to load the db pages it reads into caches in advance.
+     It's usually the query to be run soon after some user navigation, such as getting the latest messages of a conversation.
+     @param query the query with bind parameters, which are bound by the bindings passed to `prewarm()`.
+     */
+    void addWarmUpQuery(const StatementSelect &query);
+
+    /**
+     @brief Remove all the queries registered by `addWarmUpQuery()`.
+     */
+    void removeAllWarmUpQueries();
+
+    /**
+     @brief Run all the warm-up queries in background and discard their results, so that the db pages they read are loaded into the os and sqlite caches.
+     The bindings are bound to the bind parameters of each warm-up query in order, and the redundant ones are ignored.
+     The handle for the warm-up queries is acquired with `HandlePriority::Background`, so it gives way to the other threads.
+     @note  The pending bindings are replaced if it's called again before the warm-up queries are run.
+     @see   `addWarmUpQuery()`
+     */
+    void prewarm(const OneRowValue &bindings = {});
+
 #pragma mark - Repair
     /**
      Triggered when a database is confirmed to be corrupted.
@@ -567,6 +768,18 @@ public:
      */
     bool isAlreadyCorrupted();
 
+    /**
+     @brief Enable database to check the integrity of the pages modified since the last check.
+     After the modified pages are checkpointed, WCDB will asynchronously parse these b-tree pages instead of running a `PRAGMA integrity_check` on the whole database.
+     A full integrity check will still be run if the database has never been fully checked, once the `fullCheckInterval` has passed since the last full check, or too many pages are modified. The time of the last full check is saved along with the database, so it's kept across launches.
+     Once the corruption is confirmed, WCDB will notify you through the callback registered by `Database::setNotificationWhenCorrupted()`.
+     The result and the cost of each check are reported as a notice through the error tracer.
+     @param flag to enable incremental integrity check.
+     @param fullCheckInterval the minimum interval in seconds between two full integrity checks, which is 7 days by default.
+     */
+    void enableIncrementalIntegrityCheck(bool flag, double fullCheckInterval);
+    void enableIncrementalIntegrityCheck(bool flag);
+
     /**
      @brief Enable database to automatically backup itself after there are updates.
      The backup content mainly includes the SQL statements related to table creation and all leaf page numbers of each table in database. 
@@ -696,6 +909,25 @@ public:
      */
     void removeConfig(const UnsafeStringView &name);
 
+    /**
+     @brief Enable memory-mapped I/O for the reading of current database.
+     The `mmap_size` of each sqlite db handle is twice the database file size rounded up to the power of 2, ranged from 32MB to 1GB and limited by the available address space.
+     It follows the growth of the database file, which is re-evaluated after each checkpoint.
+     It reduces a memory copy and a system call for each page read, which benefits the read-mostly databases.
+     @note  It doesn't take effect on the encrypted databases or the 32-bit platforms.
+     @param flag to enable adaptive mmap. It's disabled by default.
+     */
+    void enableAdaptiveMMap(bool flag);
+
+    /**
+     @brief Enable single writer mode for current database.
+     All the writes of current database are done by one long-lived sqlite db handle in turn, while the reads still use the other handles concurrently.
+     The writing threads wait for the writer handle in the order of their priorities, instead of busy retrying on the write lock of sqlite.
+     @note  A thread that already holds a handle for reading writes with that handle, which still competes with the writer handle.
+     @param flag to enable single writer mode. It's disabled by default, which allows up to 4 handles to write at the same time.
+     */
+    void enableSingleWriter(bool flag);
+
     /**
     @brief Set the default directory for temporary database files. If not set, an existing directory will be selected as the temporary database files directory in the following order:
         1. TMPDIR environment value;
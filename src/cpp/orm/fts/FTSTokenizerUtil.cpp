@@ -24,7 +24,9 @@
 
 #include "FTSTokenizerUtil.hpp"
 #include "StatementCreateVirtualTable.hpp"
+#include <algorithm>
 #include <cstdarg>
+#include <cstring>
 
 namespace WCDB {
 
@@ -42,4 +44,207 @@ StringView FTSTokenizerUtil::tokenize(const char* name, ...)
     return WCDB::StringView(stream.str());
 }
 
+#pragma mark - Pinyin Match Pattern
+// All the syllables of Hanyu Pinyin without tones, in lexicographical order.
+static const char* const g_pinyinSyllables[] = {
+    "a", "ai", "an", "ang", "ao", "ba", "bai", "ban", "bang", "bao", "bei", "ben", "beng", "bi",
+    "bian", "biao", "bie", "bin", "bing", "bo", "bu", "ca", "cai", "can", "cang", "cao", "ce",
+    "cen", "ceng", "cha", "chai", "chan", "chang", "chao", "che", "chen", "cheng", "chi",
+    "chong", "chou", "chu", "chua", "chuai", "chuan", "chuang", "chui", "chun", "chuo", "ci",
+    "cong", "cou", "cu", "cuan", "cui", "cun", "cuo", "da", "dai", "dan", "dang", "dao", "de",
+    "dei", "den", "deng", "di", "dia", "dian", "diao", "die", "ding", "diu", "dong", "dou",
+    "du", "duan", "dui", "dun", "duo", "e", "ei", "en", "eng", "er", "fa", "fan", "fang", "fei",
+    "fen", "feng", "fo", "fou", "fu", "ga", "gai", "gan", "gang", "gao", "ge", "gei", "gen",
+    "geng", "gong", "gou", "gu", "gua", "guai", "guan", "guang", "gui", "gun", "guo", "ha",
+    "hai", "han", "hang", "hao", "he", "hei", "hen", "heng", "hong", "hou", "hu", "hua", "huai",
+    "huan", "huang", "hui", "hun", "huo", "ji", "jia", "jian", "jiang", "jiao", "jie", "jin",
+    "jing", "jiong", "jiu", "ju", "juan", "jue", "jun", "ka", "kai", "kan", "kang", "kao", "ke",
+    "kei", "ken", "keng", "kong", "kou", "ku", "kua", "kuai", "kuan", "kuang", "kui", "kun",
+    "kuo", "la", "lai", "lan", "lang", "lao", "le", "lei", "leng", "li", "lia", "lian", "liang",
+    "liao", "lie", "lin", "ling", "liu", "lo", "long", "lou", "lu", "luan", "lun", "luo", "lv",
+    "lve", "ma", "mai", "man", "mang", "mao", "me", "mei", "men", "meng", "mi", "mian", "miao",
+    "mie", "min", "ming", "miu", "mo", "mou", "mu", "na", "nai", "nan", "nang", "nao", "ne",
+    "nei", "nen", "neng", "ni", "nian", "niang", "niao", "nie", "nin", "ning", "niu", "nong",
+    "nou", "nu", "nuan", "nun", "nuo", "nv", "nve", "o", "ou", "pa", "pai", "pan", "pang",
+    "pao", "pei", "pen", "peng", "pi", "pian", "piao", "pie", "pin", "ping", "po", "pou", "pu",
+    "qi", "qia", "qian", "qiang", "qiao", "qie", "qin", "qing", "qiong", "qiu", "qu", "quan",
+    "que", "qun", "ran", "rang", "rao", "re", "ren", "reng", "ri", "rong", "rou", "ru", "rua",
+    "ruan", "rui", "run", "ruo", "sa", "sai", "san", "sang", "sao", "se", "sen", "seng", "sha",
+    "shai", "shan", "shang", "shao", "she", "shei", "shen", "sheng", "shi", "shou", "shu",
+    "shua", "shuai", "shuan", "shuang", "shui", "shun", "shuo", "si", "song", "sou", "su",
+    "suan", "sui", "sun", "suo", "ta", "tai", "tan", "tang", "tao", "te", "teng", "ti", "tian",
+    "tiao", "tie", "ting", "tong", "tou", "tu", "tuan", "tui", "tun", "tuo", "wa", "wai", "wan",
+    "wang", "wei", "wen", "weng", "wo", "wu", "xi", "xia", "xian", "xiang", "xiao", "xie",
+    "xin", "xing", "xiong", "xiu", "xu", "xuan", "xue", "xun", "ya", "yan", "yang", "yao", "ye",
+    "yi", "yin", "ying", "yo", "yong", "you", "yu", "yuan", "yue", "yun", "za", "zai", "zan",
+    "zang", "zao", "ze", "zei", "zen", "zeng", "zha", "zhai", "zhan", "zhang", "zhao", "zhe",
+    "zhei", "zhen", "zheng", "zhi", "zhong", "zhou", "zhu", "zhua", "zhuai", "zhuan", "zhuang",
+    "zhui", "zhun", "zhuo", "zi", "zong", "zou", "zu", "zuan", "zui", "zun", "zuo",
+};
+
+static const char* const* pinyinSyllablesEnd()
+{
+    return g_pinyinSyllables + sizeof(g_pinyinSyllables) / sizeof(g_pinyinSyllables[0]);
+}
+
+static bool isPinyinSyllable(const std::string& syllable)
+{
+    return std::binary_search(
+    g_pinyinSyllables, pinyinSyllablesEnd(), syllable.c_str(), [](const char* left, const char* right) {
+        return strcmp(left, right) < 0;
+    });
+}
+
+static bool isPinyinSyllablePrefix(const std::string& prefix)
+{
+    const char* const* iter = std::lower_bound(
+    g_pinyinSyllables, pinyinSyllablesEnd(), prefix.c_str(), [](const char* left, const char* right) {
+        return strcmp(left, right) < 0;
+    });
+    return iter != pinyinSyllablesEnd() && strncmp(*iter, prefix.c_str(), prefix.length()) == 0;
+}
+
+/*
+ Split letters into units. Each unit is a full syllable or the first letter of a syllable.
+ The last unit of the whole input can also be a prefix of a syllable, since it's being typed.
+ All the segmentations with the fewest abbreviations are kept, such as both "xian" and "xi an",
+ so that "shan" is never split into "s h a n". They are ordered by the number of units and limited to a few.
+ The result of each suffix is memorized to keep it linear.
+ */
+struct PinyinSegmentation {
+    std::vector<std::string> units;
+    size_t numberOfAbbreviations = 0;
+
+    bool isBetterThan(const PinyinSegmentation& other) const
+    {
+        if (numberOfAbbreviations != other.numberOfAbbreviations) {
+            return numberOfAbbreviations < other.numberOfAbbreviations;
+        }
+        return units.size() < other.units.size();
+    }
+};
+typedef std::vector<PinyinSegmentation> PinyinSegmentations;
+static const size_t PinyinMaxSegmentations = 8;
+static const size_t PinyinMaxSyllableLength = 6;
+
+static void keepBestPinyinSegmentations(PinyinSegmentations& segmentations)
+{
+    std::stable_sort(segmentations.begin(),
+                     segmentations.end(),
+                     [](const PinyinSegmentation& left, const PinyinSegmentation& right) {
+                         return left.isBetterThan(right);
+                     });
+    size_t count = 0;
+    while (count < segmentations.size() && count < PinyinMaxSegmentations
+           && segmentations[count].numberOfAbbreviations
+              == segmentations.front().numberOfAbbreviations) {
+        ++count;
+    }
+    segmentations.resize(count);
+}
+
+static void segmentPinyin(const std::string& letters,
+                          size_t offset,
+                          bool isLastGroup,
+                          std::vector<std::unique_ptr<PinyinSegmentations>>& memo)
+{
+    if (memo[offset] != nullptr) {
+        return;
+    }
+    memo[offset].reset(new PinyinSegmentations());
+    PinyinSegmentations& result = *memo[offset];
+    size_t maxLength = std::min(PinyinMaxSyllableLength, letters.length() - offset);
+    for (size_t length = maxLength; length > 0; --length) {
+        std::string unit = letters.substr(offset, length);
+        bool isEnd = offset + length == letters.length();
+        bool isTyping = isEnd && isLastGroup;
+        bool isSyllable = isPinyinSyllable(unit);
+        bool valid = isSyllable || ((length == 1 || isTyping) && isPinyinSyllablePrefix(unit));
+        if (!valid) {
+            continue;
+        }
+        // The syllable being typed is not an abbreviation.
+        size_t numberOfAbbreviations = isSyllable || isTyping ? 0 : 1;
+        if (isEnd) {
+            result.push_back({ { unit }, numberOfAbbreviations });
+            continue;
+        }
+        segmentPinyin(letters, offset + length, isLastGroup, memo);
+        // The kept ones of the whole are made up of the kept ones of the suffix.
+        for (const auto& rest : *memo[offset + length]) {
+            result.push_back({ { unit }, numberOfAbbreviations + rest.numberOfAbbreviations });
+            result.back().units.insert(
+            result.back().units.end(), rest.units.begin(), rest.units.end());
+        }
+    }
+    keepBestPinyinSegmentations(result);
+}
+
+StringView FTSTokenizerUtil::pinyinMatchPattern(const UnsafeStringView& input, bool prefixIndexed)
+{
+    // Letters separated by other characters are segmented separately.
+    std::vector<std::string> groups(1);
+    for (size_t i = 0; i < input.length(); ++i) {
+        char character = input.at(i);
+        if (isalpha((unsigned char) character) && (unsigned char) character < 0x80) {
+            groups.back().push_back((char) tolower(character));
+        } else if (!groups.back().empty()) {
+            groups.emplace_back();
+        }
+    }
+    if (groups.back().empty()) {
+        groups.pop_back();
+    }
+    if (groups.empty()) {
+        return StringView();
+    }
+
+    PinyinSegmentations phrases(1);
+    bool isLastGroupPinyin = true;
+    for (size_t i = 0; i < groups.size(); ++i) {
+        const std::string& letters = groups[i];
+        std::vector<std::unique_ptr<PinyinSegmentations>> memo(letters.length() + 1);
+        segmentPinyin(letters, 0, i == groups.size() - 1, memo);
+        PinyinSegmentations segmentations = std::move(*memo[0]);
+        isLastGroupPinyin = !segmentations.empty();
+        if (segmentations.empty()) {
+            // Not a pinyin. Search it as it is.
+            segmentations.push_back({ { letters }, 0 });
+        }
+        PinyinSegmentations combined;
+        for (const auto& phrase : phrases) {
+            for (const auto& segmentation : segmentations) {
+                combined.push_back(phrase);
+                combined.back().units.insert(combined.back().units.end(),
+                                             segmentation.units.begin(),
+                                             segmentation.units.end());
+                combined.back().numberOfAbbreviations += segmentation.numberOfAbbreviations;
+            }
+        }
+        keepBestPinyinSegmentations(combined);
+        phrases = std::move(combined);
+    }
+
+    std::ostringstream stream;
+    for (size_t i = 0; i < phrases.size(); ++i) {
+        if (i > 0) {
+            stream << " OR ";
+        }
+        stream << '"';
+        const std::vector<std::string>& units = phrases[i].units;
+        for (size_t j = 0; j < units.size(); ++j) {
+            if (j > 0) {
+                stream << ' ';
+            }
+            stream << units[j];
+        }
+        stream << '"';
+        // Only the prefixes of pinyins are indexed, so the other letters are still searched by prefix.
+        if (!prefixIndexed || !isLastGroupPinyin) {
+            stream << '*';
+        }
+    }
+    return StringView(stream.str());
+}
+
 } // namespace WCDB
@@ -32,6 +32,17 @@ namespace WCDB {
 class WCDB_API FTSTokenizerUtil final : public BaseTokenizerUtil {
 public:
     static StringView tokenize(const char* name, ...);
+
+    /**
+     @brief Generate the match pattern for the pinyin typed by user, which is used to search a fts5 table with `BuiltinTokenizer::Pinyin`.
+     Continuous letters are split into pinyin syllables, such as "zhangsan" into "zhang san", and each syllable can also be abbreviated to its first letter, such as "zhangs".
+     All the splits with the fewest abbreviations are searched, such as both "xian" and "xi an".
+     The last syllable is treated as being typed, so it matches all the pinyins beginning with it.
+     @param input The pinyin typed by user. Spaces and apostrophes can be used to separate syllables.
+     @param prefixIndexed Whether the table is tokenized with `BuiltinTokenizer::Parameter::PinyinPrefix`. The last syllable will be searched as a term instead of a prefix if so, while the letters that are not pinyin are still searched as a prefix.
+     @return The match pattern, such as `"zhang s"*`. It's empty if there is no letter in input.
+     */
+    static StringView pinyinMatchPattern(const UnsafeStringView& input, bool prefixIndexed = false);
 };
 
 } //namespace WCDB
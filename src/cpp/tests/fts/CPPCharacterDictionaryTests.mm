@@ -0,0 +1,218 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "CPPFTS5Object.h"
+#import "CPPTestCase.h"
+#import <Foundation/Foundation.h>
+
+@interface CPPCharacterDictionaryTests : CPPTableTestCase
+
+@property (nonatomic, readonly) NSString *dictionaryPath;
+
+@end
+
+@implementation CPPCharacterDictionaryTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.expectMode = DatabaseTestCaseExpectFirstFewSQLs;
+    _dictionaryPath = [self.directory stringByAppendingPathComponent:@"dictionary"];
+}
+
+- (void)tearDown
+{
+    // Release the dictionaries loaded from file.
+    WCDB::Database::configPinyinConverter(nullptr);
+    WCDB::Database::configTraditionalChineseConverter(nullptr);
+    [super tearDown];
+}
+
+- (std::unique_ptr<WCDB::CharacterDictionary>)pinyinDictionary
+{
+    WCDB::CharacterDictionary::Map map = {
+        { "单", { "shan", "dan", "chan" } },
+        { "于", { "yu" } },
+        { "骑", { "qi" } },
+        { "模", { "mo", "mu" } },
+        { "具", { "ju" } },
+        { "车", { "che" } },
+        // Keys out of BMP or with more than one character are not indexed by code point.
+        { "𠀀", { "qiu" } },
+        { "单车", { "dan che" } },
+        { "a", { "a" } },
+    };
+    return WCDB::CharacterDictionary::build(map);
+}
+
+- (void)checkPinyinDictionary:(const WCDB::CharacterDictionary &)dictionary
+{
+    auto values = dictionary.get("单");
+    TestCaseAssertEqual(values.size(), 3);
+    TestCaseAssertTrue(values.at(0).compare("shan") == 0);
+    TestCaseAssertTrue(values.at(1).compare("dan") == 0);
+    TestCaseAssertTrue(values.at(2).compare("chan") == 0);
+    // The strings are null-terminated.
+    TestCaseAssertEqual(strlen(values.at(2).data()), 4);
+
+    values = dictionary.get("模");
+    TestCaseAssertEqual(values.size(), 2);
+    TestCaseAssertTrue(values.at(1).compare("mu") == 0);
+
+    values = dictionary.get("𠀀");
+    TestCaseAssertEqual(values.size(), 1);
+    TestCaseAssertTrue(values.at(0).compare("qiu") == 0);
+
+    values = dictionary.get("单车");
+    TestCaseAssertEqual(values.size(), 1);
+    TestCaseAssertTrue(values.at(0).compare("dan che") == 0);
+
+    values = dictionary.get("a");
+    TestCaseAssertEqual(values.size(), 1);
+    TestCaseAssertTrue(values.at(0).compare("a") == 0);
+
+    // Missing keys inside and outside the indexed range.
+    TestCaseAssertTrue(dictionary.get("丁").empty());
+    TestCaseAssertTrue(dictionary.get("b").empty());
+    TestCaseAssertTrue(dictionary.get("你好").empty());
+    TestCaseAssertTrue(dictionary.get("").empty());
+}
+
+- (void)test_build
+{
+    auto dictionary = [self pinyinDictionary];
+    TestCaseAssertTrue(dictionary != nullptr);
+    [self checkPinyinDictionary:*dictionary];
+
+    WCDB::StringViewMap<WCDB::StringView> traditionalChinese = {
+        { "們", "们" },
+        { "員", "员" },
+    };
+    auto simplified = WCDB::CharacterDictionary::build(traditionalChinese);
+    TestCaseAssertTrue(simplified != nullptr);
+    TestCaseAssertTrue(simplified->get("們").at(0).compare("们") == 0);
+    TestCaseAssertTrue(simplified->get("員").at(0).compare("员") == 0);
+    TestCaseAssertTrue(simplified->get("们").empty());
+
+    auto empty = WCDB::CharacterDictionary::build(WCDB::CharacterDictionary::Map());
+    TestCaseAssertTrue(empty != nullptr);
+    TestCaseAssertTrue(empty->get("单").empty());
+    TestCaseAssertTrue(empty->get("单车").empty());
+}
+
+- (void)test_save_and_load
+{
+    auto dictionary = [self pinyinDictionary];
+    TestCaseAssertTrue(dictionary->save(self.dictionaryPath.UTF8String));
+
+    auto loaded = WCDB::CharacterDictionary::load(self.dictionaryPath.UTF8String);
+    TestCaseAssertTrue(loaded != nullptr);
+    [self checkPinyinDictionary:*loaded];
+}
+
+- (void)test_load_corrupted_file
+{
+    TestCaseAssertTrue(WCDB::CharacterDictionary::load(self.dictionaryPath.UTF8String) == nullptr);
+
+    auto dictionary = [self pinyinDictionary];
+    TestCaseAssertTrue(dictionary->save(self.dictionaryPath.UTF8String));
+    NSData *data = [NSData dataWithContentsOfFile:self.dictionaryPath];
+
+    // Truncated
+    TestCaseAssertTrue([[data subdataWithRange:NSMakeRange(0, data.length - 1)] writeToFile:self.dictionaryPath atomically:YES]);
+    TestCaseAssertTrue(WCDB::CharacterDictionary::load(self.dictionaryPath.UTF8String) == nullptr);
+
+    // Mismatched magic
+    NSMutableData *corrupted = [data mutableCopy];
+    const unsigned char garbage[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+    [corrupted replaceBytesInRange:NSMakeRange(0, 4) withBytes:garbage];
+    TestCaseAssertTrue([corrupted writeToFile:self.dictionaryPath atomically:YES]);
+    TestCaseAssertTrue(WCDB::CharacterDictionary::load(self.dictionaryPath.UTF8String) == nullptr);
+
+    // The string pool is not null-terminated.
+    corrupted = [data mutableCopy];
+    [corrupted replaceBytesInRange:NSMakeRange(data.length - 1, 1) withBytes:garbage];
+    TestCaseAssertTrue([corrupted writeToFile:self.dictionaryPath atomically:YES]);
+    TestCaseAssertTrue(WCDB::CharacterDictionary::load(self.dictionaryPath.UTF8String) == nullptr);
+}
+
+- (void)test_config_pinyin_dict_with_path
+{
+    TestCaseAssertFalse(WCDB::Database::configPinyinDict(self.dictionaryPath.UTF8String));
+    TestCaseAssertTrue([self pinyinDictionary]->save(self.dictionaryPath.UTF8String));
+    TestCaseAssertTrue(WCDB::Database::configPinyinDict(self.dictionaryPath.UTF8String));
+
+    WCDB::Database::configSymbolDetector([](WCDB::Database::UnicodeChar theChar) {
+        if (theChar < 0xC0) {
+            if (!(theChar >= 0x30 && theChar <= 0x39) && !((theChar >= 0x41 && theChar <= 0x5a) || (theChar >= 0x61 && theChar <= 0x7a))) {
+                return true;
+            }
+        }
+        return false;
+    });
+    self.database->addTokenizer(WCDB::BuiltinTokenizer::Pinyin);
+    TestCaseAssertTrue(self.database->createVirtualTable<CPPFTS5PinyinObject>(self.tableName.UTF8String));
+    CPPFTS5PinyinObject content;
+    content.content = "单于骑模具单车";
+    TestCaseAssertTrue(self.database->insertObjects<CPPFTS5PinyinObject>(content, self.tableName.UTF8String));
+
+    NSArray *querys = @[
+        @"\"shan yu qi mu ju dan che\"",
+        @"\"dan yu qi mo ju chan che\"",
+        @"\"s y q m j d c\"",
+    ];
+    for (NSString *query in querys) {
+        [self doTestRows:{ CPPOneRowValueExtract(content) }
+                  andSQL:[NSString stringWithFormat:@"SELECT content FROM testTable WHERE content MATCH '%@' ORDER BY rowid ASC", query]
+             bySelecting:^WCDB::OptionalMultiRows {
+                 return CPPMultiRowValueExtract(self.database->getAllObjects<CPPFTS5PinyinObject>(self.tableName.UTF8String, WCDB_FIELD(CPPFTS5PinyinObject::content).match(query.UTF8String)).value());
+             }];
+    }
+}
+
+- (void)test_config_traditional_chinese_dict_with_path
+{
+    WCDB::StringViewMap<WCDB::StringView> traditionalChinese = {
+        { "們", "们" },
+        { "員", "员" },
+    };
+    TestCaseAssertTrue(WCDB::CharacterDictionary::build(traditionalChinese)->save(self.dictionaryPath.UTF8String));
+    TestCaseAssertTrue(WCDB::Database::configTraditionalChineseDict(self.dictionaryPath.UTF8String));
+
+    // The loaded dictionary is kept if the new one can't be loaded.
+    NSString *missingPath = [self.directory stringByAppendingPathComponent:@"missing"];
+    TestCaseAssertFalse(WCDB::Database::configTraditionalChineseDict(missingPath.UTF8String));
+
+    self.database->addTokenizer(WCDB::BuiltinTokenizer::Verbatim);
+    TestCaseAssertTrue(self.database->createVirtualTable<CPPFTS5Object>(self.tableName.UTF8String));
+    CPPFTS5Object object("我們是程序員", "");
+    TestCaseAssertTrue(self.database->insertObjects<CPPFTS5Object>(object, self.tableName.UTF8String));
+    [self doTestRows:{ CPPOneRowValueExtract(object) }
+              andSQL:@"SELECT content, extension FROM testTable WHERE content MATCH '我们是程序员' ORDER BY rowid ASC"
+         bySelecting:^WCDB::OptionalMultiRows {
+             return CPPMultiRowValueExtract(self.database->getAllObjects<CPPFTS5Object>(self.tableName.UTF8String, WCDB_FIELD(CPPFTS5Object::content).match("我们是程序员")).value());
+         }];
+}
+
+@end
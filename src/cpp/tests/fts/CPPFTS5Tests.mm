@@ -259,6 +259,47 @@
          }];
 }
 
+- (void)test_bulk_insert
+{
+    WCDB::MultiRowsValue rows;
+    for (int i = 0; i < 1000; i++) {
+        rows.push_back({ i % 2 == 0 ? "苹果树" : "WCDB is a cross-platform database framework", WCDB::StringView::formatted("extension %d", i) });
+    }
+    TestCaseAssertTrue(self.ftsTable.bulkInsertFTS5Rows(rows, { WCDB_FIELD(CPPFTS5Object::content), WCDB_FIELD(CPPFTS5Object::extension) }));
+
+    auto chineseObjects = self.ftsTable.getAllObjects(WCDB_FIELD(CPPFTS5Object::content).match("果树"));
+    TestCaseAssertTrue(chineseObjects.succeed());
+    TestCaseAssertTrue(chineseObjects.value().size() == 500);
+    auto englishObjects = self.ftsTable.getAllObjects(WCDB_FIELD(CPPFTS5Object::content).match("frameworks"));
+    TestCaseAssertTrue(englishObjects.succeed());
+    TestCaseAssertTrue(englishObjects.value().size() == 500);
+    auto extensionObjects = self.ftsTable.getAllObjects(WCDB_FIELD(CPPFTS5Object::extension).match("999"));
+    TestCaseAssertTrue(extensionObjects.succeed());
+    TestCaseAssertTrue(extensionObjects.value().size() == 1);
+}
+
+- (void)test_bulk_insert_with_trigger_into_table_of_other_arguments
+{
+    // The trigger indexes the same texts by the same tokenizer with other arguments, which produces other tokens.
+    NSString *symbolTableName = [NSString stringWithFormat:@"%@_symbol", self.tableName];
+    TestCaseAssertTrue(self.database->createVirtualTable<CPPFTS5SymbolObject>(symbolTableName.UTF8String));
+    WCDB::StatementInsert insert = WCDB::StatementInsert().insertIntoTable(symbolTableName.UTF8String).columns({ WCDB::Column("content") }).values({ WCDB::Column("content").table("new") });
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementCreateTrigger().createTrigger("testTrigger").after().insert().on(self.tableName.UTF8String).forEachRow().execute(insert)));
+
+    WCDB::MultiRowsValue rows;
+    for (int i = 0; i < 1000; i++) {
+        rows.push_back({ "abc@123", WCDB::StringView::formatted("extension %d", i) });
+    }
+    TestCaseAssertTrue(self.ftsTable.bulkInsertFTS5Rows(rows, { WCDB_FIELD(CPPFTS5Object::content), WCDB_FIELD(CPPFTS5Object::extension) }));
+
+    auto objects = self.ftsTable.getAllObjects(WCDB_FIELD(CPPFTS5Object::content).match("abc"));
+    TestCaseAssertTrue(objects.succeed());
+    TestCaseAssertTrue(objects.value().size() == 1000);
+    auto symbolObjects = self.database->getAllObjects<CPPFTS5SymbolObject>(symbolTableName.UTF8String, WCDB_FIELD(CPPFTS5SymbolObject::content).match("\"abc@123\""));
+    TestCaseAssertTrue(symbolObjects.succeed());
+    TestCaseAssertTrue(symbolObjects.value().size() == 1000);
+}
+
 - (void)test_auto_merge
 {
     self.database->enableAutoMergeFTS5Index(true);
@@ -277,6 +318,24 @@
     TestCaseAssertTrue(count.value() == 1);
 }
 
+- (void)test_merge_statistics
+{
+    self.database->enableAutoMergeFTS5Index(true);
+    self.database->setAutoMergeFTS5IndexBudget(1.0, 4096);
+    for (int i = 0; i < 14; i++) {
+        CPPFTS5Object object(Random.shared.chineseString.UTF8String, "");
+        TestCaseAssertTrue(self.ftsTable.insertObjects(object));
+    }
+
+    [NSThread sleepForTimeInterval:2.5];
+
+    auto statistics = self.database->getFTS5MergeStatistics();
+    auto iter = statistics.find(self.tableName.UTF8String);
+    TestCaseAssertTrue(iter != statistics.end());
+    TestCaseAssertTrue(iter->second.segmentCount == 1);
+    TestCaseAssertTrue(iter->second.timeSpent > 0);
+}
+
 - (void)test_thread_conflict
 {
     self.database->enableAutoMergeFTS5Index(true);
@@ -325,7 +384,9 @@
         { "骑", { "qi" } },
         { "模", { "mo", "mu" } },
         { "具", { "ju" } },
-        { "车", { "che" } }
+        { "车", { "che" } },
+        { "西", { "xi" } },
+        { "安", { "an" } }
     };
     WCDB::Database::configPinyinConverter([=](const WCDB::UnsafeStringView &token) {
         if (pinyinDict.find(token) == pinyinDict.end()) {
@@ -379,6 +440,49 @@
     }
 }
 
+- (void)test_pinyin_match_pattern
+{
+    CPPFTS5PinyinObject content;
+    content.content = "单于骑模具单车";
+    TestCaseAssertTrue(self.database->insertObjects<CPPFTS5PinyinObject>(content, self.tableName.UTF8String));
+
+    const char *prefixTable = "prefixTable";
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementCreateVirtualTable()
+                                              .createVirtualTable(prefixTable)
+                                              .usingModule(WCDB::Module::FTS5)
+                                              .argument("content")
+                                              .argument(WCDB::FTSTokenizerUtil::tokenize(WCDB::BuiltinTokenizer::Pinyin, WCDB::BuiltinTokenizer::Parameter::PinyinPrefix, nullptr))));
+    TestCaseAssertTrue(self.database->insertObjects<CPPFTS5PinyinObject>(content, prefixTable));
+
+    TestCaseAssertTrue(WCDB::FTSTokenizerUtil::pinyinMatchPattern("shanyu'qi MUJ").compare("\"shan yu qi mu j\"*") == 0);
+    TestCaseAssertTrue(WCDB::FTSTokenizerUtil::pinyinMatchPattern("shanyu'qi MUJ", true).compare("\"shan yu qi mu j\"") == 0);
+    TestCaseAssertTrue(WCDB::FTSTokenizerUtil::pinyinMatchPattern("+-").empty());
+    // All the segmentations with the fewest abbreviations are searched.
+    TestCaseAssertTrue(WCDB::FTSTokenizerUtil::pinyinMatchPattern("xian").compare("\"xian\"* OR \"xia n\"* OR \"xi an\"* OR \"xi a n\"*") == 0);
+    // Letters that are not pinyin are still searched by prefix.
+    TestCaseAssertTrue(WCDB::FTSTokenizerUtil::pinyinMatchPattern("xian iphone", true).compare("\"xian iphone\"* OR \"xi an iphone\"*") == 0);
+
+    CPPFTS5PinyinObject place;
+    place.content = "西安";
+    TestCaseAssertTrue(self.database->insertObjects<CPPFTS5PinyinObject>(place, self.tableName.UTF8String));
+    TestCaseAssertTrue(self.database->insertObjects<CPPFTS5PinyinObject>(place, prefixTable));
+    auto places = self.database->getAllObjects<CPPFTS5PinyinObject>(self.tableName.UTF8String, WCDB_FIELD(CPPFTS5PinyinObject::content).match(WCDB::FTSTokenizerUtil::pinyinMatchPattern("xian")));
+    TestCaseAssertTrue(places.succeed() && places.value().size() == 1);
+    auto prefixPlaces = self.database->getAllObjects<CPPFTS5PinyinObject>(prefixTable, WCDB_FIELD(CPPFTS5PinyinObject::content).match(WCDB::FTSTokenizerUtil::pinyinMatchPattern("xian", true)));
+    TestCaseAssertTrue(prefixPlaces.succeed() && prefixPlaces.value().size() == 1);
+
+    NSArray *inputs = @[ @"shanyuqimujudanche", @"danyuqimoj", @"dyqmjsc", @"chanyu qimoju sh", @"danyuqimujuch" ];
+    for (NSString *input in inputs) {
+        WCDB::StringView pattern = WCDB::FTSTokenizerUtil::pinyinMatchPattern(input.UTF8String);
+        auto objects = self.database->getAllObjects<CPPFTS5PinyinObject>(self.tableName.UTF8String, WCDB_FIELD(CPPFTS5PinyinObject::content).match(pattern));
+        TestCaseAssertTrue(objects.succeed() && objects.value().size() == 1);
+
+        WCDB::StringView prefixPattern = WCDB::FTSTokenizerUtil::pinyinMatchPattern(input.UTF8String, true);
+        auto prefixObjects = self.database->getAllObjects<CPPFTS5PinyinObject>(prefixTable, WCDB_FIELD(CPPFTS5PinyinObject::content).match(prefixPattern));
+        TestCaseAssertTrue(prefixObjects.succeed() && prefixObjects.value().size() == 1);
+    }
+}
+
 @end
 
 @interface CPPFTS5SymbolTests : CPPTableTestCase
@@ -148,6 +148,180 @@
     TestCaseAssertFalse(self.database->isOpened());
 }
 
+- (void)test_warm_handles
+{
+    TestCaseAssertFalse(self.database->isOpened());
+    self.database->setNumberOfWarmHandles(2);
+    [NSThread sleepForTimeInterval:1];
+    TestCaseAssertTrue(self.database->isOpened());
+
+    self.database->purge();
+    TestCaseAssertFalse(self.database->isOpened());
+}
+
+- (void)test_evict_idle_handles
+{
+    self.database->setMaxIdleDurationOfHandles(1);
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementPragma().pragma(WCDB::Pragma::userVersion())));
+    TestCaseAssertTrue(self.database->isOpened());
+
+    [NSThread sleepForTimeInterval:3];
+    TestCaseAssertFalse(self.database->isOpened());
+
+    // warm handles are kept
+    self.database->setNumberOfWarmHandles(1);
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementPragma().pragma(WCDB::Pragma::userVersion())));
+    [NSThread sleepForTimeInterval:3];
+    TestCaseAssertTrue(self.database->isOpened());
+}
+
+- (void)test_page_cache_budget
+{
+    WCDB::Database::setPageCacheBudget(1024 * 1024);
+    WCDB::MultiRowsValue rows = [Random.shared autoIncrementTestCaseValuesWithCount:1000];
+    TestCaseAssertTrue([self createValueTable]);
+    TestCaseAssertTrue(self.database->insertRows(rows, self.columns, self.tableName.UTF8String));
+    auto values = self.database->getAllRowsFromStatement(WCDB::StatementSelect().select(WCDB::Column::all()).from(self.tableName.UTF8String));
+    TestCaseAssertTrue(values.succeed() && values.value().size() == 1000);
+
+    auto statistics = self.database->getPageCacheStatistics();
+    TestCaseAssertTrue(statistics.hits + statistics.misses > 0);
+    TestCaseAssertTrue(statistics.cacheUsed > 0);
+    TestCaseAssertTrue(statistics.limitPerHandle >= 256 * 1024 && statistics.limitPerHandle <= 1024 * 1024);
+
+    self.database->purge();
+    TestCaseAssertTrue(self.database->getPageCacheStatistics().cacheUsed < statistics.cacheUsed);
+    WCDB::Database::setPageCacheBudget(0);
+}
+
+- (void)test_adaptive_mmap
+{
+    WCDB::StatementPragma getMMapSize = WCDB::StatementPragma().pragma(WCDB::Pragma::mmapSize());
+    TestCaseAssertEqual(self.database->getValueFromStatement(getMMapSize).valueOrDefault().intValue(), 0);
+
+    self.database->enableAdaptiveMMap(true);
+    TestCaseAssertEqual(self.database->getValueFromStatement(getMMapSize).valueOrDefault().intValue(), 32 * 1024 * 1024);
+
+    // The mmap size grows with the database file after checkpoint, without reopening the handles.
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementCreateTable().createTable("blobs").define(WCDB::ColumnDef("content", WCDB::ColumnType::BLOB))));
+    for (int i = 0; i < 20; i++) {
+        TestCaseAssertTrue(self.database->execute(WCDB::StatementInsert().insertIntoTable("blobs").values(WCDB::Expression::function("zeroblob").invoke().arguments(1024 * 1024))));
+    }
+    TestCaseAssertTrue(self.database->truncateCheckpoint());
+    TestCaseAssertEqual(self.database->getValueFromStatement(getMMapSize).valueOrDefault().intValue(), 64 * 1024 * 1024);
+
+    self.database->enableAdaptiveMMap(false);
+    TestCaseAssertEqual(self.database->getValueFromStatement(getMMapSize).valueOrDefault().intValue(), 0);
+}
+
+- (void)test_adaptive_mmap_disabled_with_handle_in_use
+{
+    WCDB::StatementPragma getMMapSize = WCDB::StatementPragma().pragma(WCDB::Pragma::mmapSize());
+    self.database->enableAdaptiveMMap(true);
+    WCDB::Handle handle = self.database->getHandle();
+    TestCaseAssertEqual(handle.getValueFromStatement(getMMapSize).valueOrDefault().intValue(), 32 * 1024 * 1024);
+
+    // The handle in use is not purged, so the configured mmap size is restored when it's flowed out again.
+    self.database->enableAdaptiveMMap(false);
+    handle.invalidate();
+    TestCaseAssertEqual(self.database->getValueFromStatement(getMMapSize).valueOrDefault().intValue(), 0);
+}
+
+- (void)test_statement_statistics
+{
+    TestCaseAssertTrue([self createValueTable]);
+    self.database->enableStatementStatistics(true);
+
+    WCDB::MultiRowsValue rows = [Random.shared autoIncrementTestCaseValuesWithCount:10];
+    TestCaseAssertTrue(self.database->insertRows(rows, self.columns, self.tableName.UTF8String));
+    for (int i = 1; i <= 10; i++) {
+        auto values = self.database->getAllRowsFromStatement(WCDB::StatementSelect().select(WCDB::Column::all()).from(self.tableName.UTF8String).where(WCDB::Column("identifier") <= i));
+        TestCaseAssertTrue(values.succeed() && values.value().size() == i);
+    }
+
+    auto statistics = self.database->getStatementStatistics();
+    TestCaseAssertTrue(statistics.size() > 0);
+    bool found = false;
+    for (const auto& entry : statistics) {
+        if (entry.fingerprint.hasPrefix("SELECT")) {
+            found = true;
+            TestCaseAssertTrue(entry.fingerprint.hasSuffix("WHERE identifier <= ?"));
+            TestCaseAssertEqual(entry.numberOfCalls, 10);
+            TestCaseAssertEqual(entry.rowsReturned, 55);
+            TestCaseAssertTrue(entry.pagesRead > 0);
+            TestCaseAssertTrue(entry.p50CostInNanoseconds <= entry.p95CostInNanoseconds);
+            TestCaseAssertTrue(entry.p95CostInNanoseconds <= entry.p99CostInNanoseconds);
+        }
+    }
+    TestCaseAssertTrue(found);
+
+    self.database->resetStatementStatistics();
+    TestCaseAssertTrue(self.database->getStatementStatistics().empty());
+    self.database->enableStatementStatistics(false);
+}
+
+- (void)test_statement_statistics_eviction
+{
+    TestCaseAssertTrue([self createValueTable]);
+    self.database->enableStatementStatistics(true);
+
+    WCDB::StatementSelect hotSelect = WCDB::StatementSelect().select(WCDB::Column::all()).from(self.tableName.UTF8String);
+    for (int i = 0; i < 100; i++) {
+        TestCaseAssertTrue(self.database->getAllRowsFromStatement(hotSelect).succeed());
+    }
+    for (int i = 0; i < 300; i++) {
+        WCDB::StatementSelect select = WCDB::StatementSelect().select(WCDB::Column("identifier").as(WCDB::StringView::formatted("shape_%d", i))).from(self.tableName.UTF8String);
+        TestCaseAssertTrue(self.database->getAllRowsFromStatement(select).succeed());
+    }
+
+    auto statistics = self.database->getStatementStatistics();
+    TestCaseAssertEqual(statistics.size(), 256);
+    bool hotShapeKept = false;
+    bool lastShapeKept = false;
+    for (const auto& entry : statistics) {
+        if (entry.numberOfCalls == 100) {
+            hotShapeKept = true;
+            TestCaseAssertEqual(entry.inheritedCostInNanoseconds, 0);
+        } else if (entry.fingerprint.hasSuffix("shape_299 FROM testTable")) {
+            lastShapeKept = true;
+            // It inherits the cost of the evicted shape.
+            TestCaseAssertTrue(entry.inheritedCostInNanoseconds > 0);
+            TestCaseAssertTrue(entry.totalCostInNanoseconds > entry.inheritedCostInNanoseconds);
+        }
+    }
+    TestCaseAssertTrue(hotShapeKept);
+    TestCaseAssertTrue(lastShapeKept);
+
+    self.database->resetStatementStatistics();
+    self.database->enableStatementStatistics(false);
+}
+
+- (void)test_prewarm
+{
+    TestCaseAssertTrue([self createValueTable]);
+    WCDB::MultiRowsValue rows = [Random.shared autoIncrementTestCaseValuesWithCount:10];
+    TestCaseAssertTrue(self.database->insertRows(rows, self.columns, self.tableName.UTF8String));
+    self.database->enableStatementStatistics(true);
+
+    self.database->addWarmUpQuery(WCDB::StatementSelect().select(WCDB::Column::all()).from(self.tableName.UTF8String).where(WCDB::Column("identifier") <= WCDB::BindParameter(1)));
+    self.database->prewarm({ 5 });
+    [NSThread sleepForTimeInterval:1];
+
+    auto statistics = self.database->getStatementStatistics();
+    TestCaseAssertEqual(statistics.size(), 1);
+    TestCaseAssertTrue(statistics[0].fingerprint.hasPrefix("SELECT"));
+    TestCaseAssertEqual(statistics[0].numberOfCalls, 1);
+    TestCaseAssertEqual(statistics[0].rowsReturned, 5);
+
+    self.database->removeAllWarmUpQueries();
+    self.database->prewarm({ 5 });
+    [NSThread sleepForTimeInterval:1];
+    TestCaseAssertEqual(self.database->getStatementStatistics()[0].numberOfCalls, 1);
+
+    self.database->resetStatementStatistics();
+    self.database->enableStatementStatistics(false);
+}
+
 - (void)test_checkpoint
 {
     WCDB::MultiRowsValue rows = [Random.shared autoIncrementTestCaseValuesWithCount:100];
@@ -224,6 +398,78 @@
       isEqualTo:CPPMultiRowValueExtract([self getAllObjects])];
 }
 
+- (void)test_auto_vacuum_with_writes
+{
+    TestCaseAssertTrue([self createValueTable]);
+    TestCaseAssertTrue(self.database->insertRows([Random.shared autoIncrementTestCaseValuesWithCount:300000], self.columns, self.tableName.UTF8String));
+    NSString* writtenTable = [self.tableName stringByAppendingString:@"_written"];
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementCreateTable().createTable(writtenTable.UTF8String).define(WCDB::ColumnDef("content", WCDB::ColumnType::Text))));
+
+    int numberOfRestarts = 0;
+    WCDB::Database::globalTraceError([&](const WCDB::Error& error) {
+        if (strcmp(error.getPath().data(), self.path.UTF8String) == 0
+            && (error.getMessage().hasPrefix("Vacuum starts over")
+                || error.getMessage().hasPrefix("Vacuum is not resumable"))) {
+            ++numberOfRestarts;
+        }
+    });
+
+    NSString* vacuumDirectory = [self.factoryPath stringByAppendingPathComponent:@"vacuum"];
+    self.database->enableAutoVacuum(true);
+    int numberOfWrites = 0;
+    BOOL resumed = NO;
+    BOOL finished = NO;
+    NSDate* deadline = [NSDate dateWithTimeIntervalSinceNow:60];
+    while (!finished && [deadline timeIntervalSinceNow] > 0) {
+        // Write between the time slices of vacuum. The written table is copied again, while the others are resumed.
+        TestCaseAssertTrue(self.database->execute(WCDB::StatementInsert().insertIntoTable(writtenTable.UTF8String).column("content").value("written")));
+        ++numberOfWrites;
+        [NSThread sleepForTimeInterval:0.5];
+        BOOL exists = [self.fileManager fileExistsAtPath:vacuumDirectory];
+        resumed = resumed || exists;
+        finished = resumed && !exists;
+    }
+    WCDB::Database::globalTraceError(nullptr);
+    TestCaseAssertTrue(finished);
+    TestCaseAssertEqual(numberOfRestarts, 0);
+    WCDB::StatementSelect getCount = WCDB::StatementSelect().select(WCDB::Column::all().count()).from(self.tableName.UTF8String);
+    TestCaseAssertEqual(self.database->getValueFromStatement(getCount).valueOrDefault().intValue(), 300000);
+    getCount = WCDB::StatementSelect().select(WCDB::Column::all().count()).from(writtenTable.UTF8String);
+    TestCaseAssertEqual(self.database->getValueFromStatement(getCount).valueOrDefault().intValue(), numberOfWrites);
+}
+
+- (void)test_auto_vacuum_with_writes_to_copying_table
+{
+    TestCaseAssertTrue([self createValueTable]);
+    TestCaseAssertTrue(self.database->insertRows([Random.shared autoIncrementTestCaseValuesWithCount:300000], self.columns, self.tableName.UTF8String));
+
+    bool givenUp = false;
+    WCDB::Database::globalTraceError([&](const WCDB::Error& error) {
+        if (strcmp(error.getPath().data(), self.path.UTF8String) == 0
+            && error.getMessage().hasPrefix("Vacuum is not resumable")) {
+            givenUp = true;
+        }
+    });
+
+    NSString* vacuumDirectory = [self.factoryPath stringByAppendingPathComponent:@"vacuum"];
+    self.database->enableAutoVacuum(true);
+    int numberOfWrites = 0;
+    NSDate* deadline = [NSDate dateWithTimeIntervalSinceNow:60];
+    while (!givenUp && [deadline timeIntervalSinceNow] > 0) {
+        // The table being copied is modified between every two time slices, so the copy can't catch up with the writes.
+        TestCaseAssertTrue(self.database->insertRows([Random.shared autoIncrementTestCaseValuesWithCount:1], self.columns, self.tableName.UTF8String));
+        ++numberOfWrites;
+        [NSThread sleepForTimeInterval:0.5];
+    }
+    self.database->enableAutoVacuum(false);
+    WCDB::Database::globalTraceError(nullptr);
+    // It's given up instead of finishing the copy in one go, which blocks the writes.
+    TestCaseAssertTrue(givenUp);
+    TestCaseAssertFalse([self.fileManager fileExistsAtPath:vacuumDirectory]);
+    WCDB::StatementSelect getCount = WCDB::StatementSelect().select(WCDB::Column::all().count()).from(self.tableName.UTF8String);
+    TestCaseAssertEqual(self.database->getValueFromStatement(getCount).valueOrDefault().intValue(), 300000 + numberOfWrites);
+}
+
 - (void)test_migration
 {
     CPPTestCaseObject oldObject1 = CPPTestCaseObject(1, "a");
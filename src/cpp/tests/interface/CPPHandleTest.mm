@@ -200,4 +200,32 @@
     WCDB::Database::globalTraceDatabaseOperation(nullptr);
 }
 
+- (void)test_handle_wait_statistics
+{
+    for (int i = 0; i < 40; i++) {
+        [self.dispatch async:^{
+            WCDB::Database::setThreadedHandlePriority(i % 2 == 0 ? WCDB::Database::HandlePriority::Background : WCDB::Database::HandlePriority::Normal);
+            WCDB::Handle handle = self.database->getHandle();
+            TestCaseAssertTrue(handle.execute(WCDB::StatementPragma().pragma(WCDB::Pragma::userVersion())));
+            usleep(100000);
+            handle.invalidate();
+        }];
+    }
+    [self.dispatch waitUntilDone];
+
+    auto statistics = self.database->getHandleWaitStatistics();
+    int64_t waitCount = 0;
+    for (const auto &iter : statistics) {
+        int64_t histogramCount = 0;
+        for (int64_t count : iter.second.histogram) {
+            histogramCount += count;
+        }
+        TestCaseAssertEqual(histogramCount, iter.second.count);
+        TestCaseAssertTrue(iter.second.maxWaitTime <= iter.second.totalWaitTime);
+        waitCount += iter.second.count;
+    }
+    TestCaseAssertTrue(waitCount > 0);
+    TestCaseAssertEqual(statistics[WCDB::Database::HandlePriority::Interactive].count, 0);
+}
+
 @end
@@ -222,6 +222,46 @@
     WCDB::Database::globalTracePerformance(nil);
 }
 
+- (void)test_global_trace_performance_in_batch
+{
+    std::vector<CPPTestCaseObject> objects;
+    for (int i = 0; i < 100; i++) {
+        objects.emplace_back(0, [Random.shared stringWithLength:100].UTF8String);
+        objects.back().isAutoIncrement = true;
+    }
+    std::atomic<int> numberOfSelects(0);
+    std::atomic<uint64_t> numberOfDropped(0);
+    WCDB::StringView path = self.database->getPath();
+    long tag = self.database->getTag();
+    WCDB::StringView tableName(self.tableName.UTF8String);
+    WCDB::Database::globalTracePerformanceInBatch([&, path, tag, tableName](const std::vector<WCDB::Database::PerformanceTrace> &traces, uint64_t dropped) {
+        numberOfDropped += dropped;
+        for (const auto &trace : traces) {
+            if (!trace.path.equal(path)) {
+                continue;
+            }
+            XCTAssertEqual(trace.tag, tag);
+            XCTAssertTrue(trace.info.costInNanoseconds > 0);
+            if (trace.sql.hasPrefix("SELECT") && trace.sql.contain(tableName)) {
+                XCTAssertTrue(trace.info.tablePageReadCount > 0);
+                XCTAssertTrue(trace.info.tablePageWriteCount == 0);
+                numberOfSelects++;
+            }
+        }
+    });
+    TestCaseAssertTrue([self createObjectTable]);
+    TestCaseAssertTrue(self.table.insertObjects(objects));
+    for (int i = 0; i < 10; i++) {
+        TestCaseAssertTrue(self.table.getAllObjects().value().size() == objects.size());
+    }
+    for (int i = 0; i < 50 && numberOfSelects < 10; i++) {
+        [NSThread sleepForTimeInterval:0.1];
+    }
+    TestCaseAssertTrue(numberOfSelects >= 10);
+    TestCaseAssertTrue(numberOfDropped == 0);
+    WCDB::Database::globalTracePerformanceInBatch(nullptr);
+}
+
 - (void)test_trace_db_operation
 {
     long tag = 0;
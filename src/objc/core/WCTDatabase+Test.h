@@ -87,6 +87,27 @@ WCDB_API @interface WCTDatabase(Test)
  */
 - (void)unblockade;
 
+// Only for test. Number of the decrypted pages in the process-wide cache shared by backup and integrity check.
++ (NSUInteger)numberOfPagesInSharedRepairPageCache;
+
+// Only for test. Number of pages read from the process-wide cache instead of being decrypted again.
++ (uint64_t)numberOfHitsInSharedRepairPageCache;
+
+// Only for test. Number of the database files remembered by the process-wide cache.
++ (NSUInteger)numberOfFilesInSharedRepairPageCache;
+
+// Only for test. Least recently used pages are purged immediately when the cache exceeds the new size.
++ (void)setSharedRepairPageCacheSize:(NSUInteger)size;
+
+// Only for test. Rows are bulk inserted into fts5 tables without pretokenizing if it's 0.
++ (void)setMaxNumberOfFTS5BulkIndexWorkers:(int)number;
+
+// Only for test. Record the pages written by checkpoint, and run a full check after the interval passes since the last one.
+- (void)enableIncrementalIntegrityCheck:(BOOL)flag fullCheckInterval:(double)interval;
+
+// Only for test. Check the recorded pages right now instead of waiting for the operation queue.
+- (void)checkIntegrityIncrementally;
+
 @end
 
 NS_ASSUME_NONNULL_END
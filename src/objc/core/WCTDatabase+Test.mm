@@ -24,8 +24,10 @@
 
 #import "Core.hpp"
 #import "CoreConst.h"
+#import "FTS5BulkIndexer.hpp"
 #import "FileHandle.hpp"
 #import "Notifier.hpp"
+#import "PageCache.hpp"
 #import "SQLite.h"
 #import "WCTConvertible.h"
 #import "WCTDatabase+Convenient.h"
@@ -117,4 +119,40 @@ static std::nullptr_t initialize()
     _database->unblockade();
 }
 
++ (NSUInteger)numberOfPagesInSharedRepairPageCache
+{
+    return WCDB::Repair::PageCache::shared().getStatistics().numberOfPages;
+}
+
++ (uint64_t)numberOfHitsInSharedRepairPageCache
+{
+    return WCDB::Repair::PageCache::shared().getStatistics().hits;
+}
+
++ (NSUInteger)numberOfFilesInSharedRepairPageCache
+{
+    return WCDB::Repair::PageCache::shared().getStatistics().numberOfFiles;
+}
+
++ (void)setSharedRepairPageCacheSize:(NSUInteger)size
+{
+    WCDB::Repair::PageCache::shared().setMaxAllowedMemory(size);
+}
+
++ (void)setMaxNumberOfFTS5BulkIndexWorkers:(int)number
+{
+    WCDB::FTS5BulkIndexer::setMaxNumberOfWorkers(number);
+}
+
+- (void)enableIncrementalIntegrityCheck:(BOOL)flag fullCheckInterval:(double)interval
+{
+    _database->setFullIntegrityCheckInterval(interval);
+    WCDB::Core::shared().enableAutoIncrementalIntegrityCheck(_database, flag);
+}
+
+- (void)checkIntegrityIncrementally
+{
+    _database->checkIntegrityIncrementally(false);
+}
+
 @end
@@ -112,6 +112,24 @@ WCDB_API @interface WCTDatabase(Config)
  */
 - (void)removeConfigForName:(NSString*)name;
 
+/**
+ @brief Enable memory-mapped I/O for the reading of current database.
+ The `mmap_size` of each sqlite db handle is twice the database file size rounded up to the power of 2, ranged from 32MB to 1GB and limited by the available address space.
+ It follows the growth of the database file, which is re-evaluated after each checkpoint.
+ @note  It doesn't take effect on the encrypted databases or the 32-bit platforms.
+ @param flag to enable adaptive mmap. It's disabled by default.
+ */
+- (void)enableAdaptiveMMap:(BOOL)flag;
+
+/**
+ @brief Enable single writer mode for current database.
+ All the writes of current database are done by one long-lived sqlite db handle in turn, while the reads still use the other handles concurrently.
+ The writing threads wait for the writer handle in the order of their priorities, instead of busy retrying on the write lock of sqlite.
+ @note  A thread that already holds a handle for reading writes with that handle, which still competes with the writer handle.
+ @param flag to enable single writer mode. It's disabled by default, which allows up to 4 handles to write at the same time.
+ */
+- (void)enableSingleWriter:(BOOL)flag;
+
 /**
  @brief Register custom scalar function.
  @Note  The custom scalar function needs to inherit `WCDB::AbstractScalarFunctionObject`.
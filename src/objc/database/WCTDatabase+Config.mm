@@ -95,6 +95,16 @@ static_assert((int) WCTConfigPriorityLow == (int) WCDB::Configs::Priority::Low,
     _database->removeConfig(name);
 }
 
+- (void)enableAdaptiveMMap:(BOOL)flag
+{
+    _database->setAdaptiveMMapEnable(flag);
+}
+
+- (void)enableSingleWriter:(BOOL)flag
+{
+    _database->setSingleWriterEnable(flag);
+}
+
 + (void)registerScalarFunction:(const WCDB::ScalarFunctionModule&)module named:(NSString*)name
 {
     WCDB::Core::shared().registerScalarFunction(name, module);
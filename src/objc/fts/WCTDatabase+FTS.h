@@ -64,14 +64,16 @@ WCDB_EXTERN NSString* const WCTTokenizerVerbatim;
 WCDB_EXTERN NSString* const WCTTokenizerPinyin;
 
 /**
- The following three are optional parameters for WCDB implemented tokenizers. You can use `WCDB_VIRTUAL_TABLE_TOKENIZE_WITH_PARAMETERS` to config fts tokenizer with parameters for a `WCTTableCoding` class.
+ The following four are optional parameters for WCDB implemented tokenizers. You can use `WCDB_VIRTUAL_TABLE_TOKENIZE_WITH_PARAMETERS` to config fts tokenizer with parameters for a `WCTTableCoding` class.
  Configuring `WCTTokenizerParameter_NeedSymbol` allows the tokenizer to recognize each symbol character as a token.
  Configuring `WCTTokenizerParameter_SimplifyChinese` enables the tokenizer to convert each traditional Chinese character into a simplified Chinese character, so that you can use Simplified Chinese characters to search Traditional Chinese characters. Note that you need to use `+[WCTDatabase configTraditionalChineseDict:]` to configure the mapping relationship between traditional Chinese characters and simplified Chinese characters before using the tokenizer.
  Configuring `WCTTokenizerParameter_SkipStemming` will disable the stemming during tokenization.
+ Configuring `WCTTokenizerParameter_PinyinPrefix` makes `WCTTokenizerPinyin` index every prefix of the full pinyins, so that the pinyin being typed can be searched as a term instead of a prefix query.
  */
 WCDB_EXTERN NSString* const WCTTokenizerParameter_NeedSymbol;
 WCDB_EXTERN NSString* const WCTTokenizerParameter_SimplifyChinese;
 WCDB_EXTERN NSString* const WCTTokenizerParameter_SkipStemming;
+WCDB_EXTERN NSString* const WCTTokenizerParameter_PinyinPrefix;
 
 /**
  `WCTAuxiliaryFunction_SubstringMatchInfo` is a WCDB implemented auxiliary function for fts5.
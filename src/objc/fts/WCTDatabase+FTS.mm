@@ -39,6 +39,7 @@ NSString* const WCTTokenizerPinyin = [NSString stringWithUTF8String:WCDB::Builti
 NSString* const WCTTokenizerParameter_NeedSymbol = [NSString stringWithUTF8String:WCDB::BuiltinTokenizer::Parameter::NeedSymbol];
 NSString* const WCTTokenizerParameter_SimplifyChinese = [NSString stringWithUTF8String:WCDB::BuiltinTokenizer::Parameter::SimplifyChinese];
 NSString* const WCTTokenizerParameter_SkipStemming = [NSString stringWithUTF8String:WCDB::BuiltinTokenizer::Parameter::SkipStemming];
+NSString* const WCTTokenizerParameter_PinyinPrefix = [NSString stringWithUTF8String:WCDB::BuiltinTokenizer::Parameter::PinyinPrefix];
 
 NSString* const WCTModuleFTS3 = [NSString stringWithUTF8String:WCDB::Module::FTS3];
 NSString* const WCTModuleFTS4 = [NSString stringWithUTF8String:WCDB::Module::FTS4];
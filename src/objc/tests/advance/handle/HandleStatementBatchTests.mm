@@ -0,0 +1,252 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "CoreBridge.h"
+#import "DatabaseBridge.h"
+#import "HandleBridge.h"
+#import "HandleStatementBridge.h"
+#import "ObjectBridge.h"
+#import "TestCase.h"
+#include <vector>
+
+class TestColumnarBuffer {
+public:
+    TestColumnarBuffer(int columnCount, int rowCapacity, size_t arenaCapacity)
+    : m_types(columnCount * rowCapacity)
+    , m_integers(columnCount * rowCapacity)
+    , m_doubles(columnCount * rowCapacity)
+    , m_offsets(columnCount * rowCapacity)
+    , m_lengths(columnCount * rowCapacity)
+    , m_arena(arenaCapacity)
+    {
+        memset(&raw, 0, sizeof(raw));
+        raw.columnCount = columnCount;
+        raw.rowCapacity = rowCapacity;
+        raw.types = m_types.data();
+        raw.integers = m_integers.data();
+        raw.doubles = m_doubles.data();
+        raw.offsets = m_offsets.data();
+        raw.lengths = m_lengths.data();
+        raw.arena = arenaCapacity > 0 ? m_arena.data() : nullptr;
+        raw.arenaCapacity = arenaCapacity;
+    }
+
+    int cell(int row, int column) const
+    {
+        return column * raw.rowCapacity + row;
+    }
+
+    NSString* text(int row, int column) const
+    {
+        int index = cell(row, column);
+        return [[NSString alloc] initWithBytes:raw.arena + raw.offsets[index]
+                                        length:(NSUInteger) raw.lengths[index]
+                                      encoding:NSUTF8StringEncoding];
+    }
+
+    void setInteger(long long value, int row, int column)
+    {
+        int index = cell(row, column);
+        raw.types[index] = WCDBColumnValueTypeInterger;
+        raw.integers[index] = value;
+    }
+
+    void setText(const char* value, int row, int column)
+    {
+        int index = cell(row, column);
+        size_t length = strlen(value);
+        memcpy(raw.arena + raw.arenaUsed, value, length);
+        raw.types[index] = WCDBColumnValueTypeString;
+        raw.offsets[index] = raw.arenaUsed;
+        raw.lengths[index] = length;
+        raw.arenaUsed += length;
+    }
+
+    CPPColumnarBuffer raw;
+
+private:
+    std::vector<WCDBColumnValueType> m_types;
+    std::vector<signed long long> m_integers;
+    std::vector<double> m_doubles;
+    std::vector<unsigned long long> m_offsets;
+    std::vector<unsigned long long> m_lengths;
+    std::vector<unsigned char> m_arena;
+};
+
+@interface HandleStatementBatchTests : DatabaseTestCase
+
+@end
+
+@implementation HandleStatementBatchTests {
+    CPPDatabase _cppDatabase;
+    CPPHandle _cppHandle;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    _cppDatabase = WCDBCoreCreateDatabase(self.path.UTF8String);
+    _cppHandle = WCDBDatabaseGetHandle(_cppDatabase, true);
+    TestCaseAssertTrue(WCDBHandleCheckValid(_cppHandle));
+    TestCaseAssertTrue(WCDBHandleExecuteSQL(_cppHandle, "CREATE TABLE source(id INTEGER PRIMARY KEY, content TEXT)"));
+    TestCaseAssertTrue(WCDBHandleExecuteSQL(_cppHandle, "CREATE TABLE destination(id INTEGER PRIMARY KEY, content TEXT)"));
+    // Each content is 10 bytes.
+    for (int i = 1; i <= 5; ++i) {
+        NSString* sql = [NSString stringWithFormat:@"INSERT INTO source VALUES(%d, 'content-0%d')", i, i];
+        TestCaseAssertTrue(WCDBHandleExecuteSQL(_cppHandle, sql.UTF8String));
+    }
+}
+
+- (void)tearDown
+{
+    WCDBHandleStatementFinalize(self.statement);
+    WCDBReleaseCPPObject(_cppHandle.innerValue);
+    WCDBReleaseCPPObject(_cppDatabase.innerValue);
+    [self.database close];
+    [super tearDown];
+}
+
+- (CPPHandleStatement)statement
+{
+    return WCDBHandleGetMainStatement(_cppHandle);
+}
+
+- (void)checkRow:(int)row ofBuffer:(const TestColumnarBuffer&)buffer withIdentifier:(int)identifier
+{
+    TestCaseAssertEqual(buffer.raw.types[buffer.cell(row, 0)], WCDBColumnValueTypeInterger);
+    TestCaseAssertEqual(buffer.raw.integers[buffer.cell(row, 0)], identifier);
+    TestCaseAssertEqual(buffer.raw.types[buffer.cell(row, 1)], WCDBColumnValueTypeString);
+    TestCaseAssertStringEqual(buffer.text(row, 1), ([NSString stringWithFormat:@"content-0%d", identifier]));
+}
+
+- (long long)selectInteger:(const char*)sql
+{
+    WCDBHandleStatementFinalize(self.statement);
+    TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(self.statement, sql));
+    TestCaseAssertTrue(WCDBHandleStatementStep(self.statement));
+    long long value = WCDBHandleStatementGetInteger(self.statement, 0);
+    WCDBHandleStatementFinalize(self.statement);
+    return value;
+}
+
+#pragma mark - Step
+- (void)test_step_partial_batch
+{
+    TestColumnarBuffer buffer(2, 4, 1024);
+    TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(self.statement, "SELECT id, content FROM source ORDER BY id"));
+
+    TestCaseAssertTrue(WCDBHandleStatementStepBatch(self.statement, &buffer.raw));
+    TestCaseAssertEqual(buffer.raw.rowCount, 4);
+    TestCaseAssertFalse(buffer.raw.done);
+    for (int row = 0; row < 4; ++row) {
+        [self checkRow:row ofBuffer:buffer withIdentifier:row + 1];
+    }
+
+    // The last batch is partial.
+    TestCaseAssertTrue(WCDBHandleStatementStepBatch(self.statement, &buffer.raw));
+    TestCaseAssertEqual(buffer.raw.rowCount, 1);
+    TestCaseAssertTrue(buffer.raw.done);
+    [self checkRow:0 ofBuffer:buffer withIdentifier:5];
+
+    TestCaseAssertTrue(WCDBHandleStatementStepBatch(self.statement, &buffer.raw));
+    TestCaseAssertEqual(buffer.raw.rowCount, 0);
+    TestCaseAssertTrue(buffer.raw.done);
+}
+
+- (void)test_step_error_in_batch
+{
+    TestColumnarBuffer buffer(2, 4, 1024);
+    // The integer overflow fails the third row.
+    TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(self.statement, "SELECT id, CASE WHEN id == 3 THEN abs(-9223372036854775807 - 1) ELSE content END FROM source ORDER BY id"));
+
+    // The batch stops at the failed row, and the rows before it are kept.
+    TestCaseAssertFalse(WCDBHandleStatementStepBatch(self.statement, &buffer.raw));
+    TestCaseAssertEqual(buffer.raw.rowCount, 2);
+    TestCaseAssertFalse(buffer.raw.done);
+    [self checkRow:0 ofBuffer:buffer withIdentifier:1];
+    [self checkRow:1 ofBuffer:buffer withIdentifier:2];
+}
+
+- (void)test_step_mismatched_column_count
+{
+    TestColumnarBuffer buffer(3, 4, 1024);
+    TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(self.statement, "SELECT id, content FROM source ORDER BY id"));
+
+    TestCaseAssertFalse(WCDBHandleStatementStepBatch(self.statement, &buffer.raw));
+    TestCaseAssertEqual(buffer.raw.rowCount, 0);
+}
+
+#pragma mark - Bind And Step
+- (void)test_bind_and_step_partial_batch
+{
+    TestColumnarBuffer buffer(2, 4, 1024);
+    buffer.setInteger(6, 0, 0);
+    buffer.setText("content-06", 0, 1);
+    buffer.setInteger(7, 1, 0);
+    buffer.setText("content-07", 1, 1);
+    buffer.raw.rowCount = 2;
+
+    TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(self.statement, "INSERT INTO destination VALUES(?1, ?2)"));
+    TestCaseAssertEqual(WCDBHandleStatementBindAndStepBatch(self.statement, &buffer.raw), 2);
+    TestCaseAssertEqual([self selectInteger:"SELECT count(*) FROM destination WHERE content == 'content-0' || id"], 2);
+}
+
+- (void)test_bind_and_step_error_in_batch
+{
+    TestColumnarBuffer buffer(2, 3, 1024);
+    buffer.setInteger(6, 0, 0);
+    buffer.setText("content-06", 0, 1);
+    // Conflicts with an existing row.
+    buffer.setInteger(1, 1, 0);
+    buffer.setText("content-01", 1, 1);
+    buffer.setInteger(7, 2, 0);
+    buffer.setText("content-07", 2, 1);
+    buffer.raw.rowCount = 3;
+
+    // The index of the failed row is returned, and the rows after it are not stepped.
+    TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(self.statement, "INSERT INTO source VALUES(?1, ?2)"));
+    TestCaseAssertEqual(WCDBHandleStatementBindAndStepBatch(self.statement, &buffer.raw), 1);
+    TestCaseAssertEqual([self selectInteger:"SELECT max(id) FROM source"], 6);
+}
+
+- (void)test_bind_and_step_mismatched_bind_count
+{
+    TestColumnarBuffer fewer(1, 2, 0);
+    fewer.setInteger(6, 0, 0);
+    fewer.setInteger(7, 1, 0);
+    fewer.raw.rowCount = 2;
+    TestCaseAssertTrue(WCDBHandleStatementPrepareSQL(self.statement, "INSERT INTO destination VALUES(?1, ?2)"));
+    TestCaseAssertEqual(WCDBHandleStatementBindAndStepBatch(self.statement, &fewer.raw), 0);
+
+    TestColumnarBuffer more(3, 1, 1024);
+    more.setInteger(6, 0, 0);
+    more.setText("content-06", 0, 1);
+    more.setInteger(0, 0, 2);
+    more.raw.rowCount = 1;
+    TestCaseAssertEqual(WCDBHandleStatementBindAndStepBatch(self.statement, &more.raw), 0);
+
+    TestCaseAssertEqual([self selectInteger:"SELECT count(*) FROM destination"], 0);
+}
+
+@end
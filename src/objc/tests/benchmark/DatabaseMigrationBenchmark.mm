@@ -55,4 +55,9 @@
     [self doTestMigrate];
 }
 
+- (void)test_read_during_migration
+{
+    [self doTestReadDuringMigration];
+}
+
 @end
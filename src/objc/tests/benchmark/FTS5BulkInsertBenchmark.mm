@@ -0,0 +1,120 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "CoreConst.h"
+#import "TestCase.h"
+#import <Foundation/Foundation.h>
+#import <WCDB/WCDBCpp.h>
+
+static NSString* const FTS5BulkInsertBenchmarkTableName = @"testTable";
+
+@interface FTS5BulkInsertBenchmark : Benchmark
+
+@end
+
+@implementation FTS5BulkInsertBenchmark {
+    WCDB::MultiRowsValue m_rows;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    [self.database addTokenizer:WCTTokenizerVerbatim];
+    m_rows.clear();
+    for (int i = 0; i < 10000; i++) {
+        m_rows.push_back({ WCDB::Value([Random.shared chineseStringWithLength:100].UTF8String) });
+    }
+}
+
+- (void)tearDown
+{
+    [WCTDatabase setMaxNumberOfFTS5BulkIndexWorkers:WCDB::FTSBulkIndexMaxNumberOfWorkers];
+    [super tearDown];
+}
+
+- (void)setUpDatabase
+{
+    TestCaseAssertTrue([self.database removeFiles]);
+    TestCaseAssertTrue([self.database execute:WCDB::StatementCreateVirtualTable()
+                                              .createVirtualTable(FTS5BulkInsertBenchmarkTableName)
+                                              .usingModule("fts5")
+                                              .argument("content")
+                                              .argument(WCDB::StringView::formatted("tokenize = '%s'", WCTTokenizerVerbatim.UTF8String))]);
+}
+
+- (void)tearDownDatabase
+{
+    TestCaseAssertTrue([self.database removeFiles]);
+}
+
+- (void)doTestBulkInsertWithWorkers:(int)numberOfWorkers
+{
+    [WCTDatabase setMaxNumberOfFTS5BulkIndexWorkers:numberOfWorkers];
+    std::shared_ptr<WCDB::Database> database = std::make_shared<WCDB::Database>(self.path.UTF8String);
+    __block BOOL result = NO;
+    [self
+    doMeasure:^{
+        result = database->bulkInsertFTS5Rows(m_rows, { WCDB::Column("content") }, FTS5BulkInsertBenchmarkTableName.UTF8String);
+    }
+    setUp:^{
+        [self setUpDatabase];
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+        result = NO;
+    }
+    checkCorrectness:^{
+        TestCaseAssertTrue(result);
+        WCTValue* count = [self.database getValueFromStatement:WCDB::StatementSelect().select(WCDB::Column::all().count()).from(FTS5BulkInsertBenchmarkTableName)];
+        TestCaseAssertEqual(count.numberValue.intValue, 10000);
+    }];
+}
+
+// The rows are tokenized by the writer itself.
+- (void)test_bulk_insert_without_workers
+{
+    [self doTestBulkInsertWithWorkers:0];
+}
+
+- (void)test_bulk_insert_with_1_worker
+{
+    [self doTestBulkInsertWithWorkers:1];
+}
+
+- (void)test_bulk_insert_with_2_workers
+{
+    [self doTestBulkInsertWithWorkers:2];
+}
+
+- (void)test_bulk_insert_with_4_workers
+{
+    [self doTestBulkInsertWithWorkers:4];
+}
+
+- (void)test_bulk_insert_with_8_workers
+{
+    [self doTestBulkInsertWithWorkers:8];
+}
+
+@end
@@ -0,0 +1,107 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "TestCase.h"
+#import <Foundation/Foundation.h>
+
+static NSString* const FTS5SearchBenchmarkTableName = @"testTable";
+
+@interface FTS5SearchBenchmark : Benchmark
+
+@end
+
+@implementation FTS5SearchBenchmark
+
+- (void)setUp
+{
+    [super setUp];
+    [self.database addTokenizer:WCTTokenizerVerbatim];
+    [self.database addAuxiliaryFunction:WCTAuxiliaryFunction_SubstringMatchInfo];
+}
+
+- (void)setUpDatabase
+{
+    TestCaseAssertTrue([self.database removeFiles]);
+    TestCaseAssertTrue([self.database execute:WCDB::StatementCreateVirtualTable()
+                                              .createVirtualTable(FTS5SearchBenchmarkTableName)
+                                              .usingModule("fts5")
+                                              .argument("content")
+                                              .argument(WCDB::StringView::formatted("tokenize = '%s %s'", WCTTokenizerVerbatim.UTF8String, WCTTokenizerParameter_NeedSymbol.UTF8String))]);
+    NSArray<NSString*>* keywords = @[ @"多级", @"分隔符", @"串联", @"子串", @"WCDB", @"database" ];
+    TestCaseAssertTrue([self.database runTransaction:^BOOL(WCTHandle* handle) {
+        for (int i = 0; i < 10000; i++) {
+            NSMutableString* content = [NSMutableString string];
+            for (int j = 0; j < 16; j++) {
+                [content appendString:keywords[arc4random_uniform((uint32_t) keywords.count)]];
+                [content appendString:j % 4 == 3 ? @";" : @","];
+            }
+            if (![handle execute:WCDB::StatementInsert().insertIntoTable(FTS5SearchBenchmarkTableName).column(WCDB::Column("content")).value(content)]) {
+                return NO;
+            }
+        }
+        return YES;
+    }]);
+}
+
+- (void)tearDownDatabase
+{
+    TestCaseAssertTrue([self.database removeFiles]);
+}
+
+- (void)doTestSearch:(NSString*)keyword
+{
+    // A search result page of 500 hits, each of which is highlighted.
+    WCDB::StatementSelect select = WCDB::StatementSelect()
+                                   .select(WCDB::FTSFunction::substringMatchInfo(WCDB::Column(FTS5SearchBenchmarkTableName), 0, ";,"))
+                                   .from(FTS5SearchBenchmarkTableName)
+                                   .where(WCDB::Column("content").match(keyword))
+                                   .limit(500);
+    __block WCTOneColumn* results;
+    [self
+    doMeasure:^{
+        results = [self.database getColumnFromStatement:select];
+    }
+    setUp:^{
+        [self setUpDatabase];
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+        results = nil;
+    }
+    checkCorrectness:^{
+        TestCaseAssertEqual(results.count, 500);
+    }];
+}
+
+- (void)test_search_and_highlight
+{
+    [self doTestSearch:@"子串"];
+}
+
+- (void)test_search_and_highlight_phrases
+{
+    [self doTestSearch:@"串联 AND WCDB"];
+}
+
+@end
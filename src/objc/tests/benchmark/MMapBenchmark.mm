@@ -0,0 +1,55 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "ObjectsBasedBenchmark.h"
+
+// Compare with the same tests in BaselineBenchmark, which reads without mmap.
+@interface MMapBenchmark : ObjectsBasedBenchmark
+
+@end
+
+@implementation MMapBenchmark
+
+- (void)setUpDatabase
+{
+    [super setUpDatabase];
+    [self.database enableAdaptiveMMap:YES];
+}
+
+- (void)test_read
+{
+    [self doTestRead];
+}
+
+- (void)test_batch_read
+{
+    [self doTestBatchRead];
+}
+
+- (void)test_random_read
+{
+    [self doTestRandomRead];
+}
+
+@end
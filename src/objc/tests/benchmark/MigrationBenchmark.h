@@ -28,6 +28,8 @@
 
 - (void)doTestMigrate;
 
+- (void)doTestReadDuringMigration;
+
 @property (nonatomic, assign) BOOL isCrossDatabase;
 
 @end
@@ -116,4 +116,34 @@
     }];
 }
 
+- (void)doTestReadDuringMigration
+{
+    __block NSMutableArray<TestCaseObject*>* result;
+    __block BOOL stop;
+    [self
+    doMeasure:^{
+        [self.dispatch async:^{
+            while (!stop && [self.database stepMigration] && ![self.database isMigrated])
+                ;
+        }];
+        for (int i = 1; i <= self.testQuality; i++) {
+            TestCaseObject* obj = [self.database getObjectOfClass:TestCaseObject.class fromTable:self.tableName where:TestCaseObject.identifier == i];
+            [result addObject:obj];
+        }
+        stop = YES;
+        [self.dispatch waitUntilDone];
+    }
+    setUp:^{
+        [self setUpDatabase];
+        stop = NO;
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+        result = [NSMutableArray new];
+    }
+    checkCorrectness:^{
+        TestCaseAssertEqual(result.count, self.testQuality);
+    }];
+}
+
 @end
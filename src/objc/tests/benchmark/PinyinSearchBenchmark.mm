@@ -0,0 +1,177 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "TestCase.h"
+#import <Foundation/Foundation.h>
+#import <WCDB/WCDBCpp.h>
+
+static NSString* const PinyinSearchBenchmarkTableName = @"testTable";
+static NSString* const PinyinSearchBenchmarkPrefixTableName = @"prefixTable";
+static const int PinyinSearchBenchmarkNumberOfNames = 1000000;
+// The target latency of a single type-ahead search.
+static const double PinyinSearchBenchmarkTargetCost = 0.01;
+
+@interface PinyinSearchBenchmark : Benchmark
+
+@end
+
+@implementation PinyinSearchBenchmark
+
++ (NSDictionary<NSString*, NSArray<NSString*>*>*)pinyinDict
+{
+    return @{
+        @"张" : @[ @"zhang" ],
+        @"章" : @[ @"zhang" ],
+        @"赵" : @[ @"zhao" ],
+        @"周" : @[ @"zhou" ],
+        @"陈" : @[ @"chen" ],
+        @"程" : @[ @"cheng" ],
+        @"沈" : @[ @"shen" ],
+        @"单" : @[ @"shan", @"dan", @"chan" ],
+        @"山" : @[ @"shan" ],
+        @"上" : @[ @"shang" ],
+        @"少" : @[ @"shao" ],
+        @"李" : @[ @"li" ],
+        @"林" : @[ @"lin" ],
+        @"刘" : @[ @"liu" ],
+        @"王" : @[ @"wang" ],
+        @"伟" : @[ @"wei" ],
+        @"文" : @[ @"wen" ],
+        @"西" : @[ @"xi" ],
+        @"安" : @[ @"an" ],
+        @"先" : @[ @"xian" ],
+        @"祥" : @[ @"xiang" ],
+        @"晓" : @[ @"xiao" ],
+        @"新" : @[ @"xin" ],
+        @"杨" : @[ @"yang" ],
+    };
+}
+
+- (void)setUp
+{
+    [super setUp];
+    NSDictionary<NSString*, NSArray<NSString*>*>* pinyinDict = [self.class pinyinDict];
+    [WCTDatabase configPinYinDict:pinyinDict];
+    [self.database addTokenizer:WCTTokenizerPinyin];
+    TestCaseAssertTrue([self.database removeFiles]);
+
+    // 2-3 character names, which are searched while the user is typing.
+    NSArray<NSString*>* characters = pinyinDict.allKeys;
+    NSMutableArray<NSString*>* names = [NSMutableArray array];
+    for (int i = 0; i < PinyinSearchBenchmarkNumberOfNames; i++) {
+        NSMutableString* name = [NSMutableString string];
+        int length = 2 + (int) arc4random_uniform(2);
+        for (int j = 0; j < length; j++) {
+            [name appendString:characters[arc4random_uniform((uint32_t) characters.count)]];
+        }
+        [names addObject:name];
+    }
+    for (NSString* table in @[ PinyinSearchBenchmarkTableName, PinyinSearchBenchmarkPrefixTableName ]) {
+        WCDB::StringView tokenize;
+        if ([table isEqualToString:PinyinSearchBenchmarkPrefixTableName]) {
+            tokenize = WCDB::StringView::formatted("tokenize = '%s %s'", WCTTokenizerPinyin.UTF8String, WCTTokenizerParameter_PinyinPrefix.UTF8String);
+        } else {
+            tokenize = WCDB::StringView::formatted("tokenize = '%s'", WCTTokenizerPinyin.UTF8String);
+        }
+        TestCaseAssertTrue([self.database execute:WCDB::StatementCreateVirtualTable()
+                                                  .createVirtualTable(table)
+                                                  .usingModule("fts5")
+                                                  .argument("content")
+                                                  .argument(tokenize)]);
+        TestCaseAssertTrue([self.database runTransaction:^BOOL(WCTHandle* handle) {
+            if (![handle prepare:WCDB::StatementInsert().insertIntoTable(table).column(WCDB::Column("content")).value(WCDB::BindParameter(1))]) {
+                return NO;
+            }
+            for (NSString* name in names) {
+                [handle reset];
+                [handle bindString:name toIndex:1];
+                if (![handle step]) {
+                    [handle finalizeStatement];
+                    return NO;
+                }
+            }
+            [handle finalizeStatement];
+            return YES;
+        }]);
+    }
+}
+
+- (void)tearDown
+{
+    TestCaseAssertTrue([self.database removeFiles]);
+    [super tearDown];
+}
+
+- (void)doTestSearch:(NSString*)table prefixIndexed:(BOOL)prefixIndexed checkTarget:(BOOL)checkTarget
+{
+    // Each input is searched letter by letter as it's being typed.
+    NSArray<NSString*>* inputs = @[ @"zhangshan", @"xian", @"chenxiao", @"liwei", @"wangxiang", @"zsx", @"shanglin" ];
+    std::vector<WCDB::StatementSelect> selects;
+    for (NSString* input in inputs) {
+        for (NSUInteger length = 1; length <= input.length; length++) {
+            WCDB::StringView pattern = WCDB::FTSTokenizerUtil::pinyinMatchPattern([input substringToIndex:length].UTF8String, prefixIndexed);
+            // The first page of the results.
+            selects.push_back(WCDB::StatementSelect()
+                              .select(WCDB::Column("content"))
+                              .from(table)
+                              .where(WCDB::Column(table).match(pattern))
+                              .limit(20));
+        }
+    }
+    __block NSUInteger numberOfResults = 0;
+    __block double maxCost = 0;
+    [self
+    doMeasure:^{
+        for (const WCDB::StatementSelect& select : selects) {
+            CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+            numberOfResults += [self.database getColumnFromStatement:select].count;
+            maxCost = std::max(maxCost, CFAbsoluteTimeGetCurrent() - start);
+        }
+    }
+    setUp:^{
+        numberOfResults = 0;
+        maxCost = 0;
+    }
+    tearDown:nil
+    checkCorrectness:^{
+        TestCaseAssertTrue(numberOfResults > 0);
+        [self log:@"%lu results of %lu searches, the slowest one costs %.3f ms with the target of %.3f ms", (unsigned long) numberOfResults, selects.size(), maxCost * 1000, PinyinSearchBenchmarkTargetCost * 1000];
+        if (checkTarget) {
+            TestCaseAssertTrue(maxCost <= PinyinSearchBenchmarkTargetCost);
+        }
+    }];
+}
+
+- (void)test_search_by_prefix_query
+{
+    // It's the baseline to compare with, which is not expected to meet the target.
+    [self doTestSearch:PinyinSearchBenchmarkTableName prefixIndexed:NO checkTarget:NO];
+}
+
+- (void)test_search_by_prefix_term
+{
+    [self doTestSearch:PinyinSearchBenchmarkPrefixTableName prefixIndexed:YES checkTarget:YES];
+}
+
+@end
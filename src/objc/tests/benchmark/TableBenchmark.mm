@@ -122,6 +122,39 @@
     }];
 }
 
+- (void)test_exists_missing
+{
+    int numberOfTables = 10000;
+    __block NSArray<NSString*>* tableNames = nil;
+    __block BOOL result;
+    [self
+    doMeasure:^{
+        result = YES;
+        for (NSString* tableName in tableNames) {
+            if ([self.database tableExists:tableName]) {
+                result = NO;
+                break;
+            }
+        }
+    }
+    setUp:^{
+        [self setUpDatabase];
+        // Nobody observes the ignorable errors so that the cheap path is measured.
+        [WCTDatabase globalTraceError:nil];
+
+        if (tableNames == nil) {
+            tableNames = [NSArray arrayWithArray:[Random.shared tableNamesWithCount:numberOfTables]];
+        }
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+        result = NO;
+    }
+    checkCorrectness:^{
+        TestCaseAssertTrue(result);
+    }];
+}
+
 - (void)test_create_tables
 {
     int numberOfTables = 100;
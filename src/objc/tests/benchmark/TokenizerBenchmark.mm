@@ -0,0 +1,119 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "TestCase.h"
+#import <Foundation/Foundation.h>
+#import <WCDB/FTSError.hpp>
+#import <WCDB/OneOrBinaryTokenizer.hpp>
+
+@interface TokenizerBenchmark : Benchmark
+
+@end
+
+@implementation TokenizerBenchmark
+
+- (CFAbsoluteTime)tokenize:(NSData*)data numberOfTokens:(int*)numberOfTokens
+{
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    WCDB::OneOrBinaryTokenizer tokenizer(nullptr, 0, nullptr);
+    tokenizer.loadInput((const char*) data.bytes, (int) data.length, 0);
+    const char* token = nullptr;
+    int tokenLength = 0;
+    int startOffset = 0;
+    int endOffset = 0;
+    while (WCDB::FTSError::isOK(tokenizer.nextToken(&token, &tokenLength, &startOffset, &endOffset, nullptr, nullptr))) {
+        (*numberOfTokens)++;
+    }
+    return CFAbsoluteTimeGetCurrent() - start;
+}
+
+- (void)doTestTokenize:(NSString*)text
+{
+    NSData* data = [text dataUsingEncoding:NSUTF8StringEncoding];
+    __block int numberOfTokens = 0;
+    __block CFAbsoluteTime cost = 0;
+    [self
+    doMeasure:^{
+        cost = [self tokenize:data numberOfTokens:&numberOfTokens];
+    }
+    setUp:^{
+        numberOfTokens = 0;
+    }
+    tearDown:nil
+    checkCorrectness:^{
+        TestCaseAssertTrue(numberOfTokens > 0);
+        [self log:@"%.2f MB/s", data.length / cost / 1024 / 1024];
+    }];
+}
+
+// A single document of one script should be tokenized in linear time, whatever its length.
+- (void)doTestScaling:(NSString*)unit
+{
+    NSMutableArray<NSNumber*>* throughputs = [NSMutableArray array];
+    for (int megabytes = 1; megabytes <= 16; megabytes *= 2) {
+        NSMutableString* text = [NSMutableString string];
+        while ([text lengthOfBytesUsingEncoding:NSUTF8StringEncoding] < megabytes * 1024 * 1024) {
+            [text appendString:unit];
+        }
+        NSData* data = [text dataUsingEncoding:NSUTF8StringEncoding];
+        int numberOfTokens = 0;
+        CFAbsoluteTime cost = [self tokenize:data numberOfTokens:&numberOfTokens];
+        TestCaseAssertTrue(numberOfTokens > 0);
+        double throughput = data.length / cost / 1024 / 1024;
+        [self log:@"%d MB: %.2f MB/s", megabytes, throughput];
+        [throughputs addObject:@(throughput)];
+    }
+    // Quadratic tokenization slows down by 16 times from the first document to the last one.
+    TestCaseAssertTrue(throughputs.lastObject.doubleValue > throughputs.firstObject.doubleValue / 4);
+}
+
+- (void)test_tokenize_english
+{
+    NSMutableString* text = [NSMutableString string];
+    while (text.length < 16 * 1024 * 1024) {
+        [text appendString:[Random.shared englishStringWithLength:1000]];
+    }
+    [self doTestTokenize:text];
+}
+
+- (void)test_tokenize_chinese
+{
+    NSMutableString* text = [NSMutableString string];
+    while (text.length < 8 * 1024 * 1024) {
+        [text appendString:[Random.shared chineseStringWithLength:1000]];
+    }
+    [self doTestTokenize:text];
+}
+
+- (void)test_tokenize_long_english_document
+{
+    [self doTestScaling:[Random.shared englishStringWithLength:1000]];
+}
+
+- (void)test_tokenize_long_chinese_document
+{
+    [self doTestScaling:[Random.shared chineseStringWithLength:1000]];
+}
+
+@end
@@ -0,0 +1,85 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "ObjectsBasedBenchmark.h"
+
+@interface WriterContentionBenchmark : ObjectsBasedBenchmark
+
+@end
+
+@implementation WriterContentionBenchmark
+
+- (void)setUp
+{
+    [super setUp];
+    self.testQuality = 16000;
+}
+
+- (void)doTestWriteWithThreads:(int)numberOfThreads
+{
+    int numberOfObjectsPerThread = self.testQuality / numberOfThreads;
+    NSArray* objects = [Random.shared testCaseObjectsWithCount:numberOfObjectsPerThread * numberOfThreads startingFromIdentifier:(int) self.factory.quality];
+    __block BOOL result;
+    [self
+    doMeasure:^{
+        for (int i = 0; i < numberOfThreads; ++i) {
+            NSArray* objectsOfThread = [objects subarrayWithRange:NSMakeRange(i * numberOfObjectsPerThread, numberOfObjectsPerThread)];
+            [self.dispatch async:^{
+                for (TestCaseObject* object in objectsOfThread) {
+                    if (![self.database insertObject:object intoTable:self.tableName]) {
+                        @synchronized(self) {
+                            result = NO;
+                        }
+                        return;
+                    }
+                }
+            }];
+        }
+        [self.dispatch waitUntilDone];
+    }
+    setUp:^{
+        [self setUpDatabase];
+        result = YES;
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+    }
+    checkCorrectness:^{
+        TestCaseAssertTrue(result);
+    }];
+}
+
+- (void)test_write_with_16_threads
+{
+    [self doTestWriteWithThreads:16];
+}
+
+- (void)test_write_with_16_threads_in_single_writer
+{
+    [self.database enableSingleWriter:YES];
+    [self doTestWriteWithThreads:16];
+    [self.database enableSingleWriter:NO];
+}
+
+@end
@@ -45,6 +45,11 @@
     return [self.path stringByAppendingString:@"-incremental.material"];
 }
 
+- (NSString *)integrityRecordPath
+{
+    return [self.path stringByAppendingString:@"-integrity.record"];
+}
+
 - (NSString *)firstMaterialPath
 {
     return [self.path stringByAppendingString:@"-first.material"];
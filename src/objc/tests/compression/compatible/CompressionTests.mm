@@ -548,4 +548,63 @@
     }];
 }
 
+- (void)test_migrated_rows_are_compressed_without_compression_step
+{
+    self.compressionStatus = CompressionStatus_uncompressed;
+    self.migrationStatus = MigrationStatus_unmigrated;
+    [self doTestCompress:^{
+        __block int updateCount = 0;
+        __block int insertCount = 0;
+        NSString* tableName = self.tableName;
+        [self.database traceSQL:^(WCTTag, NSString*, UInt64, NSString* sql, NSString*) {
+            @synchronized(self) {
+                if ([sql hasPrefix:@"UPDATE"] && [sql containsString:tableName]) {
+                    ++updateCount;
+                } else if ([sql hasPrefix:@"INSERT"] && [sql containsString:tableName]) {
+                    ++insertCount;
+                }
+            }
+        }];
+        while (![self.database isMigrated]) {
+            TestCaseAssertTrue([self.database stepMigration]);
+        }
+        [self.database traceSQL:nil];
+
+        // Each row is written once by a single insert, without being updated for compression later.
+        TestCaseAssertEqual(updateCount, 0);
+        TestCaseAssertEqual(insertCount, self.originObjects.count);
+
+        WCTValue* uncompressedTextCount = [self.database getValueFromStatement:WCDB::StatementSelect().select(WCDB::Column::all().count()).from(self.tableName).where(WCDB::Column("WCDB_CT_text").isNull())];
+        TestCaseAssertTrue(uncompressedTextCount != nil && uncompressedTextCount.numberValue.intValue == 0);
+        if (self.compressTwoColumn) {
+            WCTValue* uncompressedBlobCount = [self.database getValueFromStatement:WCDB::StatementSelect().select(WCDB::Column::all().count()).from(self.tableName).where(WCDB::Column("WCDB_CT_blob").isNull())];
+            TestCaseAssertTrue(uncompressedBlobCount != nil && uncompressedBlobCount.numberValue.intValue == 0);
+        }
+
+        NSArray* objects = [self.table getObjects];
+        NSArray* originObjects = [self.uncompressTable getObjects];
+        TestCaseAssertTrue([originObjects isEqualTo:objects]);
+    }];
+}
+
+- (void)test_migrated_rows_are_not_compressed_when_compressing_new_data_is_disabled
+{
+    self.compressionStatus = CompressionStatus_uncompressed;
+    self.migrationStatus = MigrationStatus_unmigrated;
+    [self.database disableCompresssNewData:YES];
+    [self doTestCompress:^{
+        while (![self.database isMigrated]) {
+            TestCaseAssertTrue([self.database stepMigration]);
+        }
+
+        WCTValue* uncompressedTextCount = [self.database getValueFromStatement:WCDB::StatementSelect().select(WCDB::Column::all().count()).from(self.tableName).where(WCDB::Column("WCDB_CT_text").isNull())];
+        TestCaseAssertTrue(uncompressedTextCount.numberValue.intValue == self.originObjects.count);
+
+        NSArray* objects = [self.table getObjects];
+        NSArray* originObjects = [self.uncompressTable getObjects];
+        TestCaseAssertTrue([originObjects isEqualTo:objects]);
+    }];
+    [self.database disableCompresssNewData:NO];
+}
+
 @end
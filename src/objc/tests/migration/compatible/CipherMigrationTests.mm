@@ -46,7 +46,8 @@
 - (void)test_cipher
 {
     NSObject<MigrationTestObject>* expectedObject = self.filterObjects.lastObject;
-    NSString* sql = [NSString stringWithFormat:@"SELECT identifier, content FROM temp.wcdb_union_testTable WHERE identifier == %d ORDER BY rowid ASC", expectedObject.identifier];
+    // The lookup of primary key is routed to the target table first.
+    NSString* sql = [NSString stringWithFormat:@"SELECT identifier, content FROM (SELECT rowid AS rowid, identifier, content FROM main.testTable WHERE identifier == %d UNION ALL SELECT rowid AS rowid, identifier, content FROM %@%@ WHERE identifier == %d LIMIT 1) AS wcdb_union_testTable WHERE identifier == %d ORDER BY rowid ASC", expectedObject.identifier, self.schemaName, self.sourceTableName, expectedObject.identifier, expectedObject.identifier];
 
     [self doTestObjects:@[ expectedObject ]
                  andSQL:sql
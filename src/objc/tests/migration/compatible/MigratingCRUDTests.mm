@@ -128,6 +128,40 @@
     }];
 }
 
+- (void)test_insert_with_cached_rowid
+{
+    TestCaseLog(@"Start test insert with cached rowid");
+
+    [self doTestMigrationWithSourceClassFilter:nil
+    targetClassFIlter:^BOOL(Class<MigrationTestObject> cls) {
+        return ![cls isAutoIncrement];
+    }
+    andOperation:^{
+        NSObject<MigrationTestObject>* firstObject = [Random.shared migrationObjectWithClass:self.targetClass
+                                                                               andIdentifier:self.objects.lastObject.identifier + 1];
+        TestCaseAssertTrue([self.table insertObject:firstObject]);
+
+        NSObject<MigrationTestObject>* secondObject = [Random.shared migrationObjectWithClass:self.targetClass
+                                                                                andIdentifier:self.objects.lastObject.identifier + 2];
+        NSMutableArray<NSObject<MigrationTestObject>*>* expectedObjects = [NSMutableArray arrayWithArray:self.filterObjects];
+        [expectedObjects addObject:firstObject];
+        [expectedObjects addObject:secondObject];
+
+        // The max rowid is cached by the first insertion.
+        NSArray<NSString*>* sqls = @[ @"BEGIN IMMEDIATE",
+                                      [NSString stringWithFormat:@"INSERT INTO %@%@(identifier, content) VALUES(?1, ?2)", self.schemaName, self.sourceTableName],
+                                      [NSString stringWithFormat:@"DELETE FROM %@%@ WHERE rowid == ?1", self.schemaName, self.sourceTableName],
+                                      @"INSERT INTO main.testTable(identifier, content, rowid) VALUES(?1, ?2, ?3)",
+                                      @"COMMIT" ];
+
+        [self doTestObjects:expectedObjects
+                    andSQLs:sqls
+          afterModification:^BOOL {
+              return [self.table insertObject:secondObject];
+          }];
+    }];
+}
+
 - (void)test_insert_autoIncrement
 {
     TestCaseLog(@"Start test insert autoincrement");
@@ -336,7 +370,17 @@
     TestCaseLog(@"Start test select");
     [self doTestMigration:^{
         NSObject<MigrationTestObject>* expectedObject = self.filterObjects.lastObject;
-        NSString* sql = [NSString stringWithFormat:@"SELECT identifier, content FROM temp.wcdb_union_testTable WHERE identifier == %d ORDER BY rowid ASC", expectedObject.identifier];
+        NSString* sql = nil;
+        if ([self.targetClass hasIntegerPrimaryKey]) {
+            // The lookup of primary key is routed to the target table first.
+            NSString* sourceCondition = [NSString stringWithFormat:@"identifier == %d", expectedObject.identifier];
+            if (self.needFilter) {
+                sourceCondition = [NSString stringWithFormat:@"(%@) AND (classification == 1)", sourceCondition];
+            }
+            sql = [NSString stringWithFormat:@"SELECT identifier, content FROM (SELECT rowid AS rowid, identifier, content FROM main.testTable WHERE identifier == %d UNION ALL SELECT rowid AS rowid, identifier, content FROM %@%@ WHERE %@ LIMIT 1) AS wcdb_union_testTable WHERE identifier == %d ORDER BY rowid ASC", expectedObject.identifier, self.schemaName, self.sourceTableName, sourceCondition, expectedObject.identifier];
+        } else {
+            sql = [NSString stringWithFormat:@"SELECT identifier, content FROM temp.wcdb_union_testTable WHERE identifier == %d ORDER BY rowid ASC", expectedObject.identifier];
+        }
 
         [self doTestObjects:@[ expectedObject ]
                      andSQL:sql
@@ -354,6 +398,38 @@
     }];
 }
 
+- (void)test_select_with_bind_parameters
+{
+    TestCaseLog(@"Start test select with bind parameters");
+    [self doTestMigration:^{
+        NSObject<MigrationTestObject>* expectedObject = self.filterObjects.lastObject;
+        WCDB::StatementSelect statement = WCDB::StatementSelect()
+                                          .select({ [self.targetClass identifier], [self.targetClass content] })
+                                          .from(self.tableName)
+                                          .where([self.targetClass identifier] == WCDB::BindParameter() && [self.targetClass content] == WCDB::BindParameter());
+        WCTHandle* handle = [self.database getHandle];
+        TestCaseAssertTrue([handle prepare:statement]);
+
+        [handle bindInteger:expectedObject.identifier toIndex:1];
+        [handle bindString:expectedObject.content toIndex:2];
+        TestCaseAssertTrue([handle step]);
+        TestCaseAssertFalse([handle done]);
+        TestCaseAssertEqual([handle extractIntegerAtIndex:0], expectedObject.identifier);
+        TestCaseAssertStringEqual([handle extractStringAtIndex:1], expectedObject.content);
+        TestCaseAssertTrue([handle step]);
+        TestCaseAssertTrue([handle done]);
+
+        [handle reset];
+        [handle bindInteger:expectedObject.identifier toIndex:1];
+        [handle bindString:[expectedObject.content stringByAppendingString:@"_mismatched"] toIndex:2];
+        TestCaseAssertTrue([handle step]);
+        TestCaseAssertTrue([handle done]);
+
+        [handle finalizeStatement];
+        [handle invalidate];
+    }];
+}
+
 - (void)test_drop_table
 {
     TestCaseLog(@"Start test drop table");
@@ -0,0 +1,144 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "CRUDTestCase.h"
+#import "Random+TestCaseObject.h"
+#import "Random.h"
+#import "TestCase.h"
+#if TEST_WCDB_OBJC
+#import <WCDBOBjc/WCTDatabase+Test.h>
+#elif TEST_WCDB_CPP
+#import <WCDBCpp/WCTDatabase+Test.h>
+#else
+#import <WCDB/WCTDatabase+Test.h>
+#endif
+
+@interface IncrementalBackupTests : CRUDTestCase
+
+@property (nonatomic, retain) NSMutableArray<WCTError*>* mismatches;
+
+@end
+
+@implementation IncrementalBackupTests
+
+- (void)setUp
+{
+    [super setUp];
+    [WCTDatabase setABTestConfigWithName:@"clicfg_wcdb_incremental_backup" andValue:@"1"];
+    [self.database enableAutoCheckpoint:NO];
+    TestCaseAssertTrue([self createTable]);
+    NSArray* objects = [Random.shared testCaseObjectsWithCount:1000 startingFromIdentifier:1];
+    TestCaseAssertTrue([self.table insertObjects:objects]);
+    TestCaseAssertTrue([self.database truncateCheckpoint]);
+
+    // The hashes of the checkpointed pages are recorded into incremental material since then.
+    [self.database enableAutoBackup:YES];
+    TestCaseAssertTrue([self.database backup]);
+    TestCaseAssertTrue([self.fileManager fileExistsAtPath:self.database.incrementalMaterialPath]);
+
+    self.mismatches = [NSMutableArray array];
+    NSString* path = self.path;
+    NSMutableArray<WCTError*>* mismatches = self.mismatches;
+    [WCTDatabase globalTraceError:^(WCTError* error) {
+        if ([error.message hasPrefix:@"Mismatched hash"]
+            && [error.path isEqualToString:path]) {
+            @synchronized(mismatches) {
+                [mismatches addObject:error];
+            }
+        }
+    }];
+}
+
+- (void)tearDown
+{
+    [WCTDatabase globalTraceError:nil];
+    [self.database enableAutoBackup:NO];
+    [WCTDatabase setABTestConfigWithName:@"clicfg_wcdb_incremental_backup" andValue:@"0"];
+    [super tearDown];
+}
+
+- (int)pageNumberOfWalFrame:(int)frame
+{
+    NSFileHandle* fileHandle = [NSFileHandle fileHandleForReadingAtPath:self.database.walPath];
+    [fileHandle seekToFileOffset:self.database.walHeaderSize + (frame - 1) * self.database.walFrameSize];
+    NSData* data = [fileHandle readDataOfLength:4];
+    [fileHandle closeFile];
+    const unsigned char* bytes = (const unsigned char*) data.bytes;
+    return (bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+}
+
+// Only the leaf containing the row is modified.
+- (int)updateLeafAndCheckpoint
+{
+    TestCaseAssertTrue([self.table updateProperty:TestCaseObject.content toValue:@"a" where:TestCaseObject.identifier == 1]);
+    auto numberOfFrames = [self.database getNumberOfWalFrames];
+    TestCaseAssertTrue(numberOfFrames.succeed() && numberOfFrames.value() == 1);
+    int pageno = [self pageNumberOfWalFrame:1];
+    TestCaseAssertTrue(pageno > 2);
+    TestCaseAssertTrue([self.database truncateCheckpoint]);
+    usleep(10000);
+    return pageno;
+}
+
+- (void)doTestRetrieve
+{
+    NSArray* objects = [self.table getObjects];
+    TestCaseAssertEqual(objects.count, 1000);
+    TestCaseAssertEqual([self.database retrieve:nil], 1.0);
+    TestCaseAssertEqual(self.mismatches.count, 0);
+    NSArray* retrieved = [self.table getObjects];
+    TestCaseAssertTrue([retrieved isEqualToArray:objects]);
+}
+
+- (void)test_adopted_hashes_match_full_crawl
+{
+    [self updateLeafAndCheckpoint];
+    TestCaseAssertTrue([self.database backup]);
+
+    // Every leaf is verified by the hash in the material during retrieving, as it does with a full crawl.
+    [self doTestRetrieve];
+}
+
+- (void)test_reject_stale_hashes
+{
+    int pageno = [self updateLeafAndCheckpoint];
+
+    // The leaf is modified after its hash is recorded by checkpoint.
+    NSFileHandle* fileHandle = [NSFileHandle fileHandleForUpdatingAtPath:self.path];
+    unsigned long long offset = (unsigned long long) pageno * self.database.pageSize - 1;
+    [fileHandle seekToFileOffset:offset];
+    NSData* data = [fileHandle readDataOfLength:1];
+    unsigned char byte = ((const unsigned char*) data.bytes)[0] == 'b' ? 'c' : 'b';
+    [fileHandle seekToFileOffset:offset];
+    [fileHandle writeData:[NSData dataWithBytes:&byte length:1]];
+    [fileHandle closeFile];
+    [self.database close];
+
+    TestCaseAssertTrue([self.database backup]);
+
+    // The stale hash is not adopted, so that the modified leaf is retrieved.
+    [self doTestRetrieve];
+}
+
+@end
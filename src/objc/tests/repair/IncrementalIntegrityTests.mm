@@ -0,0 +1,190 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "CRUDTestCase.h"
+#import "Random+TestCaseObject.h"
+#import "Random.h"
+#import "TestCase.h"
+#if TEST_WCDB_OBJC
+#import <WCDBOBjc/WCTDatabase+Test.h>
+#elif TEST_WCDB_CPP
+#import <WCDBCpp/WCTDatabase+Test.h>
+#else
+#import <WCDB/WCTDatabase+Test.h>
+#endif
+
+@interface IncrementalIntegrityTests : CRUDTestCase
+
+@property (nonatomic, retain) NSMutableArray<WCTError*>* checks;
+
+@end
+
+@implementation IncrementalIntegrityTests
+
+- (void)setUp
+{
+    [super setUp];
+    [self.database enableAutoCheckpoint:NO];
+    TestCaseAssertTrue([self createTable]);
+    NSArray* objects = [Random.shared testCaseObjectsWithCount:1000 startingFromIdentifier:1];
+    TestCaseAssertTrue([self.table insertObjects:objects]);
+
+    // Full check is run for the first time since the database has never been fully checked.
+    [self.database enableIncrementalIntegrityCheck:YES fullCheckInterval:24 * 3600];
+    TestCaseAssertTrue([self.database truncateCheckpoint]);
+
+    self.checks = [NSMutableArray array];
+    NSString* path = self.path;
+    NSMutableArray<WCTError*>* checks = self.checks;
+    [WCTDatabase globalTraceError:^(WCTError* error) {
+        if (error.level == WCTErrorLevelNotice
+            && [error.message isEqualToString:@"Integrity check finished."]
+            && [error.path isEqualToString:path]) {
+            @synchronized(checks) {
+                [checks addObject:error];
+            }
+        }
+    }];
+    [self.database checkIntegrityIncrementally];
+    TestCaseAssertEqual(self.checks.count, 1);
+    TestCaseAssertStringEqual(self.checks.lastObject.userInfo[@"Mode"], @"Full");
+    TestCaseAssertFalse([self.database isAlreadyCorrupted]);
+    TestCaseAssertTrue([self.fileManager fileExistsAtPath:self.database.integrityRecordPath]);
+}
+
+- (void)tearDown
+{
+    [self.database enableIncrementalIntegrityCheck:NO fullCheckInterval:0];
+    [super tearDown];
+}
+
+- (int)pageNumberOfWalFrame:(int)frame
+{
+    NSFileHandle* fileHandle = [NSFileHandle fileHandleForReadingAtPath:self.database.walPath];
+    [fileHandle seekToFileOffset:self.database.walHeaderSize + (frame - 1) * self.database.walFrameSize];
+    NSData* data = [fileHandle readDataOfLength:4];
+    [fileHandle closeFile];
+    const unsigned char* bytes = (const unsigned char*) data.bytes;
+    return (bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+}
+
+// The first cell pointer of a b-tree page is pointed out of the page.
+- (NSData*)corruptCellPointerOfPage:(NSData*)page
+{
+    NSMutableData* corrupted = [page mutableCopy];
+    const unsigned char invalidCellPointer[2] = { 0xFF, 0xFF };
+    [corrupted replaceBytesInRange:NSMakeRange(8, 2) withBytes:invalidCellPointer];
+    return corrupted;
+}
+
+- (void)writeLastFullCheckTime:(uint64_t)time
+{
+    unsigned char bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = (unsigned char) (time >> (56 - 8 * i));
+    }
+    TestCaseAssertTrue([[NSData dataWithBytes:bytes length:sizeof(bytes)] writeToFile:self.database.integrityRecordPath atomically:YES]);
+}
+
+- (void)test_persist_last_full_check
+{
+    // The time of last full check is read from the record rather than the memory, so it's kept across launches.
+    [self writeLastFullCheckTime:(uint64_t) [NSDate date].timeIntervalSince1970 - 3600];
+    [self.database checkIntegrityIncrementally];
+    TestCaseAssertEqual(self.checks.count, 1);
+
+    [self writeLastFullCheckTime:(uint64_t) [NSDate date].timeIntervalSince1970 - 2 * 24 * 3600];
+    [self.database checkIntegrityIncrementally];
+    TestCaseAssertEqual(self.checks.count, 2);
+    TestCaseAssertStringEqual(self.checks.lastObject.userInfo[@"Mode"], @"Full");
+
+    // The record is updated by the full check.
+    [self.database checkIntegrityIncrementally];
+    TestCaseAssertEqual(self.checks.count, 2);
+}
+
+- (void)test_full_check_if_never_checked
+{
+    TestCaseAssertTrue([self.fileManager removeItemAtPath:self.database.integrityRecordPath error:nil]);
+    [self.database checkIntegrityIncrementally];
+    TestCaseAssertEqual(self.checks.count, 2);
+    TestCaseAssertStringEqual(self.checks.lastObject.userInfo[@"Mode"], @"Full");
+    TestCaseAssertTrue([self.fileManager fileExistsAtPath:self.database.integrityRecordPath]);
+}
+
+- (void)test_skip_unchanged_pages
+{
+    // Nothing is checked since nothing is modified.
+    [self.database checkIntegrityIncrementally];
+    TestCaseAssertEqual(self.checks.count, 1);
+
+    TestCaseAssertTrue([self.table updateProperty:TestCaseObject.content toValue:@"a" where:TestCaseObject.identifier == 1]);
+    TestCaseAssertTrue([self.database truncateCheckpoint]);
+
+    // The last page is not modified by the update above, so that its corruption is not found by incremental check.
+    auto numberOfPages = [self.database getNumberOfPages];
+    TestCaseAssertTrue(numberOfPages.succeed() && numberOfPages.value() > 2);
+    [self.database corruptPage:(int) numberOfPages.value()
+                      withData:^NSData*(int size) {
+                          NSFileHandle* fileHandle = [NSFileHandle fileHandleForReadingAtPath:self.path];
+                          [fileHandle seekToFileOffset:(numberOfPages.value() - 1) * size];
+                          NSData* page = [fileHandle readDataOfLength:size];
+                          [fileHandle closeFile];
+                          return [self corruptCellPointerOfPage:page];
+                      }];
+
+    [self.database checkIntegrityIncrementally];
+    TestCaseAssertEqual(self.checks.count, 2);
+    TestCaseAssertStringEqual(self.checks.lastObject.userInfo[@"Mode"], @"Incremental");
+    NSInteger pageCount = ((NSNumber*) self.checks.lastObject.userInfo[@"PageCount"]).integerValue;
+    TestCaseAssertTrue(pageCount > 0 && pageCount < numberOfPages.value());
+    TestCaseAssertFalse([self.database isAlreadyCorrupted]);
+}
+
+- (void)test_detect_modified_page
+{
+    TestCaseAssertTrue([self.table updateProperty:TestCaseObject.content toValue:@"a" where:TestCaseObject.identifier == 1000]);
+    auto numberOfFrames = [self.database getNumberOfWalFrames];
+    TestCaseAssertTrue(numberOfFrames.succeed() && numberOfFrames.value() > 0);
+    int frame = (int) numberOfFrames.value();
+    TestCaseAssertTrue([self pageNumberOfWalFrame:frame] > 1);
+
+    // The corrupted page is written back by checkpoint, as if it's corrupted by SQLite.
+    NSFileHandle* fileHandle = [NSFileHandle fileHandleForUpdatingAtPath:self.database.walPath];
+    unsigned long long offset = self.database.walHeaderSize + (frame - 1) * self.database.walFrameSize + self.database.walFrameHeaderSize;
+    [fileHandle seekToFileOffset:offset];
+    NSData* page = [fileHandle readDataOfLength:self.database.pageSize];
+    [fileHandle seekToFileOffset:offset];
+    [fileHandle writeData:[self corruptCellPointerOfPage:page]];
+    [fileHandle closeFile];
+    TestCaseAssertTrue([self.database truncateCheckpoint]);
+
+    // The suspected corruption is confirmed by a full check.
+    [self.database checkIntegrityIncrementally];
+    TestCaseAssertEqual(self.checks.count, 2);
+    TestCaseAssertStringEqual(self.checks.lastObject.userInfo[@"Mode"], @"Full");
+    TestCaseAssertTrue([self.database isAlreadyCorrupted]);
+}
+
+@end
@@ -0,0 +1,119 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "CRUDTestCase.h"
+#import "CoreConst.h"
+#import "Random+TestCaseObject.h"
+#import "Random.h"
+#import "TestCaseAssertion.h"
+#if TEST_WCDB_OBJC
+#import <WCDBOBjc/WCTDatabase+Test.h>
+#elif TEST_WCDB_CPP
+#import <WCDBCpp/WCTDatabase+Test.h>
+#else
+#import <WCDB/WCTDatabase+Test.h>
+#endif
+
+@interface RepairPageCacheTests : CRUDTestCase
+
+@end
+
+@implementation RepairPageCacheTests
+
+- (void)setUp
+{
+    [super setUp];
+    // Only the pages of encrypted databases are shared.
+    [self.database setCipherKey:[Random.shared data]];
+    [self.database enableAutoCheckpoint:NO];
+    TestCaseAssertTrue([self createTable]);
+    NSArray* objects = [Random.shared testCaseObjectsWithCount:1000 startingFromIdentifier:1];
+    TestCaseAssertTrue([self.table insertObjects:objects]);
+    TestCaseAssertTrue([self.database truncateCheckpoint]);
+}
+
+- (void)tearDown
+{
+    [WCTDatabase setSharedRepairPageCacheSize:WCDB::RepairSharedPageCacheSize];
+    [super tearDown];
+}
+
+- (void)test_hit
+{
+    TestCaseAssertTrue([self.database backup]);
+    TestCaseAssertTrue([WCTDatabase numberOfPagesInSharedRepairPageCache] > 0);
+    uint64_t hits = [WCTDatabase numberOfHitsInSharedRepairPageCache];
+
+    // Pages decrypted by the last backup are reused.
+    TestCaseAssertTrue([self.database backup]);
+    TestCaseAssertTrue([WCTDatabase numberOfHitsInSharedRepairPageCache] > hits);
+}
+
+- (void)test_eviction
+{
+    TestCaseAssertTrue([self.database backup]);
+    NSUInteger numberOfPages = [WCTDatabase numberOfPagesInSharedRepairPageCache];
+    TestCaseAssertTrue(numberOfPages > 2);
+
+    // Least recently used pages are purged once the cache is shrunk.
+    [WCTDatabase setSharedRepairPageCacheSize:2 * 4096];
+    TestCaseAssertTrue([WCTDatabase numberOfPagesInSharedRepairPageCache] <= 2);
+
+    // And the cache never grows beyond its size.
+    TestCaseAssertTrue([self.database backup]);
+    TestCaseAssertTrue([WCTDatabase numberOfPagesInSharedRepairPageCache] <= 2);
+}
+
+- (void)test_invalidation
+{
+    TestCaseAssertTrue([self.database backup]);
+    TestCaseAssertTrue([WCTDatabase numberOfPagesInSharedRepairPageCache] > 0);
+
+    // Checkpoint expires all the cached pages of the database file, even if nothing is written back.
+    TestCaseAssertTrue([self.database truncateCheckpoint]);
+    uint64_t hits = [WCTDatabase numberOfHitsInSharedRepairPageCache];
+    TestCaseAssertTrue([self.database backup]);
+    TestCaseAssertEqual([WCTDatabase numberOfHitsInSharedRepairPageCache], hits);
+
+    // The pages decrypted again are cached with the new generation.
+    TestCaseAssertTrue([self.database backup]);
+    TestCaseAssertTrue([WCTDatabase numberOfHitsInSharedRepairPageCache] > hits);
+}
+
+- (void)test_forget_file
+{
+    TestCaseAssertTrue([self.database backup]);
+    TestCaseAssertTrue([WCTDatabase numberOfFilesInSharedRepairPageCache] > 0);
+
+    // The file is forgotten once its pagers are gone and its pages are all purged.
+    [WCTDatabase setSharedRepairPageCacheSize:0];
+    TestCaseAssertEqual([WCTDatabase numberOfFilesInSharedRepairPageCache], 0);
+
+    // And it's remembered again by the next backup.
+    [WCTDatabase setSharedRepairPageCacheSize:WCDB::RepairSharedPageCacheSize];
+    TestCaseAssertTrue([self.database backup]);
+    TestCaseAssertTrue([WCTDatabase numberOfFilesInSharedRepairPageCache] > 0);
+}
+
+@end
@@ -139,6 +139,26 @@
     executeTest:^{
         [self doTestInterruptVacuum];
         [self doTestObjectsExist];
+        // Resume from the checkpoint of the interrupted vacuum.
+        [self doTestVacuum];
+        [self doTestObjectsExist];
+        [self doTestFactoryNotExist];
+    }];
+}
+
+- (void)test_vacuum_parallel
+{
+    self.objectCount = 100000;
+    [self
+    executeTest:^{
+        NSString* anotherTableName = [self.tableName stringByAppendingString:@"_another"];
+        TestCaseAssertTrue([self.database createTable:anotherTableName withClass:self.testClass]);
+        WCTTable* anotherTable = [self.database getTable:anotherTableName withClass:self.testClass];
+        TestCaseAssertTrue([anotherTable insertObjects:self.objects]);
+
+        [self doTestVacuum];
+        [self doTestObjectsExist];
+        TestCaseAssertTrue([[anotherTable getObjects] isEqualToArray:self.objects]);
         [self doTestFactoryNotExist];
     }];
 }
@@ -0,0 +1,274 @@
+//
+// Created by qiuwenchen on 2026/10/19.
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import XCTest
+#if TEST_WCDB_SWIFT
+import WCDBSwift
+#else
+import WCDB
+#endif
+import WCDB_Private
+
+class HandleStatementBatchTests: DatabaseTestCase {
+
+    final class ColumnarBuffer {
+        var raw: CPPColumnarBuffer
+
+        init(columnCount: Int, rowCapacity: Int, arenaCapacity: Int) {
+            let cellCount = columnCount * rowCapacity
+            raw = CPPColumnarBuffer(columnCount: Int32(columnCount),
+                                    rowCapacity: Int32(rowCapacity),
+                                    rowCount: 0,
+                                    types: .allocate(capacity: cellCount),
+                                    integers: .allocate(capacity: cellCount),
+                                    doubles: .allocate(capacity: cellCount),
+                                    offsets: .allocate(capacity: cellCount),
+                                    lengths: .allocate(capacity: cellCount),
+                                    arena: nil,
+                                    arenaCapacity: 0,
+                                    arenaUsed: 0,
+                                    arenaRequired: 0,
+                                    hasPendingRow: false,
+                                    done: false)
+            resizeArena(arenaCapacity)
+        }
+
+        deinit {
+            raw.types.deallocate()
+            raw.integers.deallocate()
+            raw.doubles.deallocate()
+            raw.offsets.deallocate()
+            raw.lengths.deallocate()
+            raw.arena?.deallocate()
+        }
+
+        func resizeArena(_ capacity: Int) {
+            raw.arena?.deallocate()
+            raw.arena = capacity > 0 ? .allocate(capacity: capacity) : nil
+            raw.arenaCapacity = UInt64(capacity)
+        }
+
+        func cell(row: Int, column: Int) -> Int {
+            return column * Int(raw.rowCapacity) + row
+        }
+
+        func type(row: Int, column: Int) -> WCDBColumnValueType {
+            return raw.types[cell(row: row, column: column)]
+        }
+
+        func integer(row: Int, column: Int) -> Int64 {
+            return raw.integers[cell(row: row, column: column)]
+        }
+
+        func double(row: Int, column: Int) -> Double {
+            return raw.doubles[cell(row: row, column: column)]
+        }
+
+        func data(row: Int, column: Int) -> Data {
+            let index = cell(row: row, column: column)
+            guard let arena = raw.arena, raw.lengths[index] > 0 else {
+                return Data()
+            }
+            return Data(bytes: arena + Int(raw.offsets[index]), count: Int(raw.lengths[index]))
+        }
+
+        func text(row: Int, column: Int) -> String {
+            return String(data: data(row: row, column: column), encoding: .utf8)!
+        }
+
+        func setInteger(_ value: Int64, row: Int, column: Int) {
+            let index = cell(row: row, column: column)
+            raw.types[index] = WCDBColumnValueTypeInterger
+            raw.integers[index] = value
+        }
+
+        func setText(_ value: String, row: Int, column: Int) {
+            let index = cell(row: row, column: column)
+            let bytes = Array(value.utf8)
+            XCTAssertLessThanOrEqual(raw.arenaUsed + UInt64(bytes.count), raw.arenaCapacity)
+            raw.types[index] = WCDBColumnValueTypeString
+            raw.offsets[index] = raw.arenaUsed
+            raw.lengths[index] = UInt64(bytes.count)
+            for (offset, byte) in bytes.enumerated() {
+                raw.arena![Int(raw.arenaUsed) + offset] = byte
+            }
+            raw.arenaUsed += UInt64(bytes.count)
+        }
+    }
+
+    var cppDatabase: CPPDatabase!
+    var cppHandle: CPPHandle!
+    var cppStatement: CPPHandleStatement {
+        return WCDBHandleGetMainStatement(cppHandle)
+    }
+
+    override func setUp() {
+        super.setUp()
+        cppDatabase = WCDBCoreCreateDatabase(self.recommendedPath.path)
+        cppHandle = WCDBDatabaseGetHandle(cppDatabase, true)
+        XCTAssertTrue(WCDBHandleCheckValid(cppHandle))
+        XCTAssertTrue(WCDBHandleExecuteSQL(cppHandle, "CREATE TABLE source(id INTEGER PRIMARY KEY, content TEXT)"))
+        XCTAssertTrue(WCDBHandleExecuteSQL(cppHandle, "CREATE TABLE destination(id INTEGER PRIMARY KEY, content TEXT)"))
+        // Each content is 10 bytes.
+        for id in 1...5 {
+            XCTAssertTrue(WCDBHandleExecuteSQL(cppHandle, "INSERT INTO source VALUES(\(id), 'content-0\(id)')"))
+        }
+    }
+
+    override func tearDown() {
+        WCDBHandleStatementFinalize(cppStatement)
+        WCDBReleaseCPPObject(cppHandle.innerValue!)
+        WCDBReleaseCPPObject(cppDatabase.innerValue!)
+        cppHandle = nil
+        cppDatabase = nil
+        database.close()
+        super.tearDown()
+    }
+
+    func prepareSelect() {
+        XCTAssertTrue(WCDBHandleStatementPrepareSQL(cppStatement, "SELECT id, content FROM source ORDER BY id"))
+    }
+
+    func checkRow(_ buffer: ColumnarBuffer, row: Int, id: Int64) {
+        XCTAssertEqual(buffer.type(row: row, column: 0), WCDBColumnValueTypeInterger)
+        XCTAssertEqual(buffer.integer(row: row, column: 0), id)
+        XCTAssertEqual(buffer.type(row: row, column: 1), WCDBColumnValueTypeString)
+        XCTAssertEqual(buffer.text(row: row, column: 1), "content-0\(id)")
+    }
+
+    func testPartialBatch() {
+        let buffer = ColumnarBuffer(columnCount: 2, rowCapacity: 4, arenaCapacity: 1024)
+        prepareSelect()
+
+        XCTAssertTrue(WCDBHandleStatementStepBatch(cppStatement, &buffer.raw))
+        XCTAssertEqual(buffer.raw.rowCount, 4)
+        XCTAssertFalse(buffer.raw.done)
+        XCTAssertFalse(buffer.raw.hasPendingRow)
+        XCTAssertEqual(buffer.raw.arenaUsed, 40)
+        for row in 0..<4 {
+            checkRow(buffer, row: row, id: Int64(row + 1))
+        }
+
+        // The last batch is partial.
+        XCTAssertTrue(WCDBHandleStatementStepBatch(cppStatement, &buffer.raw))
+        XCTAssertEqual(buffer.raw.rowCount, 1)
+        XCTAssertTrue(buffer.raw.done)
+        checkRow(buffer, row: 0, id: 5)
+
+        XCTAssertTrue(WCDBHandleStatementStepBatch(cppStatement, &buffer.raw))
+        XCTAssertEqual(buffer.raw.rowCount, 0)
+        XCTAssertTrue(buffer.raw.done)
+    }
+
+    func testArenaSizing() {
+        // The arena holds two and a half contents.
+        let buffer = ColumnarBuffer(columnCount: 2, rowCapacity: 4, arenaCapacity: 25)
+        prepareSelect()
+
+        XCTAssertTrue(WCDBHandleStatementStepBatch(cppStatement, &buffer.raw))
+        XCTAssertEqual(buffer.raw.rowCount, 2)
+        XCTAssertEqual(buffer.raw.arenaUsed, 20)
+        XCTAssertEqual(buffer.raw.arenaRequired, 10)
+        XCTAssertTrue(buffer.raw.hasPendingRow)
+        XCTAssertFalse(buffer.raw.done)
+        checkRow(buffer, row: 0, id: 1)
+        checkRow(buffer, row: 1, id: 2)
+    }
+
+    func testPendingRowCarryOver() {
+        // No row fits into the arena.
+        let buffer = ColumnarBuffer(columnCount: 2, rowCapacity: 4, arenaCapacity: 5)
+        prepareSelect()
+
+        XCTAssertTrue(WCDBHandleStatementStepBatch(cppStatement, &buffer.raw))
+        XCTAssertEqual(buffer.raw.rowCount, 0)
+        XCTAssertTrue(buffer.raw.hasPendingRow)
+        XCTAssertEqual(buffer.raw.arenaRequired, 10)
+
+        // The pending row is fetched first after growing the arena, without being skipped or stepped twice.
+        buffer.resizeArena(Int(buffer.raw.arenaRequired) * 3)
+        XCTAssertTrue(WCDBHandleStatementStepBatch(cppStatement, &buffer.raw))
+        XCTAssertEqual(buffer.raw.rowCount, 3)
+        XCTAssertTrue(buffer.raw.hasPendingRow)
+        for row in 0..<3 {
+            checkRow(buffer, row: row, id: Int64(row + 1))
+        }
+
+        XCTAssertTrue(WCDBHandleStatementStepBatch(cppStatement, &buffer.raw))
+        XCTAssertEqual(buffer.raw.rowCount, 2)
+        XCTAssertFalse(buffer.raw.hasPendingRow)
+        XCTAssertTrue(buffer.raw.done)
+        checkRow(buffer, row: 0, id: 4)
+        checkRow(buffer, row: 1, id: 5)
+    }
+
+    func testFetchNullAndNumbers() {
+        XCTAssertTrue(WCDBHandleExecuteSQL(cppHandle, "UPDATE source SET content = NULL WHERE id = 1"))
+        let buffer = ColumnarBuffer(columnCount: 3, rowCapacity: 1, arenaCapacity: 0)
+        XCTAssertTrue(WCDBHandleStatementPrepareSQL(cppStatement, "SELECT id, content, id * 0.5 FROM source WHERE id = 1"))
+
+        XCTAssertTrue(WCDBHandleStatementStepBatch(cppStatement, &buffer.raw))
+        XCTAssertEqual(buffer.raw.rowCount, 1)
+        XCTAssertEqual(buffer.integer(row: 0, column: 0), 1)
+        XCTAssertEqual(buffer.type(row: 0, column: 1), WCDBColumnValueTypeNull)
+        XCTAssertEqual(buffer.type(row: 0, column: 2), WCDBColumnValueTypeFloat)
+        XCTAssertEqual(buffer.double(row: 0, column: 2), 0.5)
+    }
+
+    func testBindAndStepBatch() {
+        let buffer = ColumnarBuffer(columnCount: 2, rowCapacity: 8, arenaCapacity: 1024)
+        prepareSelect()
+        XCTAssertTrue(WCDBHandleStatementStepBatch(cppStatement, &buffer.raw))
+        XCTAssertEqual(buffer.raw.rowCount, 5)
+        WCDBHandleStatementFinalize(cppStatement)
+
+        XCTAssertTrue(WCDBHandleStatementPrepareSQL(cppStatement, "INSERT INTO destination VALUES(?1, ?2)"))
+        XCTAssertEqual(WCDBHandleStatementBindAndStepBatch(cppStatement, &buffer.raw), 5)
+        WCDBHandleStatementFinalize(cppStatement)
+
+        XCTAssertTrue(WCDBHandleStatementPrepareSQL(cppStatement, "SELECT count(*) FROM source JOIN destination USING(id) WHERE source.content == destination.content"))
+        XCTAssertTrue(WCDBHandleStatementStep(cppStatement))
+        XCTAssertEqual(WCDBHandleStatementGetInteger(cppStatement, 0), 5)
+    }
+
+    func testBindAndStepPartialBatch() {
+        let buffer = ColumnarBuffer(columnCount: 2, rowCapacity: 3, arenaCapacity: 1024)
+        buffer.setInteger(6, row: 0, column: 0)
+        buffer.setText("content-06", row: 0, column: 1)
+        // Conflicts with an existing row.
+        buffer.setInteger(1, row: 1, column: 0)
+        buffer.setText("content-01", row: 1, column: 1)
+        buffer.setInteger(7, row: 2, column: 0)
+        buffer.setText("content-07", row: 2, column: 1)
+        buffer.raw.rowCount = 3
+
+        XCTAssertTrue(WCDBHandleStatementPrepareSQL(cppStatement, "INSERT INTO source VALUES(?1, ?2)"))
+        XCTAssertEqual(WCDBHandleStatementBindAndStepBatch(cppStatement, &buffer.raw), 1)
+        WCDBHandleStatementFinalize(cppStatement)
+
+        XCTAssertTrue(WCDBHandleStatementPrepareSQL(cppStatement, "SELECT max(id) FROM source"))
+        XCTAssertTrue(WCDBHandleStatementStep(cppStatement))
+        XCTAssertEqual(WCDBHandleStatementGetInteger(cppStatement, 0), 6)
+    }
+}